@@ -0,0 +1,54 @@
+// Microbenchmark de lighting_calculate_distance_attenuation_fast
+// Usage: bench_attenuation [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Distances au carré réparties entre 0 et 1.2 fois le rayon au carré, pour
+//   couvrir aussi les points hors de portée.
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_kernel.h"
+
+#define BENCH_ATTENUATION_SAMPLES (1 << 18)
+
+typedef struct {
+    float* distance_squared;
+    float* radius_squared;
+} AttenuationBench;
+
+static long bench_attenuation_pass(void* context) {
+    AttenuationBench* bench = (AttenuationBench*)context;
+    float sum = 0.0f;
+    for (int i = 0; i < BENCH_ATTENUATION_SAMPLES; i++) {
+        sum += lighting_calculate_distance_attenuation_fast(bench->distance_squared[i], bench->radius_squared[i]);
+    }
+    bench_sink += (Uint32)sum;
+    return BENCH_ATTENUATION_SAMPLES;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "attenuation", argc, argv);
+
+    static AttenuationBench bench;
+    bench.distance_squared = malloc(sizeof(float) * BENCH_ATTENUATION_SAMPLES);
+    bench.radius_squared = malloc(sizeof(float) * BENCH_ATTENUATION_SAMPLES);
+    if (!bench.distance_squared || !bench.radius_squared) {
+        printf("Erreur allocation des échantillons\n");
+        return 2;
+    }
+
+    Uint32 seed = 0xCC9E2D51;
+    for (int i = 0; i < BENCH_ATTENUATION_SAMPLES; i++) {
+        float radius = 3.0f + (bench_random(&seed) % 500) / 100.0f;
+        bench.radius_squared[i] = radius * radius;
+        bench.distance_squared[i] = bench.radius_squared[i] * 1.2f * (bench_random(&seed) % 10000) / 10000.0f;
+    }
+
+    int status = bench_run(&options, bench_attenuation_pass, &bench);
+
+    free(bench.distance_squared);
+    free(bench.radius_squared);
+    return status;
+}
@@ -0,0 +1,61 @@
+// Microbenchmark du lancer de rayons (DDA) sur des maps synthétiques
+// Usage: bench_dda [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Lance une colonne de rayons complète depuis plusieurs poses, sur une map
+//   dense (64x64, 30% de murs) puis une map ouverte (256x256, 3%: rayons longs).
+//   Toute la ligne de colonnes est lancée d'un coup, par paquets des noyaux en
+//   service comme au rendu (--kernel pour comparer les variantes).
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+#include "bench_kernel.h"
+#include "../src/raycaster.h"
+
+#define BENCH_DDA_WIDTH 800
+#define BENCH_DDA_POSES 32
+
+typedef struct {
+    Map maps[2];
+    Player poses[2][BENCH_DDA_POSES];
+    RayHit hits[BENCH_DDA_WIDTH];
+} DdaBench;
+
+static long bench_dda_pass(void* context) {
+    DdaBench* bench = (DdaBench*)context;
+    Uint32 sum = 0;
+    long rays = 0;
+    for (int m = 0; m < 2; m++) {
+        for (int p = 0; p < BENCH_DDA_POSES; p++) {
+            raycaster_cast_columns(&bench->poses[m][p], &bench->maps[m], 0, BENCH_DDA_WIDTH, BENCH_DDA_WIDTH,
+                                   0.0f, bench->hits);
+            for (int i = 0; i < BENCH_DDA_WIDTH; i++) {
+                sum += (Uint32)(bench->hits[i].map_x + bench->hits[i].map_y * 31 + bench->hits[i].side);
+            }
+            rays += BENCH_DDA_WIDTH;
+        }
+    }
+    bench_sink += sum;
+    return rays;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "dda", argc, argv);
+
+    static DdaBench bench;
+    if (!bench_scene_map(&bench.maps[0], 64, 30, 8) || !bench_scene_map(&bench.maps[1], 256, 3, 8)) {
+        return 2;
+    }
+    for (int m = 0; m < 2; m++) {
+        for (int p = 0; p < BENCH_DDA_POSES; p++) {
+            bench_scene_pose(&bench.poses[m][p], &bench.maps[m], p);
+        }
+    }
+
+    int status = bench_run(&options, bench_dda_pass, &bench);
+
+    map_free(&bench.maps[0]);
+    map_free(&bench.maps[1]);
+    return status;
+}
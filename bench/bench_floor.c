@@ -0,0 +1,64 @@
+// Microbenchmark de l'ombrage des lignes de sol et de plafond
+// Usage: bench_floor [--unlit] [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Dessine toutes les lignes sol/plafond d'un écran 800x600 (1 pixel sur 2
+//   échantillonné, comme raycaster_render) depuis plusieurs poses.
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+#include "bench_kernel.h"
+#include "../src/raycaster.h"
+
+#define BENCH_FLOOR_WIDTH 800
+#define BENCH_FLOOR_HEIGHT 600
+#define BENCH_FLOOR_POSES 4
+#define BENCH_FLOOR_SAMPLE_STEP 2
+
+typedef struct {
+    RaycastRenderer rc;
+    Map map;
+    TextureManager tm;
+    Player poses[BENCH_FLOOR_POSES];
+} FloorBench;
+
+static long bench_floor_pass(void* context) {
+    FloorBench* bench = (FloorBench*)context;
+    for (int p = 0; p < BENCH_FLOOR_POSES; p++) {
+        for (int y = 0; y < BENCH_FLOOR_HEIGHT; y += BENCH_FLOOR_SAMPLE_STEP) {
+            raycaster_draw_floor_row(&bench->rc, &bench->poses[p], &bench->map, &bench->tm,
+                                     y, BENCH_FLOOR_SAMPLE_STEP);
+        }
+        bench_sink += bench->rc.screen_buffer[(BENCH_FLOOR_HEIGHT - 1) * BENCH_FLOOR_WIDTH];
+    }
+    return (long)BENCH_FLOOR_POSES * BENCH_FLOOR_WIDTH * BENCH_FLOOR_HEIGHT;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "floor", argc, argv);
+
+    static FloorBench bench;
+    static LightManager lights;
+    if (!bench_scene_textures(&bench.tm, 16, 64) || !bench_scene_map(&bench.map, 64, 20, 16)) {
+        return 2;
+    }
+    if (!raycaster_init(&bench.rc, NULL, BENCH_FLOOR_WIDTH, BENCH_FLOOR_HEIGHT)) {
+        return 2;
+    }
+    if (options.lit) {
+        bench_scene_lights(&lights, &bench.map, 24);
+        raycaster_set_lighting(&bench.rc, &lights);
+    }
+    for (int p = 0; p < BENCH_FLOOR_POSES; p++) {
+        bench_scene_pose(&bench.poses[p], &bench.map, p);
+    }
+
+    int status = bench_run(&options, bench_floor_pass, &bench);
+
+    raycaster_destroy(&bench.rc);
+    if (options.lit) lighting_destroy(&lights);
+    bench_scene_free_textures(&bench.tm);
+    map_free(&bench.map);
+    return status;
+}
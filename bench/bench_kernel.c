@@ -0,0 +1,275 @@
+// Outils communs aux microbenchmarks des noyaux du rendu
+#include "bench_kernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+volatile Uint32 bench_sink = 0;
+
+double bench_now_ms(void) {
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void bench_parse_options(BenchOptions* options, const char* kernel, int argc, char* argv[]) {
+    options->kernel = kernel;
+    options->warmup = BENCH_WARMUP_DEFAULT;
+    options->repeats = BENCH_REPEATS_DEFAULT;
+    options->json_path = NULL;
+    options->baseline_path = NULL;
+    options->threshold = BENCH_THRESHOLD_DEFAULT;
+    options->lit = 1;
+    options->kernel_level = KERNEL_AUTO;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options->warmup = atoi(argv[++i]);
+            if (options->warmup < 0) options->warmup = 0;
+        } else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            options->repeats = atoi(argv[++i]);
+            if (options->repeats < 1) options->repeats = 1;
+            if (options->repeats > BENCH_REPEATS_MAX) options->repeats = BENCH_REPEATS_MAX;
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options->json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            options->baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            options->threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--unlit") == 0) {
+            options->lit = 0;
+        } else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            int level = kernels_parse_level(argv[++i]);
+            if (level < 0) {
+                printf("Noyaux inconnus ignorés: %s\n", argv[i]);
+            } else {
+                options->kernel_level = level;
+            }
+        } else {
+            printf("Option inconnue ignorée: %s\n", argv[i]);
+        }
+    }
+    if (!kernels_select(options->kernel_level)) {
+        options->kernel_level = kernels->level;
+    }
+}
+
+static int bench_compare_ms(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static int bench_write_json(const BenchOptions* options, const BenchResult* result) {
+    FILE* file = fopen(options->json_path, "w");
+    if (!file) {
+        printf("Impossible d'écrire %s\n", options->json_path);
+        return 0;
+    }
+    fprintf(file, "{\n");
+    fprintf(file, "  \"kernel\": \"%s\",\n", options->kernel);
+    fprintf(file, "  \"lit\": %d,\n", options->lit);
+    fprintf(file, "  \"variant\": \"%s\",\n", kernels_level_name(options->kernel_level));
+    fprintf(file, "  \"items\": %ld,\n", result->items);
+    fprintf(file, "  \"warmup\": %d,\n", options->warmup);
+    fprintf(file, "  \"repeats\": %d,\n", options->repeats);
+    fprintf(file, "  \"min_ms\": %.6f,\n", result->min_ms);
+    fprintf(file, "  \"median_ms\": %.6f,\n", result->median_ms);
+    fprintf(file, "  \"mean_ms\": %.6f,\n", result->mean_ms);
+    fprintf(file, "  \"ns_per_item\": %.6f\n", result->ns_per_item);
+    fprintf(file, "}\n");
+    fclose(file);
+    return 1;
+}
+
+// Lit "ns_per_item" dans un JSON écrit par bench_write_json, renvoie -1 si absent
+static double bench_read_baseline(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return -1.0;
+
+    char text[2048];
+    size_t size = fread(text, 1, sizeof(text) - 1, file);
+    text[size] = '\0';
+    fclose(file);
+
+    const char* key = strstr(text, "\"ns_per_item\"");
+    if (!key) return -1.0;
+    const char* colon = strchr(key, ':');
+    if (!colon) return -1.0;
+    return strtod(colon + 1, NULL);
+}
+
+int bench_run(const BenchOptions* options, BenchPass pass, void* context) {
+    double* times = malloc(sizeof(double) * options->repeats);
+    if (!times) {
+        printf("Erreur allocation des mesures\n");
+        return 2;
+    }
+
+    // Chauffe: caches, prédicteurs de branchement et fréquence CPU stabilisés
+    BenchResult result = {0};
+    for (int i = 0; i < options->warmup; i++) {
+        result.items = pass(context);
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < options->repeats; i++) {
+        double start = bench_now_ms();
+        result.items = pass(context);
+        times[i] = bench_now_ms() - start;
+        total += times[i];
+    }
+
+    qsort(times, options->repeats, sizeof(double), bench_compare_ms);
+    result.min_ms = times[0];
+    result.median_ms = options->repeats % 2 ? times[options->repeats / 2]
+                     : 0.5 * (times[options->repeats / 2 - 1] + times[options->repeats / 2]);
+    result.mean_ms = total / options->repeats;
+    result.ns_per_item = result.items > 0 ? result.median_ms * 1e6 / result.items : 0.0;
+    free(times);
+
+    printf("%-14s%-14s %-7s %9ld éléments  min %8.3f ms  médiane %8.3f ms  moyenne %8.3f ms  %8.3f ns/élément\n",
+           options->kernel, options->lit ? "" : " sans lumière", kernels_level_name(options->kernel_level), result.items,
+           result.min_ms, result.median_ms, result.mean_ms, result.ns_per_item);
+
+    if (options->json_path && !bench_write_json(options, &result)) {
+        return 2;
+    }
+
+    if (options->baseline_path) {
+        double reference = bench_read_baseline(options->baseline_path);
+        if (reference <= 0.0) {
+            printf("Référence illisible: %s\n", options->baseline_path);
+            return 2;
+        }
+        double change = (result.ns_per_item / reference - 1.0) * 100.0;
+        if (change > options->threshold) {
+            printf("✗ RÉGRESSION %s: %.3f ns/élément contre %.3f (%+.1f%%, seuil %.1f%%)\n",
+                   options->kernel, result.ns_per_item, reference, change, options->threshold);
+            return 1;
+        }
+        printf("✓ %s: %+.1f%% par rapport à la référence (seuil %.1f%%)\n",
+               options->kernel, change, options->threshold);
+    }
+    return 0;
+}
+
+Uint32 bench_random(Uint32* state) {
+    // xorshift32: même séquence sur toutes les plateformes
+    Uint32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+int bench_scene_textures(TextureManager* tm, int count, int size) {
+    memset(tm, 0, sizeof(*tm));
+    if (count > MAX_TEXTURES) count = MAX_TEXTURES;
+
+    int shift = 0;
+    while ((1 << shift) < size) shift++;
+    size = 1 << shift;
+
+    tm->arena_capacity = 1 + (Uint32)count * size * size;
+    tm->pixels = malloc(sizeof(Uint32) * tm->arena_capacity);
+    if (!tm->pixels) {
+        printf("Erreur allocation des textures synthétiques\n");
+        return 0;
+    }
+
+    // Texture 'missing' 1x1 grise en tête d'arène, comme textures_init
+    tm->pixels[0] = 0x808080FF;
+    tm->missing.width = 1;
+    tm->missing.height = 1;
+    tm->missing.mip_count = 1;
+    tm->arena_used = 1;
+
+    Uint32 seed = 0x2545F491;
+    for (int id = 0; id < count; id++) {
+        TextureEntry* entry = &tm->entries[id];
+        entry->offset = tm->arena_used;
+        entry->width = size;
+        entry->height = size;
+        entry->width_shift = shift;
+        entry->width_mask = size - 1;
+        entry->height_mask = size - 1;
+        entry->mip_count = 1;
+        for (int i = 0; i < size * size; i++) {
+            tm->pixels[tm->arena_used + i] = bench_random(&seed) | 0xFF;
+        }
+        tm->arena_used += (Uint32)size * size;
+        tm->loaded[id] = 1;
+    }
+    tm->count = count;
+    tm->loaded_count = count;
+    return 1;
+}
+
+void bench_scene_free_textures(TextureManager* tm) {
+    free(tm->pixels);
+    tm->pixels = NULL;
+}
+
+int bench_scene_map(Map* map, int size, int wall_percent, int texture_count) {
+    if (!map_alloc(map, size, size)) return 0;
+
+    Uint32 seed = 0x9E3779B9;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            int wall = border || (int)(bench_random(&seed) % 100) < wall_percent;
+            MAP_TILE(map, LAYER_FLOOR, x, y).texture_id = (x + y) % texture_count;
+            MAP_TILE(map, LAYER_CEILING, x, y).texture_id = (x * 3 + y) % texture_count;
+            MAP_TILE(map, LAYER_WALL, x, y).type = wall ? TILE_SOLID : TILE_EMPTY;
+            MAP_TILE(map, LAYER_WALL, x, y).texture_id = (x * 7 + y * 5) % texture_count;
+        }
+    }
+    map->player_start_x = size / 2 + 0.5f;
+    map->player_start_y = size / 2 + 0.5f;
+    MAP_TILE(map, LAYER_WALL, size / 2, size / 2).type = TILE_EMPTY;
+    return 1;
+}
+
+void bench_scene_lights(LightManager* lm, Map* map, int count) {
+    lighting_init(lm);
+
+    Uint32 seed = 0x85EBCA6B;
+    for (int placed = 0, tries = 0; placed < count && tries < count * 100; tries++) {
+        int x = 1 + (int)(bench_random(&seed) % (Uint32)(map->width - 2));
+        int y = 1 + (int)(bench_random(&seed) % (Uint32)(map->height - 2));
+        if (map_is_wall(map, x, y)) continue;
+        float r = 0.4f + (bench_random(&seed) % 60) / 100.0f;
+        float g = 0.4f + (bench_random(&seed) % 60) / 100.0f;
+        float b = 0.4f + (bench_random(&seed) % 60) / 100.0f;
+        float radius = 3.0f + (bench_random(&seed) % 50) / 10.0f;
+        if (lighting_add_light(lm, x + 0.5f, y + 0.5f, r, g, b, 1.2f, radius) < 0) break;
+        placed++;
+    }
+
+    Uint8* grid = map_build_occluders(map);
+    if (grid) {
+        lighting_set_occluders(lm, grid, map->width, map->height);
+        free(grid);
+    }
+    lighting_update_cache(lm);
+}
+
+void bench_scene_pose(Player* player, Map* map, int index) {
+    // Position sur une tile vide et direction tirées de l'index
+    Uint32 seed = 0xC2B2AE35u ^ (Uint32)(index * 2654435761u);
+    if (seed == 0) seed = 1;
+    float x = map->player_start_x;
+    float y = map->player_start_y;
+    for (int tries = 0; tries < 1000; tries++) {
+        int tx = 1 + (int)(bench_random(&seed) % (Uint32)(map->width - 2));
+        int ty = 1 + (int)(bench_random(&seed) % (Uint32)(map->height - 2));
+        if (!map_is_wall(map, tx, ty)) {
+            x = tx + 0.5f;
+            y = ty + 0.5f;
+            break;
+        }
+    }
+    float angle = (bench_random(&seed) % 3600) * (float)M_PI / 1800.0f;
+    player_init(player, x, y, cosf(angle), sinf(angle));
+}
@@ -0,0 +1,67 @@
+#ifndef BENCH_KERNEL_H
+#define BENCH_KERNEL_H
+
+// Outils communs aux microbenchmarks des noyaux du rendu (bench_dda, bench_floor...)
+// Options reconnues par chaque programme:
+//   --warmup N       passes de chauffe non mesurées (défaut 3)
+//   --repeats N      passes mesurées (défaut 15)
+//   --json FICHIER   écrit le résultat au format JSON
+//   --baseline F     compare au JSON de référence F (écrit auparavant par --json)
+//   --threshold P    régression tolérée en % du ns/élément de référence (défaut 10)
+//   --kernel NIVEAU  variantes SIMD (auto par défaut, scalar, sse2, avx2, avx512)
+// Le code de sortie vaut 1 si la régression dépasse le seuil.
+
+#include <SDL2/SDL.h>
+
+#include "../src/map.h"
+#include "../src/player.h"
+#include "../src/textures.h"
+#include "../src/kernels.h"
+#include "../editor/lighting.h"
+
+#define BENCH_WARMUP_DEFAULT 3
+#define BENCH_REPEATS_DEFAULT 15
+#define BENCH_REPEATS_MAX 1000
+#define BENCH_THRESHOLD_DEFAULT 10.0
+
+typedef struct {
+    const char* kernel;         // Nom du noyau (clé "kernel" du JSON)
+    int warmup;
+    int repeats;
+    const char* json_path;
+    const char* baseline_path;
+    double threshold;           // En %
+    int lit;                    // 0 avec --unlit: scène sans lumières
+    int kernel_level;           // KERNEL_* en service (détecté par défaut)
+} BenchOptions;
+
+typedef struct {
+    double min_ms;
+    double median_ms;
+    double mean_ms;
+    double ns_per_item;         // Sur la médiane
+    long items;                 // Éléments traités par passe (rayons, pixels, appels)
+} BenchResult;
+
+// Une passe complète du noyau, renvoie le nombre d'éléments traités
+typedef long (*BenchPass)(void* context);
+
+// Empêche le compilateur d'éliminer les calculs mesurés
+extern volatile Uint32 bench_sink;
+
+void bench_parse_options(BenchOptions* options, const char* kernel, int argc, char* argv[]);
+double bench_now_ms(void);
+
+// Chauffe, mesure, affiche, écrit le JSON et compare à la référence.
+// Renvoie le code de sortie du programme.
+int bench_run(const BenchOptions* options, BenchPass pass, void* context);
+
+// Scène synthétique déterministe
+Uint32 bench_random(Uint32* state);
+int bench_scene_textures(TextureManager* tm, int count, int size);
+void bench_scene_free_textures(TextureManager* tm);
+int bench_scene_map(Map* map, int size, int wall_percent, int texture_count);
+void bench_scene_lights(LightManager* lm, Map* map, int count);
+void bench_scene_pose(Player* player, Map* map, int index);
+
+#endif
@@ -0,0 +1,71 @@
+// Microbenchmark de lighting_calculate_pixel_color_fast
+// Usage: bench_light_pixel [--unlit] [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Éclaire des points répartis sur une map 64x64 avec 24 lumières ombrées
+//   (aucune lumière avec --unlit: seul le chemin ambiant est mesuré).
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_kernel.h"
+
+#define BENCH_LIGHT_SAMPLES (1 << 16)
+
+typedef struct {
+    LightManager lights;
+    float* world_x;
+    float* world_y;
+    Uint32* colors;
+} LightPixelBench;
+
+static long bench_light_pixel_pass(void* context) {
+    LightPixelBench* bench = (LightPixelBench*)context;
+    Uint32 sum = 0;
+    for (int i = 0; i < BENCH_LIGHT_SAMPLES; i++) {
+        Uint32 color;
+        lighting_calculate_pixel_color_fast(&bench->lights, bench->world_x[i], bench->world_y[i],
+                                            bench->colors[i], &color);
+        sum += color;
+    }
+    bench_sink += sum;
+    return BENCH_LIGHT_SAMPLES;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "light_pixel", argc, argv);
+
+    static LightPixelBench bench;
+    Map map;
+    if (!bench_scene_map(&map, 64, 20, 8)) {
+        return 2;
+    }
+    bench_scene_lights(&bench.lights, &map, options.lit ? 24 : 0);
+
+    bench.world_x = malloc(sizeof(float) * BENCH_LIGHT_SAMPLES);
+    bench.world_y = malloc(sizeof(float) * BENCH_LIGHT_SAMPLES);
+    bench.colors = malloc(sizeof(Uint32) * BENCH_LIGHT_SAMPLES);
+    if (!bench.world_x || !bench.world_y || !bench.colors) {
+        printf("Erreur allocation des échantillons\n");
+        return 2;
+    }
+
+    // Points le long de lignes de sol, dans l'ordre où le rendu les visite
+    Uint32 seed = 0x1B873593;
+    for (int i = 0; i < BENCH_LIGHT_SAMPLES; i++) {
+        int row = i / 400;
+        bench.world_x[i] = 1.0f + (i % 400) * (62.0f / 400.0f);
+        bench.world_y[i] = 1.0f + (row % 62) + (bench_random(&seed) % 1000) / 1000.0f;
+        bench.colors[i] = bench_random(&seed) | 0xFF;
+    }
+
+    int status = bench_run(&options, bench_light_pixel_pass, &bench);
+
+    free(bench.world_x);
+    free(bench.world_y);
+    free(bench.colors);
+    lighting_destroy(&bench.lights);
+    map_free(&map);
+    return status;
+}
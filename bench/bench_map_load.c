@@ -0,0 +1,150 @@
+// Benchmark du parseur de maps texte
+// Usage: bench_map_load [dossier_maps] [iterations] [--big N]
+//   Charge chaque .txt du dossier (build/maps par défaut) en boucle et
+//   mesure lecture fichier + parsing. --big N ajoute une map synthétique N x N.
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+
+#include "../src/map.h"
+#include "bench_kernel.h"
+
+// Génère une map N x N au format de l'éditeur
+static char* bench_generate_map(int n, size_t* out_size) {
+    size_t capacity = (size_t)n * n * 24 + 64;
+    char* data = malloc(capacity);
+    if (!data) return NULL;
+
+    size_t len = (size_t)sprintf(data, "SIZE %d %d\nPLAYER_START 1.50 1.50\n", n, n);
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; x++) {
+            int wall = (x == 0 || y == 0 || x == n - 1 || y == n - 1 || (x % 7 == 0 && y % 5 != 0));
+            len += (size_t)sprintf(data + len, "1,%d 1,%d %d,%d  ", x % 8, y % 8, wall, (x + y) % 8);
+        }
+        data[len++] = '\n';
+    }
+    data[len] = '\0';
+    *out_size = len;
+    return data;
+}
+
+// Parse "iterations" fois, renvoie le temps moyen en ms
+static double bench_parse(const char* name, const char* data, size_t size, int iterations, long* out_cells) {
+    Map map;
+    double start = bench_now_ms();
+    for (int i = 0; i < iterations; i++) {
+        if (!map_parse(&map, data, size, name)) {
+            return -1.0;
+        }
+        *out_cells = (long)map.width * map.height;
+        map_free(&map);
+    }
+    return (bench_now_ms() - start) / iterations;
+}
+
+static void bench_report(const char* name, size_t size, long cells, double read_ms, double parse_ms) {
+    printf("%-28s %9zu o %9ld cellules  lecture %8.3f ms  parsing %8.3f ms  %7.1f Mo/s  %7.2f Mcell/s\n",
+           name, size, cells, read_ms, parse_ms,
+           size / (parse_ms * 1000.0), cells / (parse_ms * 1000.0));
+}
+
+int main(int argc, char* argv[]) {
+    const char* maps_dir = "build/maps";
+    int iterations = 200;
+    int big_size = 0;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--big") == 0 && i + 1 < argc) {
+            big_size = atoi(argv[++i]);
+        } else if (positional == 0) {
+            maps_dir = argv[i];
+            positional++;
+        } else {
+            iterations = atoi(argv[i]);
+            if (iterations < 1) iterations = 1;
+        }
+    }
+
+    DIR* dir = opendir(maps_dir);
+    if (!dir) {
+        printf("Impossible d'ouvrir %s\n", maps_dir);
+        return 1;
+    }
+
+    printf("=== BENCHMARK CHARGEMENT DE MAPS (%s, %d itérations) ===\n", maps_dir, iterations);
+
+    size_t total_size = 0;
+    long total_cells = 0;
+    double total_ms = 0.0;
+    int map_count = 0;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        char* ext = strrchr(entry->d_name, '.');
+        if (!ext || strcmp(ext, ".txt") != 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", maps_dir, entry->d_name);
+
+        // Lecture disque seule (cache système chaud)
+        size_t size = 0;
+        double start = bench_now_ms();
+        for (int i = 0; i < iterations; i++) {
+            char* data = map_read_file(path, &size);
+            free(data);
+        }
+        double read_ms = (bench_now_ms() - start) / iterations;
+
+        char* data = map_read_file(path, &size);
+        if (!data) continue;
+
+        long cells = 0;
+        double parse_ms = bench_parse(path, data, size, iterations, &cells);
+        free(data);
+        if (parse_ms < 0.0) {
+            printf("%-28s ÉCHEC\n", entry->d_name);
+            continue;
+        }
+
+        bench_report(entry->d_name, size, cells, read_ms, parse_ms);
+        total_size += size;
+        total_cells += cells;
+        total_ms += read_ms + parse_ms;
+        map_count++;
+    }
+    closedir(dir);
+
+    if (map_count > 0) {
+        printf("TOTAL: %d maps, %zu octets, %ld cellules, %.3f ms par passe complète\n",
+               map_count, total_size, total_cells, total_ms);
+    }
+
+    if (big_size > 0) {
+        size_t size = 0;
+        char* data = bench_generate_map(big_size, &size);
+        if (!data) {
+            printf("Allocation impossible pour la map synthétique %dx%d\n", big_size, big_size);
+            return 1;
+        }
+
+        int big_iterations = iterations / 20 > 0 ? iterations / 20 : 1;
+        long cells = 0;
+        double parse_ms = bench_parse("synthétique", data, size, big_iterations, &cells);
+        free(data);
+
+        char name[64];
+        snprintf(name, sizeof(name), "synthetique_%dx%d", big_size, big_size);
+        if (parse_ms < 0.0) {
+            printf("%-28s ÉCHEC\n", name);
+            return 1;
+        }
+        bench_report(name, size, cells, 0.0, parse_ms);
+    }
+
+    return 0;
+}
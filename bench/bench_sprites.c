@@ -0,0 +1,133 @@
+// Microbenchmark de la passe des sprites (culling, tri, dessin)
+// Usage: bench_sprites [--unlit] [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Map à 20% de murs couverte de décors (une entité pour 4 tiles), écran 800x600.
+//   Les murs de chaque pose sont rendus une fois à la préparation: seule
+//   raycaster_draw_sprites est mesurée. Affiche d'abord le temps d'une passe pour
+//   un nombre croissant d'entités sur une map de plus en plus grande (même densité,
+//   donc autant de sprites à l'écran: le temps doit rester à peu près constant),
+//   puis la même chose sur une map ouverte 64x64 (bordure seule), où des centaines
+//   à des milliers de sprites sont réellement dessinés. La mesure de référence
+//   (--json, --baseline) porte sur BENCH_SPRITES_OPEN_COUNT entités de la map ouverte.
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+#include "bench_kernel.h"
+#include "../src/raycaster.h"
+#include "../src/entities.h"
+
+#define BENCH_SPRITES_WIDTH 800
+#define BENCH_SPRITES_HEIGHT 600
+#define BENCH_SPRITES_POSES 4
+#define BENCH_SPRITES_COUNT 16384     // Map 256x256
+#define BENCH_SPRITES_OPEN_SIZE 64
+#define BENCH_SPRITES_OPEN_COUNT 4096 // Une entité par tile de la map ouverte
+
+typedef struct {
+    RaycastRenderer rc[BENCH_SPRITES_POSES];    // Profondeurs des murs de chaque pose
+    Map map;
+    TextureManager tm;
+    LightManager lights;
+    int lit;
+    Player poses[BENCH_SPRITES_POSES];
+} SpritesBench;
+
+static long bench_sprites_pass(void* context) {
+    SpritesBench* bench = (SpritesBench*)context;
+    for (int p = 0; p < BENCH_SPRITES_POSES; p++) {
+        raycaster_draw_sprites(&bench->rc[p], &bench->poses[p], &bench->map, &bench->tm);
+        bench_sink += bench->rc[p].sprites_drawn;
+    }
+    return BENCH_SPRITES_POSES;
+}
+
+static void bench_sprites_free_scene(SpritesBench* bench) {
+    entities_destroy(bench->map.entities);
+    bench->map.entities = NULL;
+    if (bench->lit) lighting_destroy(&bench->lights);
+    map_free(&bench->map);
+}
+
+// Map size x size à wall_percent% de murs, murs de chaque pose rendus, décors
+// répartis (même graine)
+static int bench_sprites_scene(SpritesBench* bench, int size, int wall_percent, int count) {
+    if (!bench_scene_map(&bench->map, size, wall_percent, 16)) return 0;
+    bench->map.entities = entities_create(bench->map.width, bench->map.height);
+    if (!bench->map.entities) return 0;
+    if (bench->lit) {
+        bench_scene_lights(&bench->lights, &bench->map, 24);
+    }
+    for (int p = 0; p < BENCH_SPRITES_POSES; p++) {
+        raycaster_set_lighting(&bench->rc[p], bench->lit ? &bench->lights : NULL);
+        bench_scene_pose(&bench->poses[p], &bench->map, p);
+        raycaster_render(&bench->rc[p], &bench->poses[p], &bench->map, &bench->tm);
+    }
+    entities_scatter(bench->map.entities, &bench->map, count, bench->tm.count, 0x68E31DA4);
+    return 1;
+}
+
+// Temps moyen d'une pose et sprites dessinés pour la scène en place, puis libère la scène
+static void bench_sprites_series(SpritesBench* bench) {
+    int passes = 20;
+    int drawn = 0;
+    bench_sprites_pass(bench);
+    double start = bench_now_ms();
+    for (int i = 0; i < passes; i++) {
+        bench_sprites_pass(bench);
+    }
+    double ms = (bench_now_ms() - start) / (passes * BENCH_SPRITES_POSES);
+    for (int p = 0; p < BENCH_SPRITES_POSES; p++) {
+        drawn += bench->rc[p].sprites_drawn;
+    }
+    printf("%6d entités (map %dx%d): %.3f ms par pose (%d sprites dessinés)\n",
+           bench->map.entities->count, bench->map.width, bench->map.height, ms,
+           drawn / BENCH_SPRITES_POSES);
+    bench_sprites_free_scene(bench);
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "sprites", argc, argv);
+
+    static SpritesBench bench;
+    bench.lit = options.lit;
+    if (!bench_scene_textures(&bench.tm, 16, 64)) {
+        return 2;
+    }
+    for (int p = 0; p < BENCH_SPRITES_POSES; p++) {
+        if (!raycaster_init(&bench.rc[p], NULL, BENCH_SPRITES_WIDTH, BENCH_SPRITES_HEIGHT)) {
+            return 2;
+        }
+    }
+
+    // Passe des sprites selon le nombre d'entités, à densité constante
+    for (int count = BENCH_SPRITES_COUNT / 16; count <= ENTITIES_MAX; count *= 4) {
+        int size = 2;
+        while (size * size < count * 4) size *= 2;
+        if (!bench_sprites_scene(&bench, size, 20, count)) {
+            return 2;
+        }
+        bench_sprites_series(&bench);
+    }
+
+    // Map ouverte: la densité monte, les sprites à l'écran aussi
+    for (int count = BENCH_SPRITES_OPEN_COUNT / 16; count <= BENCH_SPRITES_OPEN_COUNT * 4; count *= 4) {
+        if (!bench_sprites_scene(&bench, BENCH_SPRITES_OPEN_SIZE, 0, count)) {
+            return 2;
+        }
+        bench_sprites_series(&bench);
+    }
+
+    if (!bench_sprites_scene(&bench, BENCH_SPRITES_OPEN_SIZE, 0, BENCH_SPRITES_OPEN_COUNT)) {
+        return 2;
+    }
+    int status = bench_run(&options, bench_sprites_pass, &bench);
+
+    for (int p = 0; p < BENCH_SPRITES_POSES; p++) {
+        raycaster_destroy(&bench.rc[p]);
+    }
+    bench_sprites_free_scene(&bench);
+    bench_scene_free_textures(&bench.tm);
+    return status;
+}
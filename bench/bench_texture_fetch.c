@@ -0,0 +1,74 @@
+// Microbenchmark de la lecture de texels (raycaster_get_pixel_from_texture)
+// Usage: bench_texture_fetch [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Lectures dans 16 textures 256x256 de l'arène: une moitié en colonnes
+//   (comme les murs), l'autre en coordonnées dispersées (comme le sol au loin).
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_kernel.h"
+#include "../src/raycaster.h"
+
+#define BENCH_FETCH_SAMPLES (1 << 18)
+#define BENCH_FETCH_TEXTURES 16
+
+typedef struct {
+    TextureManager tm;
+    Uint16* ids;
+    int* tex_x;
+    int* tex_y;
+} FetchBench;
+
+static long bench_texture_fetch_pass(void* context) {
+    FetchBench* bench = (FetchBench*)context;
+    Uint32 sum = 0;
+    for (int i = 0; i < BENCH_FETCH_SAMPLES; i++) {
+        const TextureEntry* tex = textures_get_entry(&bench->tm, bench->ids[i]);
+        sum += raycaster_get_pixel_from_texture(bench->tm.pixels, tex, bench->tex_x[i], bench->tex_y[i]);
+    }
+    bench_sink += sum;
+    return BENCH_FETCH_SAMPLES;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "texture_fetch", argc, argv);
+
+    static FetchBench bench;
+    if (!bench_scene_textures(&bench.tm, BENCH_FETCH_TEXTURES, 256)) {
+        return 2;
+    }
+
+    bench.ids = malloc(sizeof(Uint16) * BENCH_FETCH_SAMPLES);
+    bench.tex_x = malloc(sizeof(int) * BENCH_FETCH_SAMPLES);
+    bench.tex_y = malloc(sizeof(int) * BENCH_FETCH_SAMPLES);
+    if (!bench.ids || !bench.tex_x || !bench.tex_y) {
+        printf("Erreur allocation des échantillons\n");
+        return 2;
+    }
+
+    Uint32 seed = 0x27D4EB2F;
+    int half = BENCH_FETCH_SAMPLES / 2;
+    for (int i = 0; i < half; i++) {
+        // Colonnes de 256 texels, coordonnée x fixe
+        int column = i / 256;
+        bench.ids[i] = (Uint16)(column % BENCH_FETCH_TEXTURES);
+        bench.tex_x[i] = column * 37;
+        bench.tex_y[i] = i % 256;
+    }
+    for (int i = half; i < BENCH_FETCH_SAMPLES; i++) {
+        bench.ids[i] = (Uint16)(bench_random(&seed) % BENCH_FETCH_TEXTURES);
+        bench.tex_x[i] = (int)(bench_random(&seed) % 1024);
+        bench.tex_y[i] = (int)(bench_random(&seed) % 1024);
+    }
+
+    int status = bench_run(&options, bench_texture_fetch_pass, &bench);
+
+    free(bench.ids);
+    free(bench.tex_x);
+    free(bench.tex_y);
+    bench_scene_free_textures(&bench.tm);
+    return status;
+}
@@ -0,0 +1,94 @@
+// Microbenchmark de l'ombrage des colonnes de murs
+// Usage: bench_wall [--unlit] [--warmup N] [--repeats N] [--json F] [--baseline F] [--threshold P]
+//   Les rayons et colonnes (texture, éclairage de la face) sont préparés une
+//   fois; sont mesurées la boucle de pixels des colonnes (buffer par colonnes)
+//   et la transposition des murs vers l'écran.
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_kernel.h"
+#include "../src/raycaster.h"
+
+#define BENCH_WALL_WIDTH 800
+#define BENCH_WALL_HEIGHT 600
+#define BENCH_WALL_POSES 8
+
+typedef struct {
+    RaycastRenderer rc;
+    TextureManager tm;
+    RayHit* hits;           // [BENCH_WALL_POSES * BENCH_WALL_WIDTH]
+    WallColumn* columns;
+    ColumnDepth* spans;     // Étendue des murs de chaque pose pour la transposition
+    long pixels;
+} WallBench;
+
+static long bench_wall_pass(void* context) {
+    WallBench* bench = (WallBench*)context;
+    for (int p = 0; p < BENCH_WALL_POSES; p++) {
+        for (int x = 0; x < BENCH_WALL_WIDTH; x++) {
+            int index = p * BENCH_WALL_WIDTH + x;
+            if (!bench->hits[index].hit) continue;
+            raycaster_draw_wall_column(&bench->rc, &bench->tm, x, &bench->hits[index], &bench->columns[index]);
+        }
+        memcpy(bench->rc.columns, bench->spans + p * BENCH_WALL_WIDTH, BENCH_WALL_WIDTH * sizeof(ColumnDepth));
+        raycaster_transpose_walls(&bench->rc, 0, BENCH_WALL_HEIGHT);
+        bench_sink += bench->rc.screen_buffer[(BENCH_WALL_HEIGHT / 2) * BENCH_WALL_WIDTH];
+    }
+    return bench->pixels;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_parse_options(&options, "wall", argc, argv);
+
+    static WallBench bench;
+    static LightManager lights;
+    Map map;
+    if (!bench_scene_textures(&bench.tm, 16, 64) || !bench_scene_map(&map, 64, 20, 16)) {
+        return 2;
+    }
+    if (!raycaster_init(&bench.rc, NULL, BENCH_WALL_WIDTH, BENCH_WALL_HEIGHT)) {
+        return 2;
+    }
+    if (options.lit) {
+        bench_scene_lights(&lights, &map, 24);
+        raycaster_set_lighting(&bench.rc, &lights);
+    }
+
+    bench.hits = malloc(sizeof(RayHit) * BENCH_WALL_POSES * BENCH_WALL_WIDTH);
+    bench.columns = malloc(sizeof(WallColumn) * BENCH_WALL_POSES * BENCH_WALL_WIDTH);
+    bench.spans = calloc(BENCH_WALL_POSES * BENCH_WALL_WIDTH, sizeof(ColumnDepth));
+    if (!bench.hits || !bench.columns || !bench.spans) {
+        printf("Erreur allocation des colonnes\n");
+        return 2;
+    }
+    for (int p = 0; p < BENCH_WALL_POSES; p++) {
+        Player player;
+        bench_scene_pose(&player, &map, p);
+        for (int x = 0; x < BENCH_WALL_WIDTH; x++) {
+            int index = p * BENCH_WALL_WIDTH + x;
+            raycaster_cast_column(&player, &map, x, BENCH_WALL_WIDTH, 0.0f, &bench.hits[index]);
+            if (!bench.hits[index].hit) continue;
+            raycaster_setup_wall(&bench.rc, &player, &map, &bench.tm, &bench.hits[index], &bench.columns[index]);
+            bench.spans[index].depth = bench.hits[index].perp_wall_dist;
+            bench.spans[index].draw_start = bench.columns[index].draw_start;
+            bench.spans[index].draw_end = bench.columns[index].draw_end;
+            bench.pixels += bench.columns[index].draw_end - bench.columns[index].draw_start;
+        }
+    }
+
+    int status = bench_run(&options, bench_wall_pass, &bench);
+
+    free(bench.hits);
+    free(bench.columns);
+    free(bench.spans);
+    raycaster_destroy(&bench.rc);
+    if (options.lit) lighting_destroy(&lights);
+    bench_scene_free_textures(&bench.tm);
+    map_free(&map);
+    return status;
+}
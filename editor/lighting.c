@@ -1,235 +1,1053 @@
-#include "lighting.h"
-#include <stdio.h>
-#include <math.h>
-#include <string.h>
-
-void lighting_init(LightManager* lm) {
-    lm->count = 0;
-    lm->active_count = 0;
-    
-    // Initialiser toutes les lumières comme inactives
-    for (int i = 0; i < MAX_LIGHTS; i++) {
-        lm->lights[i].active = 0;
-        lm->lights[i].x = 0.0f;
-        lm->lights[i].y = 0.0f;
-        lm->lights[i].r = 1.0f;
-        lm->lights[i].g = 1.0f;
-        lm->lights[i].b = 1.0f;
-        lm->lights[i].intensity = 1.0f;
-        lm->lights[i].radius = 5.0f;
-        lm->lights[i].radius_squared = 25.0f;
-        lm->active_lights[i] = -1;
-    }
-    
-    // Lumière ambiante par défaut (faible et blanche)
-    lighting_set_ambient(lm, 0.3f, 0.3f, 0.3f, 0.2f);
-}
-
-int lighting_add_light(LightManager* lm, float x, float y, float r, float g, float b, float intensity, float radius) {
-    if (lm->count >= MAX_LIGHTS) {
-        printf("Erreur: Nombre maximum de lumières atteint (%d)\n", MAX_LIGHTS);
-        return -1;
-    }
-    
-    int index = lm->count;
-    Light* light = &lm->lights[index];
-    
-    light->x = x;
-    light->y = y;
-    light->r = r;
-    light->g = g;
-    light->b = b;
-    light->intensity = intensity;
-    light->radius = radius;
-    light->radius_squared = radius * radius;  // Précalculer le carré
-    light->active = 1;
-    
-    lm->count++;
-    lighting_update_cache(lm);  // Mettre à jour le cache
-    
-    printf("Lumière ajoutée à (%.1f, %.1f) - RGB(%.2f,%.2f,%.2f) I:%.1f R:%.1f\n", 
-           x, y, r, g, b, intensity, radius);
-    
-    return index;
-}
-
-void lighting_remove_light(LightManager* lm, int index) {
-    if (index < 0 || index >= lm->count) return;
-    
-    // Désactiver la lumière
-    lm->lights[index].active = 0;
-    
-    // Compacter le tableau
-    for (int i = index; i < lm->count - 1; i++) {
-        lm->lights[i] = lm->lights[i + 1];
-    }
-    
-    lm->count--;
-    lighting_update_cache(lm);  // Mettre à jour le cache
-    printf("Lumière supprimée (index %d)\n", index);
-}
-
-void lighting_clear_all(LightManager* lm) {
-    for (int i = 0; i < MAX_LIGHTS; i++) {
-        lm->lights[i].active = 0;
-    }
-    lm->count = 0;
-    lm->active_count = 0;
-    printf("Toutes les lumières supprimées\n");
-}
-
-void lighting_update_cache(LightManager* lm) {
-    lm->active_count = 0;
-    for (int i = 0; i < lm->count; i++) {
-        if (lm->lights[i].active) {
-            lm->active_lights[lm->active_count] = i;
-            lm->active_count++;
-        }
-    }
-}
-
-// Version ultra-optimisée de l'atténuation
-float lighting_calculate_distance_attenuation_fast(float distance_squared, float radius_squared) {
-    if (distance_squared > radius_squared) return 0.0f;
-    
-    // Atténuation linéaire simple (plus rapide que quadratique)
-    float distance = sqrtf(distance_squared);
-    float radius = sqrtf(radius_squared);
-    float attenuation = 1.0f - (distance / radius);
-    
-    // Courbe simple pour adoucir
-    return attenuation * attenuation;
-}
-
-// Version optimisée de l'application de lumière
-Uint32 lighting_apply_light_to_color_fast(Uint32 base_color, float light_r, float light_g, float light_b, float intensity) {
-    // Extraire les composantes (format RGBA8888)
-    Uint8 r = (base_color >> 24) & 0xFF;
-    Uint8 g = (base_color >> 16) & 0xFF;
-    Uint8 b = (base_color >> 8) & 0xFF;
-    Uint8 a = base_color & 0xFF;
-    
-    // Calculs en entiers pour plus de vitesse
-    int fr = (int)((r * light_r * intensity) + 0.5f);
-    int fg = (int)((g * light_g * intensity) + 0.5f);
-    int fb = (int)((b * light_b * intensity) + 0.5f);
-    
-    // Clamping rapide
-    if (fr > 255) fr = 255;
-    if (fg > 255) fg = 255;
-    if (fb > 255) fb = 255;
-    
-    return ((Uint8)fr << 24) | ((Uint8)fg << 16) | ((Uint8)fb << 8) | a;
-}
-
-// Version ultra-optimisée du calcul d'éclairage
-void lighting_calculate_pixel_color_fast(LightManager* lm, float world_x, float world_y, 
-                                        Uint32 base_color, Uint32* output_color) {
-    // Commencer avec la lumière ambiante
-    float total_r = lm->ambient_r * lm->ambient_intensity;
-    float total_g = lm->ambient_g * lm->ambient_intensity;
-    float total_b = lm->ambient_b * lm->ambient_intensity;
-    
-    // Traiter seulement les lumières actives (cache optimisé)
-    for (int i = 0; i < lm->active_count; i++) {
-        int light_idx = lm->active_lights[i];
-        Light* light = &lm->lights[light_idx];
-        
-        // Calculer la distance au carré (éviter sqrt)
-        float dx = world_x - light->x;
-        float dy = world_y - light->y;
-        float distance_squared = dx * dx + dy * dy;
-        
-        // Test rapide de distance
-        if (distance_squared > light->radius_squared) continue;
-        
-        // Calculer l'atténuation optimisée
-        float attenuation = lighting_calculate_distance_attenuation_fast(distance_squared, light->radius_squared);
-        
-        // Ignorer les contributions négligeables
-        if (attenuation < MIN_LIGHT_CONTRIBUTION) continue;
-        
-        // Ajouter la contribution de cette lumière
-        float contribution = light->intensity * attenuation;
-        total_r += light->r * contribution;
-        total_g += light->g * contribution;
-        total_b += light->b * contribution;
-    }
-    
-    // Appliquer l'éclairage final
-    *output_color = lighting_apply_light_to_color_fast(base_color, total_r, total_g, total_b, 1.0f);
-}
-
-void lighting_set_ambient(LightManager* lm, float r, float g, float b, float intensity) {
-    lm->ambient_r = r;
-    lm->ambient_g = g;
-    lm->ambient_b = b;
-    lm->ambient_intensity = intensity;
-}
-
-Light* lighting_get_light(LightManager* lm, int index) {
-    if (index < 0 || index >= lm->count) return NULL;
-    return &lm->lights[index];
-}
-
-int lighting_save_to_file(LightManager* lm, const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        printf("Erreur: impossible d'ouvrir %s pour écriture\n", filename);
-        return 0;
-    }
-    
-    // Sauvegarder la lumière ambiante
-    fprintf(file, "AMBIENT %.2f %.2f %.2f %.2f\n", 
-            lm->ambient_r, lm->ambient_g, lm->ambient_b, lm->ambient_intensity);
-    
-    // Sauvegarder le nombre de lumières
-    fprintf(file, "LIGHTS %d\n", lm->count);
-    
-    // Sauvegarder chaque lumière
-    for (int i = 0; i < lm->count; i++) {
-        Light* light = &lm->lights[i];
-        if (light->active) {
-            fprintf(file, "LIGHT %.2f %.2f %.2f %.2f %.2f %.2f %.2f\n",
-                    light->x, light->y, light->r, light->g, light->b, 
-                    light->intensity, light->radius);
-        }
-    }
-    
-    fclose(file);
-    printf("Données d'éclairage sauvegardées dans %s\n", filename);
-    return 1;
-}
-
-int lighting_load_from_file(LightManager* lm, const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("Aucun fichier d'éclairage trouvé: %s\n", filename);
-        return 0;
-    }
-    
-    lighting_init(lm); // Réinitialiser
-    
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        if (strncmp(line, "AMBIENT", 7) == 0) {
-            float r, g, b, intensity;
-            if (sscanf(line, "AMBIENT %f %f %f %f", &r, &g, &b, &intensity) == 4) {
-                lighting_set_ambient(lm, r, g, b, intensity);
-            }
-        } else if (strncmp(line, "LIGHTS", 6) == 0) {
-            int count;
-            sscanf(line, "LIGHTS %d", &count);
-        } else if (strncmp(line, "LIGHT", 5) == 0) {
-            float x, y, r, g, b, intensity, radius;
-            if (sscanf(line, "LIGHT %f %f %f %f %f %f %f", 
-                      &x, &y, &r, &g, &b, &intensity, &radius) == 7) {
-                lighting_add_light(lm, x, y, r, g, b, intensity, radius);
-            }
-        }
-    }
-    
-    fclose(file);
-    printf("Données d'éclairage chargées depuis %s (%d lumières)\n", filename, lm->count);
-    return 1;
+#include "lighting.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static void lighting_area_clear(LightManager* lm, Light* light);
+static void lighting_bake_basis(LightManager* lm, int index);
+static void lighting_animated_free(LightManager* lm);
+static void lighting_animated_region(LightManager* lm, int x0, int y0, int x1, int y1);
+static void lighting_animated_slots(LightManager* lm);
+
+static SDL_atomic_t lighting_version_counter;
+
+// Marquer l'éclairage comme modifié (les managers peuvent être créés sur un thread de chargement)
+static void lighting_touch(LightManager* lm) {
+    lm->version = (Uint32)SDL_AtomicAdd(&lighting_version_counter, 1) + 1;
+}
+
+void lighting_init(LightManager* lm) {
+    lm->count = 0;
+    lm->active_count = 0;
+    lm->visible_count = 0;
+    lm->visible_slots = 0;
+    lm->occluders = NULL;
+    lm->grid_width = 0;
+    lm->grid_height = 0;
+    lm->tile_lights = NULL;
+    lm->animated = NULL;
+    lm->anim_blocks_x = 0;
+    lm->anim_blocks_y = 0;
+    lm->cells_width = 0;
+    lm->cells_height = 0;
+    lm->animated_slots = 0;
+    lm->animated_deltas = 0;
+    
+    // Initialiser toutes les lumières comme inactives
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        lm->lights[i].active = 0;
+        lm->lights[i].x = 0.0f;
+        lm->lights[i].y = 0.0f;
+        lm->lights[i].r = 1.0f;
+        lm->lights[i].g = 1.0f;
+        lm->lights[i].b = 1.0f;
+        lm->lights[i].intensity = 1.0f;
+        lm->lights[i].radius = 5.0f;
+        lm->lights[i].radius_squared = 25.0f;
+        lm->lights[i].visibility = NULL;
+        lm->lights[i].slot = -1;
+        lm->lights[i].area_x0 = -1;
+        lm->lights[i].animation = LIGHT_ANIM_NONE;
+        lm->lights[i].anim_rate = 0.0f;
+        lm->lights[i].anim_depth = 0.0f;
+        lm->lights[i].anim_scale = 1.0f;
+        lm->lights[i].basis = NULL;
+        lm->active_lights[i] = -1;
+        lm->slot_light[i] = -1;
+    }
+    
+    // Lumière ambiante par défaut (faible et blanche)
+    lighting_set_ambient(lm, 0.3f, 0.3f, 0.3f, 0.2f);
+}
+
+int lighting_add_light(LightManager* lm, float x, float y, float r, float g, float b, float intensity, float radius) {
+    if (lm->count >= MAX_LIGHTS) {
+        printf("Erreur: Nombre maximum de lumières atteint (%d)\n", MAX_LIGHTS);
+        return -1;
+    }
+    
+    int index = lm->count;
+    Light* light = &lm->lights[index];
+    
+    light->x = x;
+    light->y = y;
+    light->r = r;
+    light->g = g;
+    light->b = b;
+    light->intensity = intensity;
+    light->radius = radius;
+    light->radius_squared = radius * radius;  // Précalculer le carré
+    light->active = 1;
+    light->visibility = NULL;
+    light->animation = LIGHT_ANIM_NONE;
+    light->anim_rate = 0.0f;
+    light->anim_depth = 0.0f;
+    light->anim_scale = 1.0f;
+    light->basis = NULL;
+    
+    // Premier slot libre pour la grille des zones d'effet
+    light->slot = -1;
+    light->area_x0 = -1;
+    for (int slot = 0; slot < MAX_LIGHTS; slot++) {
+        if (lm->slot_light[slot] < 0) {
+            light->slot = slot;
+            lm->slot_light[slot] = index;
+            break;
+        }
+    }
+    
+    lm->count++;
+    lighting_refresh_light(lm, index);
+    lighting_update_cache(lm);  // Mettre à jour le cache
+    
+    printf("Lumière ajoutée à (%.1f, %.1f) - RGB(%.2f,%.2f,%.2f) I:%.1f R:%.1f\n", 
+           x, y, r, g, b, intensity, radius);
+    
+    return index;
+}
+
+void lighting_remove_light(LightManager* lm, int index) {
+    if (index < 0 || index >= lm->count) return;
+    
+    // Désactiver la lumière et retirer sa zone d'effet
+    Light* removed = &lm->lights[index];
+    removed->active = 0;
+    free(removed->visibility);
+    lighting_area_clear(lm, removed);
+    
+    // Sa contribution quitte la somme des lumières animées
+    int had_basis = removed->basis != NULL;
+    int bx0 = removed->basis_x, by0 = removed->basis_y;
+    int bx1 = bx0 + removed->basis_w, by1 = by0 + removed->basis_h;
+    free(removed->basis);
+    removed->basis = NULL;
+    if (removed->slot >= 0) {
+        lm->slot_light[removed->slot] = -1;
+    }
+    
+    // Compacter le tableau (visibilité et slot suivent leur lumière)
+    for (int i = index; i < lm->count - 1; i++) {
+        lm->lights[i] = lm->lights[i + 1];
+        if (lm->lights[i].slot >= 0) {
+            lm->slot_light[lm->lights[i].slot] = i;
+        }
+    }
+    lm->lights[lm->count - 1].visibility = NULL;
+    lm->lights[lm->count - 1].basis = NULL;
+    lm->lights[lm->count - 1].slot = -1;
+    
+    lm->count--;
+    if (had_basis) {
+        lighting_animated_region(lm, bx0, by0, bx1, by1);
+        lighting_animated_slots(lm);
+    }
+    lighting_touch(lm);
+    lighting_update_cache(lm);  // Mettre à jour le cache
+    printf("Lumière supprimée (index %d)\n", index);
+}
+
+void lighting_set_light(LightManager* lm, int index, float x, float y, float r, float g, float b, float intensity, float radius) {
+    if (index < 0 || index >= lm->count) return;
+    
+    // Modifier une lumière existante sans toucher aux autres
+    Light* light = &lm->lights[index];
+    light->x = x;
+    light->y = y;
+    light->r = r;
+    light->g = g;
+    light->b = b;
+    light->intensity = intensity;
+    light->radius = radius;
+    light->radius_squared = radius * radius;
+    light->active = 1;
+    
+    lighting_refresh_light(lm, index);
+    lighting_update_cache(lm);
+}
+
+void lighting_clear_all(LightManager* lm) {
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        lm->lights[i].active = 0;
+        free(lm->lights[i].visibility);
+        lm->lights[i].visibility = NULL;
+        lm->lights[i].slot = -1;
+        lm->slot_light[i] = -1;
+    }
+    lighting_animated_free(lm);
+    if (lm->tile_lights) {
+        memset(lm->tile_lights, 0, lm->grid_width * lm->grid_height * sizeof(Uint32));
+    }
+    lighting_touch(lm);
+    lm->count = 0;
+    lm->active_count = 0;
+    lm->visible_count = 0;
+    lm->visible_slots = 0;
+    printf("Toutes les lumières supprimées\n");
+}
+
+void lighting_update_cache(LightManager* lm) {
+    lm->active_count = 0;
+    lm->visible_count = 0;
+    lm->visible_slots = 0;
+    for (int i = 0; i < lm->count; i++) {
+        if (lm->lights[i].active) {
+            lm->active_lights[lm->active_count] = i;
+            lm->active_count++;
+            
+            // Sans culling, toutes les lumières actives sont visibles
+            lm->visible_lights[lm->visible_count++] = i;
+            if (lm->lights[i].slot >= 0) {
+                lm->visible_slots |= 1u << lm->lights[i].slot;
+            }
+        }
+    }
+}
+
+// Garder seulement les lumières dont le cercle d'influence coupe le champ de vue:
+// les deux demi-plans des rayons extrêmes (dir - plane, dir + plane) et la distance
+// de vue (far_distance <= 0 = illimitée). À appeler une fois par frame.
+int lighting_cull_view(LightManager* lm, float x, float y, float dir_x, float dir_y,
+                       float plane_x, float plane_y, float far_distance) {
+    // Normales intérieures des deux bords du champ de vue
+    float left_x = -(dir_y - plane_y), left_y = dir_x - plane_x;
+    float right_x = dir_y + plane_y, right_y = -(dir_x + plane_x);
+    if (left_x * dir_x + left_y * dir_y < 0) { left_x = -left_x; left_y = -left_y; }
+    if (right_x * dir_x + right_y * dir_y < 0) { right_x = -right_x; right_y = -right_y; }
+    float left_len = sqrtf(left_x * left_x + left_y * left_y);
+    float right_len = sqrtf(right_x * right_x + right_y * right_y);
+    float dir_len = sqrtf(dir_x * dir_x + dir_y * dir_y);
+    
+    lm->visible_count = 0;
+    lm->visible_slots = 0;
+    for (int i = 0; i < lm->active_count; i++) {
+        int light_idx = lm->active_lights[i];
+        Light* light = &lm->lights[light_idx];
+        float reach = light->radius + LIGHT_CULL_MARGIN;
+        float dx = light->x - x;
+        float dy = light->y - y;
+        
+        if ((dx * left_x + dy * left_y) < -reach * left_len) continue;
+        if ((dx * right_x + dy * right_y) < -reach * right_len) continue;
+        // Profondeur le long de la direction de vue, comme perp_wall_dist
+        if (far_distance > 0.0f && (dx * dir_x + dy * dir_y) > (far_distance + reach) * dir_len) continue;
+        
+        lm->visible_lights[lm->visible_count++] = light_idx;
+        if (light->slot >= 0) {
+            lm->visible_slots |= 1u << light->slot;
+        }
+    }
+    return lm->visible_count;
+}
+
+void lighting_destroy(LightManager* lm) {
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        free(lm->lights[i].visibility);
+        lm->lights[i].visibility = NULL;
+    }
+    lighting_animated_free(lm);
+    free(lm->occluders);
+    free(lm->tile_lights);
+    lm->occluders = NULL;
+    lm->tile_lights = NULL;
+    lm->grid_width = 0;
+    lm->grid_height = 0;
+}
+
+// Le segment lumière -> point traverse-t-il une tile opaque? (DDA sur la grille,
+// ni la tile de départ ni celle d'arrivée ne bloquent)
+static int lighting_segment_clear(LightManager* lm, float from_x, float from_y, float to_x, float to_y) {
+    int map_x = (int)floorf(from_x);
+    int map_y = (int)floorf(from_y);
+    int end_x = (int)floorf(to_x);
+    int end_y = (int)floorf(to_y);
+    
+    float dx = to_x - from_x;
+    float dy = to_y - from_y;
+    int step_x = dx < 0 ? -1 : 1;
+    int step_y = dy < 0 ? -1 : 1;
+    float delta_x = dx == 0 ? 1e30f : fabsf(1.0f / dx);
+    float delta_y = dy == 0 ? 1e30f : fabsf(1.0f / dy);
+    float side_x = dx < 0 ? (from_x - map_x) * delta_x : (map_x + 1.0f - from_x) * delta_x;
+    float side_y = dy < 0 ? (from_y - map_y) * delta_y : (map_y + 1.0f - from_y) * delta_y;
+    
+    // Nombre exact de tiles traversées: la boucle se termine même aux arrondis près
+    int steps = abs(end_x - map_x) + abs(end_y - map_y);
+    for (int i = 1; i < steps; i++) {
+        if (side_x < side_y) {
+            side_x += delta_x;
+            map_x += step_x;
+        } else {
+            side_y += delta_y;
+            map_y += step_y;
+        }
+        if (map_x < 0 || map_x >= lm->grid_width || map_y < 0 || map_y >= lm->grid_height) return 0;
+        if (lm->occluders[map_y * lm->grid_width + map_x]) return 0;
+    }
+    return 1;
+}
+
+// Précalculer la visibilité d'une lumière sur les tiles de son rayon: fraction des
+// points de la tile (centre + coins) que la lumière atteint sans traverser de mur
+void lighting_compute_visibility(LightManager* lm, int index) {
+    static const float sample_offsets[LIGHT_VISIBILITY_SAMPLES][2] = {
+        {0.5f, 0.5f}, {0.15f, 0.15f}, {0.85f, 0.15f}, {0.15f, 0.85f}, {0.85f, 0.85f}
+    };
+    
+    Light* light = &lm->lights[index];
+    free(light->visibility);
+    light->visibility = NULL;
+    if (!lm->occluders) return;
+    
+    int x0 = (int)floorf(light->x - light->radius);
+    int y0 = (int)floorf(light->y - light->radius);
+    int x1 = (int)floorf(light->x + light->radius);
+    int y1 = (int)floorf(light->y + light->radius);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= lm->grid_width) x1 = lm->grid_width - 1;
+    if (y1 >= lm->grid_height) y1 = lm->grid_height - 1;
+    if (x1 < x0 || y1 < y0) return;
+    
+    int w = x1 - x0 + 1;
+    int h = y1 - y0 + 1;
+    light->visibility = malloc(w * h);
+    if (!light->visibility) {
+        printf("Erreur allocation visibilité de la lumière %d\n", index);
+        return;
+    }
+    light->vis_x = x0;
+    light->vis_y = y0;
+    light->vis_w = w;
+    light->vis_h = h;
+    
+    for (int ty = y0; ty <= y1; ty++) {
+        for (int tx = x0; tx <= x1; tx++) {
+            Uint8* out = &light->visibility[(ty - y0) * w + (tx - x0)];
+            // Les murs sont éclairés via la tile devant leur face
+            if (lm->occluders[ty * lm->grid_width + tx]) {
+                *out = 0;
+                continue;
+            }
+            int clear = 0;
+            for (int s = 0; s < LIGHT_VISIBILITY_SAMPLES; s++) {
+                clear += lighting_segment_clear(lm, light->x, light->y,
+                                                tx + sample_offsets[s][0], ty + sample_offsets[s][1]);
+            }
+            *out = (Uint8)(clear * 255 / LIGHT_VISIBILITY_SAMPLES);
+        }
+    }
+}
+
+// Retirer le bit d'une lumière de toutes les tiles de son ancienne zone
+static void lighting_area_clear(LightManager* lm, Light* light) {
+    if (lm->tile_lights && light->slot >= 0 && light->area_x0 >= 0) {
+        Uint32 keep = ~(1u << light->slot);
+        for (int y = light->area_y0; y <= light->area_y1; y++) {
+            Uint32* row = lm->tile_lights + y * lm->grid_width;
+            for (int x = light->area_x0; x <= light->area_x1; x++) {
+                row[x] &= keep;
+            }
+        }
+    }
+    light->area_x0 = light->area_y0 = light->area_x1 = light->area_y1 = -1;
+}
+
+// Inscrire une lumière sur les tiles qu'elle peut éclairer. La zone est prudente: les
+// points d'un mur sont lus sur la tile devant la face mais peuvent être jusqu'à une
+// tile plus loin, d'où la marge d'une tile autour de chaque tile testée.
+static void lighting_area_add(LightManager* lm, Light* light) {
+    if (!lm->tile_lights || light->slot < 0 || !light->active) return;
+    
+    int x0 = (int)floorf(light->x - light->radius) - 1;
+    int y0 = (int)floorf(light->y - light->radius) - 1;
+    int x1 = (int)floorf(light->x + light->radius) + 1;
+    int y1 = (int)floorf(light->y + light->radius) + 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= lm->grid_width) x1 = lm->grid_width - 1;
+    if (y1 >= lm->grid_height) y1 = lm->grid_height - 1;
+    if (x1 < x0 || y1 < y0) return;
+    
+    Uint32 bit = 1u << light->slot;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            if (light->visibility) {
+                int vx = x - light->vis_x;
+                int vy = y - light->vis_y;
+                if (vx < 0 || vx >= light->vis_w || vy < 0 || vy >= light->vis_h) continue;
+                if (light->visibility[vy * light->vis_w + vx] == 0) continue;
+            }
+            // Point le plus proche de la tile élargie d'une tile
+            float nx = light->x < x - 1 ? x - 1 : (light->x > x + 2 ? x + 2 : light->x);
+            float ny = light->y < y - 1 ? y - 1 : (light->y > y + 2 ? y + 2 : light->y);
+            float dx = nx - light->x;
+            float dy = ny - light->y;
+            if (dx * dx + dy * dy > light->radius_squared) continue;
+            lm->tile_lights[y * lm->grid_width + x] |= bit;
+        }
+    }
+    light->area_x0 = x0;
+    light->area_y0 = y0;
+    light->area_x1 = x1;
+    light->area_y1 = y1;
+}
+
+// Une lumière a changé: retirer son ancienne zone, recalculer sa visibilité et inscrire
+// la nouvelle zone. Le coût est proportionnel à la surface couverte par la lumière.
+void lighting_refresh_light(LightManager* lm, int index) {
+    Light* light = &lm->lights[index];
+    lighting_area_clear(lm, light);
+    lighting_compute_visibility(lm, index);
+    lighting_area_add(lm, light);
+    lighting_bake_basis(lm, index);
+    lighting_touch(lm);
+}
+
+int lighting_set_occluders(LightManager* lm, const Uint8* solid, int width, int height) {
+    lighting_animated_free(lm);
+    if (!solid) {
+        free(lm->occluders);
+        free(lm->tile_lights);
+        lm->occluders = NULL;
+        lm->tile_lights = NULL;
+        lm->grid_width = 0;
+        lm->grid_height = 0;
+    } else {
+        Uint8* grid = realloc(lm->occluders, width * height);
+        if (grid) lm->occluders = grid;
+        Uint32* tile_lights = realloc(lm->tile_lights, width * height * sizeof(Uint32));
+        if (tile_lights) lm->tile_lights = tile_lights;
+        if (!grid || !tile_lights) {
+            printf("Erreur allocation grille d'ombres %dx%d\n", width, height);
+            lighting_set_occluders(lm, NULL, 0, 0);
+            return 0;
+        }
+        memcpy(grid, solid, width * height);
+        memset(tile_lights, 0, width * height * sizeof(Uint32));
+        lm->grid_width = width;
+        lm->grid_height = height;
+    }
+    
+    for (int i = 0; i < lm->count; i++) {
+        lm->lights[i].area_x0 = -1;
+        lighting_refresh_light(lm, i);
+    }
+    lighting_touch(lm);
+    return 1;
+}
+
+// Recopier une zone modifiée de la grille et ne recalculer que les lumières qui la couvrent.
+// solid ne contient que la zone [x0, x1] x [y0, y1], ligne par ligne
+void lighting_update_occluders(LightManager* lm, const Uint8* solid, int x0, int y0, int x1, int y1) {
+    if (!lm->occluders) return;
+    int solid_x0 = x0;
+    int solid_y0 = y0;
+    int stride = x1 - x0 + 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= lm->grid_width) x1 = lm->grid_width - 1;
+    if (y1 >= lm->grid_height) y1 = lm->grid_height - 1;
+    if (x1 < x0 || y1 < y0) return;
+    
+    for (int y = y0; y <= y1; y++) {
+        memcpy(lm->occluders + y * lm->grid_width + x0, solid + (y - solid_y0) * stride + (x0 - solid_x0), x1 - x0 + 1);
+    }
+    
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (light->visibility &&
+            (x1 < light->vis_x || x0 >= light->vis_x + light->vis_w ||
+             y1 < light->vis_y || y0 >= light->vis_y + light->vis_h)) {
+            continue;
+        }
+        lighting_refresh_light(lm, i);
+    }
+}
+
+// Courbe, fréquence et profondeur par défaut de chaque animation
+static const struct {
+    const char* name;
+    float rate;
+    float depth;
+} lighting_animations[LIGHT_ANIM_COUNT] = {
+    { "none", 0.0f, 0.0f },
+    { "flicker", 8.0f, 0.4f },
+    { "pulse", 1.0f, 0.8f },
+    { "strobe", 2.0f, 1.0f }
+};
+
+const char* lighting_animation_name(int animation) {
+    if (animation < 0 || animation >= LIGHT_ANIM_COUNT) return "none";
+    return lighting_animations[animation].name;
+}
+
+int lighting_parse_animation(const char* name) {
+    for (int i = 0; i < LIGHT_ANIM_COUNT; i++) {
+        if (strcmp(name, lighting_animations[i].name) == 0) return i;
+    }
+    return -1;
+}
+
+// Slots des lumières lues dans la somme des lumières animées (retirés du calcul direct)
+static void lighting_animated_slots(LightManager* lm) {
+    lm->animated_slots = 0;
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (light->active && light->basis && light->slot >= 0) {
+            lm->animated_slots |= 1u << light->slot;
+        }
+    }
+}
+
+static void lighting_animated_free(LightManager* lm) {
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        free(lm->lights[i].basis);
+        lm->lights[i].basis = NULL;
+    }
+    if (lm->animated) {
+        for (int i = 0; i < lm->anim_blocks_x * lm->anim_blocks_y; i++) {
+            free(lm->animated[i]);
+        }
+    }
+    free(lm->animated);
+    lm->animated = NULL;
+    lm->anim_blocks_x = 0;
+    lm->anim_blocks_y = 0;
+    lm->cells_width = 0;
+    lm->cells_height = 0;
+    lm->animated_slots = 0;
+    lm->animated_deltas = 0;
+}
+
+// out[i] += k * basis[i], 4 cellules à la fois en SSE2 (même résultat que la boucle scalaire)
+static void lighting_madd_row(float* out, const float* basis, float k, int count) {
+    int i = 0;
+#ifdef __SSE2__
+    __m128 factor = _mm_set1_ps(k);
+    for (; i + 4 <= count; i += 4) {
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(factor, _mm_loadu_ps(basis + i)));
+        _mm_storeu_ps(out + i, sum);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] += k * basis[i];
+    }
+}
+
+// Cellule (x, y) du plan r de son bloc, NULL si le bloc n'est pas alloué. Les plans
+// g et b suivent à LIGHT_ANIM_BLOCK_CELLS² floats, les lignes à LIGHT_ANIM_BLOCK_CELLS
+static float* lighting_animated_cell(LightManager* lm, int x, int y) {
+    float* block = lm->animated[(y / LIGHT_ANIM_BLOCK_CELLS) * lm->anim_blocks_x + x / LIGHT_ANIM_BLOCK_CELLS];
+    if (!block) return NULL;
+    return block + (y % LIGHT_ANIM_BLOCK_CELLS) * LIGHT_ANIM_BLOCK_CELLS + x % LIGHT_ANIM_BLOCK_CELLS;
+}
+
+// Allouer les blocs qui couvrent les cellules [x0, x1) x [y0, y1) (déjà bornées à la grille)
+static int lighting_animated_reserve(LightManager* lm, int x0, int y0, int x1, int y1) {
+    for (int by = y0 / LIGHT_ANIM_BLOCK_CELLS; by <= (y1 - 1) / LIGHT_ANIM_BLOCK_CELLS; by++) {
+        for (int bx = x0 / LIGHT_ANIM_BLOCK_CELLS; bx <= (x1 - 1) / LIGHT_ANIM_BLOCK_CELLS; bx++) {
+            float** block = &lm->animated[by * lm->anim_blocks_x + bx];
+            if (*block) continue;
+            *block = calloc(3 * LIGHT_ANIM_BLOCK_CELLS * LIGHT_ANIM_BLOCK_CELLS, sizeof(float));
+            if (!*block) {
+                printf("Erreur allocation bloc d'éclairage animé (%d, %d)\n", bx, by);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// somme[x0, x1) += k x basis sur la ligne y, découpée aux bords des blocs
+static void lighting_animated_madd_row(LightManager* lm, int x0, int x1, int y, const float* basis, const float factor[3]) {
+    while (x0 < x1) {
+        int end = (x0 / LIGHT_ANIM_BLOCK_CELLS + 1) * LIGHT_ANIM_BLOCK_CELLS;
+        if (end > x1) end = x1;
+        float* cell = lighting_animated_cell(lm, x0, y);
+        if (cell) {
+            for (int c = 0; c < 3; c++) {
+                lighting_madd_row(cell + c * LIGHT_ANIM_BLOCK_CELLS * LIGHT_ANIM_BLOCK_CELLS, basis, factor[c], end - x0);
+            }
+        }
+        basis += end - x0;
+        x0 = end;
+    }
+}
+
+// Recalculer la somme des lumières animées sur les cellules [x0, x1) x [y0, y1):
+// remise à zéro puis basis x intensité courante de chaque lumière qui les couvre
+static void lighting_animated_region(LightManager* lm, int x0, int y0, int x1, int y1) {
+    if (!lm->animated) return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > lm->cells_width) x1 = lm->cells_width;
+    if (y1 > lm->cells_height) y1 = lm->cells_height;
+    if (x1 <= x0 || y1 <= y0) return;
+    
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; ) {
+            int end = (x / LIGHT_ANIM_BLOCK_CELLS + 1) * LIGHT_ANIM_BLOCK_CELLS;
+            if (end > x1) end = x1;
+            float* cell = lighting_animated_cell(lm, x, y);
+            if (cell) {
+                for (int c = 0; c < 3; c++) {
+                    memset(cell + c * LIGHT_ANIM_BLOCK_CELLS * LIGHT_ANIM_BLOCK_CELLS, 0, (end - x) * sizeof(float));
+                }
+            }
+            x = end;
+        }
+    }
+    
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (!light->active || !light->basis) continue;
+        int lx0 = light->basis_x > x0 ? light->basis_x : x0;
+        int ly0 = light->basis_y > y0 ? light->basis_y : y0;
+        int lx1 = light->basis_x + light->basis_w < x1 ? light->basis_x + light->basis_w : x1;
+        int ly1 = light->basis_y + light->basis_h < y1 ? light->basis_y + light->basis_h : y1;
+        if (lx1 <= lx0 || ly1 <= ly0) continue;
+        
+        float intensity = light->intensity * light->anim_scale;
+        float factor[3] = { light->r * intensity, light->g * intensity, light->b * intensity };
+        for (int y = ly0; y < ly1; y++) {
+            const float* basis = light->basis + (y - light->basis_y) * light->basis_w + (lx0 - light->basis_x);
+            lighting_animated_madd_row(lm, lx0, lx1, y, basis, factor);
+        }
+    }
+}
+
+// Changement d'intensité d'une lumière animée: seule la différence est ajoutée,
+// (nouveau - ancien facteur) x intensité x couleur x basis sur sa zone
+static void lighting_animated_delta(LightManager* lm, const Light* light, float old_scale) {
+    int x0 = light->basis_x > 0 ? light->basis_x : 0;
+    int y0 = light->basis_y > 0 ? light->basis_y : 0;
+    int x1 = light->basis_x + light->basis_w < lm->cells_width ? light->basis_x + light->basis_w : lm->cells_width;
+    int y1 = light->basis_y + light->basis_h < lm->cells_height ? light->basis_y + light->basis_h : lm->cells_height;
+    if (x1 <= x0 || y1 <= y0) return;
+    
+    float delta = light->intensity * (light->anim_scale - old_scale);
+    float factor[3] = { light->r * delta, light->g * delta, light->b * delta };
+    for (int y = y0; y < y1; y++) {
+        const float* basis = light->basis + (y - light->basis_y) * light->basis_w + (x0 - light->basis_x);
+        lighting_animated_madd_row(lm, x0, x1, y, basis, factor);
+    }
+}
+
+// Somme complète sur la zone de chaque lumière animée: efface l'erreur d'arrondi
+// accumulée par les différences successives
+static void lighting_animated_rebuild(LightManager* lm) {
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (!light->active || !light->basis) continue;
+        lighting_animated_region(lm, light->basis_x, light->basis_y,
+                                 light->basis_x + light->basis_w, light->basis_y + light->basis_h);
+    }
+    lm->animated_deltas = 0;
+}
+
+// Précalculer la contribution d'une lumière animée à intensité 1 sur les cellules des
+// tiles de sa visibilité (même atténuation, seuil et ombres que le calcul direct),
+// puis recalculer la somme sur son ancienne et sa nouvelle zone
+static void lighting_bake_basis(LightManager* lm, int index) {
+    Light* light = &lm->lights[index];
+    int had_basis = light->basis != NULL;
+    int old_x0 = light->basis_x, old_y0 = light->basis_y;
+    int old_x1 = old_x0 + light->basis_w, old_y1 = old_y0 + light->basis_h;
+    free(light->basis);
+    light->basis = NULL;
+    
+    // Sans grille (ni visibilité), la lumière reste calculée directement
+    if (light->active && light->animation != LIGHT_ANIM_NONE && light->visibility) {
+        if (!lm->animated) {
+            lm->anim_blocks_x = (lm->grid_width + LIGHT_ANIM_BLOCK - 1) / LIGHT_ANIM_BLOCK;
+            lm->anim_blocks_y = (lm->grid_height + LIGHT_ANIM_BLOCK - 1) / LIGHT_ANIM_BLOCK;
+            lm->animated = calloc(lm->anim_blocks_x * lm->anim_blocks_y, sizeof(float*));
+            if (lm->animated) {
+                lm->cells_width = lm->grid_width * LIGHT_BASIS_RES;
+                lm->cells_height = lm->grid_height * LIGHT_BASIS_RES;
+            } else {
+                printf("Erreur allocation éclairage animé %dx%d blocs\n", lm->anim_blocks_x, lm->anim_blocks_y);
+                lm->anim_blocks_x = 0;
+                lm->anim_blocks_y = 0;
+            }
+        }
+        int w = light->vis_w * LIGHT_BASIS_RES;
+        int h = light->vis_h * LIGHT_BASIS_RES;
+        light->basis = lm->animated ? malloc(w * h * sizeof(float)) : NULL;
+        if (light->basis) {
+            light->basis_x = light->vis_x * LIGHT_BASIS_RES;
+            light->basis_y = light->vis_y * LIGHT_BASIS_RES;
+            light->basis_w = w;
+            light->basis_h = h;
+            for (int cy = 0; cy < h; cy++) {
+                for (int cx = 0; cx < w; cx++) {
+                    int visible = light->visibility[(cy / LIGHT_BASIS_RES) * light->vis_w + cx / LIGHT_BASIS_RES];
+                    float world_x = (light->basis_x + cx + 0.5f) / LIGHT_BASIS_RES;
+                    float world_y = (light->basis_y + cy + 0.5f) / LIGHT_BASIS_RES;
+                    float dx = world_x - light->x;
+                    float dy = world_y - light->y;
+                    float attenuation = lighting_calculate_distance_attenuation_fast(dx * dx + dy * dy,
+                                                                                     light->radius_squared);
+                    float value = 0.0f;
+                    if (visible > 0 && attenuation >= MIN_LIGHT_CONTRIBUTION) {
+                        value = attenuation * (visible * (1.0f / 255.0f));
+                    }
+                    light->basis[cy * w + cx] = value;
+                }
+            }
+            
+            // Blocs de la somme sous sa zone; faute de mémoire, elle reste calculée directement
+            int x0 = light->basis_x > 0 ? light->basis_x : 0;
+            int y0 = light->basis_y > 0 ? light->basis_y : 0;
+            int x1 = light->basis_x + w < lm->cells_width ? light->basis_x + w : lm->cells_width;
+            int y1 = light->basis_y + h < lm->cells_height ? light->basis_y + h : lm->cells_height;
+            if (x1 > x0 && y1 > y0 && !lighting_animated_reserve(lm, x0, y0, x1, y1)) {
+                free(light->basis);
+                light->basis = NULL;
+            }
+        }
+    }
+    
+    if (had_basis) {
+        lighting_animated_region(lm, old_x0, old_y0, old_x1, old_y1);
+    }
+    if (light->basis) {
+        lighting_animated_region(lm, light->basis_x, light->basis_y,
+                                 light->basis_x + light->basis_w, light->basis_y + light->basis_h);
+    }
+    lighting_animated_slots(lm);
+}
+
+void lighting_set_animation(LightManager* lm, int index, int animation, float rate, float depth) {
+    if (index < 0 || index >= lm->count) return;
+    if (animation < 0 || animation >= LIGHT_ANIM_COUNT) animation = LIGHT_ANIM_NONE;
+    
+    // Fréquence <= 0 ou profondeur < 0: valeurs par défaut de la courbe
+    Light* light = &lm->lights[index];
+    light->animation = animation;
+    light->anim_rate = rate > 0.0f ? rate : lighting_animations[animation].rate;
+    light->anim_depth = depth >= 0.0f ? (depth < 1.0f ? depth : 1.0f) : lighting_animations[animation].depth;
+    light->anim_scale = 1.0f;
+    lighting_bake_basis(lm, index);
+    lighting_touch(lm);
+}
+
+// Bruit lissé dans [0, 1): valeurs pseudo-aléatoires aux entiers, interpolées
+static float lighting_noise(double t, Uint32 seed) {
+    double cell = floor(t);
+    float f = (float)(t - cell);
+    Uint32 i = (Uint32)(Sint64)cell;
+    Uint32 a = (i * 2654435761u) ^ (seed * 40503u);
+    Uint32 b = ((i + 1) * 2654435761u) ^ (seed * 40503u);
+    a ^= a >> 15; a *= 2246822519u; a ^= a >> 13;
+    b ^= b >> 15; b *= 2246822519u; b ^= b >> 13;
+    float va = (a >> 8) * (1.0f / 16777216.0f);
+    float vb = (b >> 8) * (1.0f / 16777216.0f);
+    float smooth = f * f * (3.0f - 2.0f * f);
+    return va + (vb - va) * smooth;
+}
+
+// Baisse de l'intensité d'une lumière à l'instant time (0 = pleine intensité, 1 = éteinte
+// à profondeur 1). Le déphasage dépend de la position: deux torches ne battent pas ensemble
+static float lighting_animation_dip(const Light* light, double time) {
+    double phase = fmod(light->x * 0.37 + light->y * 0.61, 1.0);
+    double t = time * light->anim_rate + phase;
+    switch (light->animation) {
+        case LIGHT_ANIM_FLICKER:
+            return lighting_noise(t, (Uint32)(light->x * 64.0f) * 31u + (Uint32)(light->y * 64.0f));
+        case LIGHT_ANIM_PULSE:
+            return (float)(0.5 - 0.5 * cos(2.0 * M_PI * t));
+        case LIGHT_ANIM_STROBE:
+            return t - floor(t) < 0.5 ? 0.0f : 1.0f;
+        default:
+            return 0.0f;
+    }
+}
+
+// Avancer les animations: seules les lumières dont le niveau (LIGHT_ANIM_LEVELS) change
+// sont retouchées, par multiplication-addition de la différence de leur basis sur leur zone
+int lighting_animate(LightManager* lm, double time) {
+    int touched = 0;
+    int direct = 0;
+    int deltas = 0;
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (!light->active || light->animation == LIGHT_ANIM_NONE) continue;
+        
+        float dip = lighting_animation_dip(light, time);
+        float level = floorf(dip * (LIGHT_ANIM_LEVELS - 1) + 0.5f) / (LIGHT_ANIM_LEVELS - 1);
+        float scale = 1.0f - light->anim_depth * level;
+        if (scale == light->anim_scale) continue;
+        float old_scale = light->anim_scale;
+        light->anim_scale = scale;
+        touched++;
+        
+        if (light->basis) {
+            lighting_animated_delta(lm, light, old_scale);
+            deltas++;
+        } else {
+            direct = 1;
+        }
+    }
+    lm->animated_deltas += deltas;
+    if (deltas > 0 && lm->animated_deltas >= LIGHT_ANIM_REBUILD) {
+        lighting_animated_rebuild(lm);
+    }
+    // Lumières animées sans basis (hors grille): calculées directement, les caches
+    // dérivés doivent être vidés
+    if (direct) {
+        lighting_touch(lm);
+    }
+    return touched;
+}
+
+// Version ultra-optimisée de l'atténuation
+float lighting_calculate_distance_attenuation_fast(float distance_squared, float radius_squared) {
+    if (distance_squared > radius_squared) return 0.0f;
+    
+    // Atténuation linéaire simple (plus rapide que quadratique)
+    float distance = sqrtf(distance_squared);
+    float radius = sqrtf(radius_squared);
+    float attenuation = 1.0f - (distance / radius);
+    
+    // Courbe simple pour adoucir
+    return attenuation * attenuation;
+}
+
+// Version optimisée de l'application de lumière
+Uint32 lighting_apply_light_to_color_fast(Uint32 base_color, float light_r, float light_g, float light_b, float intensity) {
+    // Extraire les composantes (format RGBA8888)
+    Uint8 r = (base_color >> 24) & 0xFF;
+    Uint8 g = (base_color >> 16) & 0xFF;
+    Uint8 b = (base_color >> 8) & 0xFF;
+    Uint8 a = base_color & 0xFF;
+    
+    // Calculs en entiers pour plus de vitesse
+    int fr = (int)((r * light_r * intensity) + 0.5f);
+    int fg = (int)((g * light_g * intensity) + 0.5f);
+    int fb = (int)((b * light_b * intensity) + 0.5f);
+    
+    // Clamping rapide
+    if (fr > 255) fr = 255;
+    if (fg > 255) fg = 255;
+    if (fb > 255) fb = 255;
+    
+    return ((Uint8)fr << 24) | ((Uint8)fg << 16) | ((Uint8)fb << 8) | a;
+}
+
+// Version ultra-optimisée du calcul d'éclairage
+void lighting_calculate_light_fast(LightManager* lm, float world_x, float world_y,
+                                   float* out_r, float* out_g, float* out_b) {
+    lighting_calculate_light_tile(lm, world_x, world_y, (int)world_x, (int)world_y, out_r, out_g, out_b);
+}
+
+// Ajouter la contribution d'une lumière en un point (visibilité lue sur tile_x, tile_y)
+static inline void lighting_accumulate(Light* light, float world_x, float world_y, int tile_x, int tile_y,
+                                       float* total_r, float* total_g, float* total_b) {
+    // Calculer la distance au carré (éviter sqrt)
+    float dx = world_x - light->x;
+    float dy = world_y - light->y;
+    float distance_squared = dx * dx + dy * dy;
+    
+    // Test rapide de distance
+    if (distance_squared > light->radius_squared) return;
+    
+    // Ombres: visibilité précalculée de la tile
+    int visible = 255;
+    if (light->visibility) {
+        int vx = tile_x - light->vis_x;
+        int vy = tile_y - light->vis_y;
+        if (vx < 0 || vx >= light->vis_w || vy < 0 || vy >= light->vis_h) return;
+        visible = light->visibility[vy * light->vis_w + vx];
+        if (visible == 0) return;
+    }
+    
+    // Calculer l'atténuation optimisée
+    float attenuation = lighting_calculate_distance_attenuation_fast(distance_squared, light->radius_squared);
+    
+    // Ignorer les contributions négligeables
+    if (attenuation < MIN_LIGHT_CONTRIBUTION) return;
+    
+    // Ajouter la contribution de cette lumière
+    float contribution = light->intensity * light->anim_scale * attenuation;
+    if (visible < 255) {
+        contribution *= visible * (1.0f / 255.0f);
+    }
+    *total_r += light->r * contribution;
+    *total_g += light->g * contribution;
+    *total_b += light->b * contribution;
+}
+
+// Même calcul, la visibilité étant lue sur une tile donnée (tile devant une face de mur)
+void lighting_calculate_light_tile(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                                   float* out_r, float* out_g, float* out_b) {
+    lighting_calculate_static_tile(lm, world_x, world_y, tile_x, tile_y, out_r, out_g, out_b);
+    lighting_add_animated(lm, world_x, world_y, tile_x, tile_y, out_r, out_g, out_b);
+}
+
+// Ambiante et lumières calculées directement (toutes sauf celles lues dans lm->animated)
+void lighting_calculate_static_tile(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                                    float* out_r, float* out_g, float* out_b) {
+    // Commencer avec la lumière ambiante
+    float total_r = lm->ambient_r * lm->ambient_intensity;
+    float total_g = lm->ambient_g * lm->ambient_intensity;
+    float total_b = lm->ambient_b * lm->ambient_intensity;
+    
+    if (lm->tile_lights && tile_x >= 0 && tile_x < lm->grid_width && tile_y >= 0 && tile_y < lm->grid_height) {
+        // Seulement les lumières visibles dont la zone d'effet couvre cette tile
+        Uint32 mask = lm->tile_lights[tile_y * lm->grid_width + tile_x] & lm->visible_slots & ~lm->animated_slots;
+        for (int slot = 0; mask; slot++, mask >>= 1) {
+            if (mask & 1) {
+                lighting_accumulate(&lm->lights[lm->slot_light[slot]], world_x, world_y, tile_x, tile_y,
+                                    &total_r, &total_g, &total_b);
+            }
+        }
+    } else {
+        // Traiter seulement les lumières visibles de la frame (cache optimisé); hors de la
+        // grille, les lumières animées n'ont pas de cellules et sont calculées ici
+        for (int i = 0; i < lm->visible_count; i++) {
+            lighting_accumulate(&lm->lights[lm->visible_lights[i]], world_x, world_y, tile_x, tile_y,
+                                &total_r, &total_g, &total_b);
+        }
+    }
+    
+    *out_r = total_r;
+    *out_g = total_g;
+    *out_b = total_b;
+}
+
+// Lumières animées: interpolation bilinéaire entre les centres des cellules, limitée
+// aux cellules de la tile (les ombres restent nettes au bord des tiles)
+void lighting_add_animated(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                           float* inout_r, float* inout_g, float* inout_b) {
+    if (!lm->animated || !lm->animated_slots) return;
+    if (tile_x < 0 || tile_x >= lm->grid_width || tile_y < 0 || tile_y >= lm->grid_height) return;
+    
+    float lo_x = (float)(tile_x * LIGHT_BASIS_RES);
+    float lo_y = (float)(tile_y * LIGHT_BASIS_RES);
+    float hi_x = lo_x + (LIGHT_BASIS_RES - 1);
+    float hi_y = lo_y + (LIGHT_BASIS_RES - 1);
+    float cx = world_x * LIGHT_BASIS_RES - 0.5f;
+    float cy = world_y * LIGHT_BASIS_RES - 0.5f;
+    cx = cx < lo_x ? lo_x : (cx > hi_x ? hi_x : cx);
+    cy = cy < lo_y ? lo_y : (cy > hi_y ? hi_y : cy);
+    int x0 = (int)cx < (int)hi_x ? (int)cx : (int)hi_x - 1;
+    int y0 = (int)cy < (int)hi_y ? (int)cy : (int)hi_y - 1;
+    float fx = cx - x0;
+    float fy = cy - y0;
+    
+    // La tile tient dans un bloc: ses 4 cellules voisines aussi
+    const float* cell = lighting_animated_cell(lm, x0, y0);
+    if (!cell) return;
+    float* out[3] = { inout_r, inout_g, inout_b };
+    for (int c = 0; c < 3; c++, cell += LIGHT_ANIM_BLOCK_CELLS * LIGHT_ANIM_BLOCK_CELLS) {
+        float top = cell[0] + (cell[1] - cell[0]) * fx;
+        float bottom = cell[LIGHT_ANIM_BLOCK_CELLS] + (cell[LIGHT_ANIM_BLOCK_CELLS + 1] - cell[LIGHT_ANIM_BLOCK_CELLS]) * fx;
+        *out[c] += top + (bottom - top) * fy;
+    }
+}
+
+void lighting_calculate_pixel_color_fast(LightManager* lm, float world_x, float world_y, 
+                                        Uint32 base_color, Uint32* output_color) {
+    float total_r, total_g, total_b;
+    lighting_calculate_light_fast(lm, world_x, world_y, &total_r, &total_g, &total_b);
+    
+    // Appliquer l'éclairage final
+    *output_color = lighting_apply_light_to_color_fast(base_color, total_r, total_g, total_b, 1.0f);
+}
+
+void lighting_set_ambient(LightManager* lm, float r, float g, float b, float intensity) {
+    lm->ambient_r = r;
+    lm->ambient_g = g;
+    lm->ambient_b = b;
+    lm->ambient_intensity = intensity;
+    lighting_touch(lm);
+}
+
+Light* lighting_get_light(LightManager* lm, int index) {
+    if (index < 0 || index >= lm->count) return NULL;
+    return &lm->lights[index];
+}
+
+int lighting_save_to_file(LightManager* lm, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        printf("Erreur: impossible d'ouvrir %s pour écriture\n", filename);
+        return 0;
+    }
+    
+    // Sauvegarder la lumière ambiante
+    fprintf(file, "AMBIENT %.2f %.2f %.2f %.2f\n", 
+            lm->ambient_r, lm->ambient_g, lm->ambient_b, lm->ambient_intensity);
+    
+    // Sauvegarder le nombre de lumières
+    fprintf(file, "LIGHTS %d\n", lm->count);
+    
+    // Sauvegarder chaque lumière
+    for (int i = 0; i < lm->count; i++) {
+        Light* light = &lm->lights[i];
+        if (light->active) {
+            fprintf(file, "LIGHT %.2f %.2f %.2f %.2f %.2f %.2f %.2f",
+                    light->x, light->y, light->r, light->g, light->b, 
+                    light->intensity, light->radius);
+            // Animation optionnelle en fin de ligne (ignorée par les anciennes versions)
+            if (light->animation != LIGHT_ANIM_NONE) {
+                fprintf(file, " %s %.2f %.2f", lighting_animation_name(light->animation),
+                        light->anim_rate, light->anim_depth);
+            }
+            fprintf(file, "\n");
+        }
+    }
+    
+    fclose(file);
+    printf("Données d'éclairage sauvegardées dans %s\n", filename);
+    return 1;
+}
+
+int lighting_load_from_file(LightManager* lm, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Aucun fichier d'éclairage trouvé: %s\n", filename);
+        return 0;
+    }
+    
+    lighting_init(lm); // Réinitialiser (les occulteurs sont à reposer après le chargement)
+    
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "AMBIENT", 7) == 0) {
+            float r, g, b, intensity;
+            if (sscanf(line, "AMBIENT %f %f %f %f", &r, &g, &b, &intensity) == 4) {
+                lighting_set_ambient(lm, r, g, b, intensity);
+            }
+        } else if (strncmp(line, "LIGHTS", 6) == 0) {
+            int count;
+            sscanf(line, "LIGHTS %d", &count);
+        } else if (strncmp(line, "LIGHT", 5) == 0) {
+            float x, y, r, g, b, intensity, radius;
+            int end = 0;
+            if (sscanf(line, "LIGHT %f %f %f %f %f %f %f%n", 
+                      &x, &y, &r, &g, &b, &intensity, &radius, &end) == 7) {
+                int index = lighting_add_light(lm, x, y, r, g, b, intensity, radius);
+                
+                // Animation: "LIGHT ... flicker 8.00 0.40"
+                char name[16];
+                float rate = 0.0f, depth = -1.0f;
+                if (index >= 0 && sscanf(line + end, "%15s %f %f", name, &rate, &depth) >= 1) {
+                    int animation = lighting_parse_animation(name);
+                    if (animation > LIGHT_ANIM_NONE) {
+                        lighting_set_animation(lm, index, animation, rate, depth);
+                    }
+                }
+            }
+        }
+    }
+    
+    fclose(file);
+    printf("Données d'éclairage chargées depuis %s (%d lumières)\n", filename, lm->count);
+    return 1;
 }
\ No newline at end of file
@@ -1,51 +1,146 @@
-#ifndef LIGHTING_H
-#define LIGHTING_H
-
-#include <SDL2/SDL.h>
-
-#define MAX_LIGHTS 32
-#define LIGHT_SAMPLES 4  // Réduire l'échantillonnage pour performance
-#define MIN_LIGHT_CONTRIBUTION 0.05f  // Seuil plus élevé pour ignorer les faibles lumières
-
-typedef struct {
-    float x, y;           // Position mondiale
-    float r, g, b;        // Couleur RGB (0.0 - 1.0)
-    float intensity;      // Intensité (0.0 - 10.0+)
-    float radius;         // Rayon d'influence
-    float radius_squared; // Rayon au carré (optimisation)
-    int active;           // 1 si active, 0 sinon
-} Light;
-
-typedef struct {
-    Light lights[MAX_LIGHTS];
-    int count;
-    float ambient_r, ambient_g, ambient_b;  // Lumière ambiante
-    float ambient_intensity;
-    
-    // Cache d'optimisation
-    int active_lights[MAX_LIGHTS];  // Indices des lumières actives seulement
-    int active_count;               // Nombre de lumières actives
-} LightManager;
-
-// Fonctions principales
-void lighting_init(LightManager* lm);
-int lighting_add_light(LightManager* lm, float x, float y, float r, float g, float b, float intensity, float radius);
-void lighting_remove_light(LightManager* lm, int index);
-void lighting_clear_all(LightManager* lm);
-void lighting_update_cache(LightManager* lm);
-
-// Calculs d'éclairage optimisés
-void lighting_calculate_pixel_color_fast(LightManager* lm, float world_x, float world_y, 
-                                         Uint32 base_color, Uint32* output_color);
-float lighting_calculate_distance_attenuation_fast(float distance_squared, float radius_squared);
-Uint32 lighting_apply_light_to_color_fast(Uint32 base_color, float light_r, float light_g, float light_b, float intensity);
-
-// Sauvegarde/Chargement
-int lighting_save_to_file(LightManager* lm, const char* filename);
-int lighting_load_from_file(LightManager* lm, const char* filename);
-
-// Utilitaires
-void lighting_set_ambient(LightManager* lm, float r, float g, float b, float intensity);
-Light* lighting_get_light(LightManager* lm, int index);
-
+#ifndef LIGHTING_H
+#define LIGHTING_H
+
+#include <SDL2/SDL.h>
+
+#define MAX_LIGHTS 32
+#define LIGHT_SAMPLES 4  // Réduire l'échantillonnage pour performance
+#define MIN_LIGHT_CONTRIBUTION 0.05f  // Seuil plus élevé pour ignorer les faibles lumières
+#define LIGHT_VISIBILITY_SAMPLES 5    // Points testés par tile (centre + 4 coins) pour les ombres
+#define LIGHT_CULL_MARGIN 1.0f        // Marge du culling (les points de mur peuvent déborder d'une tile)
+#define LIGHT_BASIS_RES 4             // Cellules par tile des contributions précalculées (lumières animées)
+#define LIGHT_ANIM_LEVELS 64          // Niveaux d'intensité d'une animation (en deçà, rien n'est retouché)
+#define LIGHT_ANIM_REBUILD 256        // Mises à jour par différence avant de tout resommer (dérive des flottants)
+#define LIGHT_ANIM_BLOCK 16           // Tiles par côté d'un bloc de la somme des lumières animées
+#define LIGHT_ANIM_BLOCK_CELLS (LIGHT_ANIM_BLOCK * LIGHT_BASIS_RES)
+
+// Courbes d'intensité des lumières animées
+enum {
+    LIGHT_ANIM_NONE = 0,
+    LIGHT_ANIM_FLICKER = 1,           // Scintillement aléatoire (torche)
+    LIGHT_ANIM_PULSE = 2,             // Pulsation sinusoïdale (alarme)
+    LIGHT_ANIM_STROBE = 3,            // Clignotement tout ou rien
+    LIGHT_ANIM_COUNT = 4
+};
+
+typedef struct {
+    float x, y;           // Position mondiale
+    float r, g, b;        // Couleur RGB (0.0 - 1.0)
+    float intensity;      // Intensité (0.0 - 10.0+)
+    float radius;         // Rayon d'influence
+    float radius_squared; // Rayon au carré (optimisation)
+    int active;           // 1 si active, 0 sinon
+    
+    // Visibilité depuis la lumière sur la grille (ombres), recalculée quand elle change.
+    // Une valeur 0-255 par tile de la zone couverte par le rayon, NULL sans occulteurs.
+    Uint8* visibility;
+    int vis_x, vis_y;     // Première tile de la zone
+    int vis_w, vis_h;
+    
+    // Zone d'effet inscrite dans tile_lights (bit 1 << slot), -1 si aucune
+    int slot;
+    int area_x0, area_y0, area_x1, area_y1;
+    
+    // Animation: intensité courante = intensity * anim_scale. La contribution de la
+    // lumière à intensité 1 (atténuation x ombres) est précalculée par cellule dans
+    // basis, une fois par changement de position ou d'occulteurs
+    int animation;        // LIGHT_ANIM_*
+    float anim_rate;      // Cycles par seconde (changements par seconde pour le scintillement)
+    float anim_depth;     // Baisse maximale de l'intensité (0 - 1)
+    float anim_scale;     // Facteur courant, 1 sans animation
+    float* basis;         // [basis_w * basis_h], NULL si statique ou sans grille
+    int basis_x, basis_y; // Première cellule
+    int basis_w, basis_h;
+} Light;
+
+typedef struct {
+    Light lights[MAX_LIGHTS];
+    int count;
+    float ambient_r, ambient_g, ambient_b;  // Lumière ambiante
+    float ambient_intensity;
+    
+    // Cache d'optimisation
+    int active_lights[MAX_LIGHTS];  // Indices des lumières actives seulement
+    int active_count;               // Nombre de lumières actives
+    
+    // Lumières visibles dans le champ de vue de la frame (lighting_cull_view)
+    int visible_lights[MAX_LIGHTS];
+    int visible_count;
+    Uint32 visible_slots;           // Mêmes lumières, en bits de slot (pour tile_lights)
+    
+    // Change à chaque modification de l'éclairage (unique entre managers): les caches
+    // dérivés (ex: éclairage des faces de murs) se vident quand elle change
+    Uint32 version;
+    
+    // Tiles qui bloquent la lumière (copie de LAYER_WALL), NULL = pas d'ombres
+    Uint8* occluders;
+    int grid_width, grid_height;
+    
+    // Lumières qui peuvent atteindre chaque tile (un bit par slot, MAX_LIGHTS <= 32).
+    // Mis à jour sur l'ancienne puis la nouvelle zone d'une lumière qui change.
+    Uint32* tile_lights;
+    int slot_light[MAX_LIGHTS];     // Slot -> indice de la lumière, -1 si libre
+    
+    // Lumières animées: somme des basis x intensité courante x couleur, par cellule
+    // (LIGHT_BASIS_RES x LIGHT_BASIS_RES par tile de la grille), en plans r, g, b.
+    // Une lumière dont le niveau change ajoute la différence sur sa zone; la somme est
+    // refaite toutes les LIGHT_ANIM_REBUILD différences. Ces lumières sont lues ici et
+    // retirées du calcul direct (animated_slots). Stockée par blocs de LIGHT_ANIM_BLOCK
+    // tiles alloués à la première lumière animée qui les couvre: une tile tient dans un bloc
+    float** animated;               // [anim_blocks_x * anim_blocks_y] blocs, NULL sans lumière animée
+                                    // Bloc: [3 * LIGHT_ANIM_BLOCK_CELLS²], NULL hors de toute zone animée
+    int anim_blocks_x, anim_blocks_y;
+    int cells_width, cells_height;
+    Uint32 animated_slots;
+    int animated_deltas;            // Différences ajoutées depuis la dernière somme complète
+} LightManager;
+
+// Fonctions principales
+void lighting_init(LightManager* lm);
+int lighting_add_light(LightManager* lm, float x, float y, float r, float g, float b, float intensity, float radius);
+void lighting_remove_light(LightManager* lm, int index);
+void lighting_set_light(LightManager* lm, int index, float x, float y, float r, float g, float b, float intensity, float radius);
+void lighting_clear_all(LightManager* lm);
+void lighting_update_cache(LightManager* lm);
+int lighting_cull_view(LightManager* lm, float x, float y, float dir_x, float dir_y,
+                       float plane_x, float plane_y, float far_distance);
+void lighting_destroy(LightManager* lm);
+
+// Ombres: grille des tiles opaques (1 = bloque), copiée par le LightManager
+int lighting_set_occluders(LightManager* lm, const Uint8* solid, int width, int height);
+// Zone [x0, x1] x [y0, y1] modifiée: solid ne contient que cette zone
+void lighting_update_occluders(LightManager* lm, const Uint8* solid, int x0, int y0, int x1, int y1);
+void lighting_compute_visibility(LightManager* lm, int index);
+void lighting_refresh_light(LightManager* lm, int index);
+
+// Animation de l'intensité (LIGHT_ANIM_NONE: lumière statique)
+void lighting_set_animation(LightManager* lm, int index, int animation, float rate, float depth);
+int lighting_animate(LightManager* lm, double time);    // Lumières retouchées
+const char* lighting_animation_name(int animation);
+int lighting_parse_animation(const char* name);          // -1 si inconnue
+
+// Calculs d'éclairage optimisés
+void lighting_calculate_light_fast(LightManager* lm, float world_x, float world_y,
+                                   float* out_r, float* out_g, float* out_b);
+void lighting_calculate_light_tile(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                                   float* out_r, float* out_g, float* out_b);
+// Mêmes calculs séparés: lumières statiques (ambiante comprise), stables d'une frame à
+// l'autre et donc cachables, et contribution des lumières animées à y ajouter
+void lighting_calculate_static_tile(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                                    float* out_r, float* out_g, float* out_b);
+void lighting_add_animated(LightManager* lm, float world_x, float world_y, int tile_x, int tile_y,
+                           float* inout_r, float* inout_g, float* inout_b);
+void lighting_calculate_pixel_color_fast(LightManager* lm, float world_x, float world_y, 
+                                         Uint32 base_color, Uint32* output_color);
+float lighting_calculate_distance_attenuation_fast(float distance_squared, float radius_squared);
+Uint32 lighting_apply_light_to_color_fast(Uint32 base_color, float light_r, float light_g, float light_b, float intensity);
+
+// Sauvegarde/Chargement
+int lighting_save_to_file(LightManager* lm, const char* filename);
+int lighting_load_from_file(LightManager* lm, const char* filename);
+
+// Utilitaires
+void lighting_set_ambient(LightManager* lm, float r, float g, float b, float intensity);
+Light* lighting_get_light(LightManager* lm, int index);
+
 #endif
\ No newline at end of file
@@ -1,7 +1,7 @@
-// config.h
-#ifndef CONFIG_H
-#define CONFIG_H
-
-#define TILE_SIZE 64
-
-#endif
+// config.h
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#define TILE_SIZE 64
+
+#endif
@@ -0,0 +1,370 @@
+#include "entities.h"
+#include "pvs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define ENTITIES_CAPACITY_MIN 64
+
+Entities* entities_create(int map_width, int map_height) {
+    Entities* e = calloc(1, sizeof(Entities));
+    if (!e) {
+        printf("Erreur allocation entités\n");
+        return NULL;
+    }
+    e->cells_x = (map_width + (1 << ENTITIES_CELL_SHIFT) - 1) >> ENTITIES_CELL_SHIFT;
+    e->cells_y = (map_height + (1 << ENTITIES_CELL_SHIFT) - 1) >> ENTITIES_CELL_SHIFT;
+    e->heads = malloc((e->cells_x * e->cells_y + 1) * sizeof(int));
+    if (!e->heads) {
+        printf("Erreur allocation grille des entités %dx%d\n", e->cells_x, e->cells_y);
+        free(e);
+        return NULL;
+    }
+    entities_clear(e);
+    return e;
+}
+
+void entities_destroy(Entities* e) {
+    if (!e) return;
+    free(e->x);
+    free(e->y);
+    free(e->size);
+    free(e->texture_id);
+    free(e->cell);
+    free(e->next);
+    free(e->depth);
+    free(e->view_x);
+    free(e->view_half);
+    free(e->visible);
+    free(e->order);
+    free(e->mark);
+    free(e->sort_keys);
+    free(e->heads);
+    free(e);
+}
+
+void entities_clear(Entities* e) {
+    e->count = 0;
+    e->max_size = 0.0f;
+    e->visible_count = 0;
+    e->order_count = 0;
+    e->resorted = 0;
+    for (int i = 0; i <= e->cells_x * e->cells_y; i++) {
+        e->heads[i] = -1;
+    }
+}
+
+// Agrandir toutes les colonnes d'un coup (capacité doublée)
+static int entities_grow(Entities* e) {
+    int capacity = e->capacity ? e->capacity * 2 : ENTITIES_CAPACITY_MIN;
+    if (capacity > ENTITIES_MAX) capacity = ENTITIES_MAX;
+    if (capacity <= e->capacity) return 0;
+
+#define ENTITIES_GROW(field) do { \
+        void* grown = realloc(e->field, capacity * sizeof(*e->field)); \
+        if (!grown) { printf("Erreur allocation de %d entités\n", capacity); return 0; } \
+        e->field = grown; \
+    } while (0)
+    ENTITIES_GROW(x);
+    ENTITIES_GROW(y);
+    ENTITIES_GROW(size);
+    ENTITIES_GROW(texture_id);
+    ENTITIES_GROW(cell);
+    ENTITIES_GROW(next);
+    ENTITIES_GROW(depth);
+    ENTITIES_GROW(view_x);
+    ENTITIES_GROW(view_half);
+    ENTITIES_GROW(visible);
+    ENTITIES_GROW(order);
+    ENTITIES_GROW(mark);
+    ENTITIES_GROW(sort_keys);
+#undef ENTITIES_GROW
+
+    memset(e->mark + e->capacity, 0, (capacity - e->capacity) * sizeof(Uint32));
+    e->capacity = capacity;
+    return 1;
+}
+
+// Cellule d'une position (la dernière pour les positions hors de la map)
+static int entities_cell_of(const Entities* e, float x, float y) {
+    if (x < 0.0f || y < 0.0f) return e->cells_x * e->cells_y;
+    int cx = (int)x >> ENTITIES_CELL_SHIFT;
+    int cy = (int)y >> ENTITIES_CELL_SHIFT;
+    if (cx >= e->cells_x || cy >= e->cells_y) return e->cells_x * e->cells_y;
+    return cy * e->cells_x + cx;
+}
+
+static void entities_link(Entities* e, int index, int cell) {
+    e->cell[index] = cell;
+    e->next[index] = e->heads[cell];
+    e->heads[cell] = index;
+}
+
+static void entities_unlink(Entities* e, int index) {
+    int* link = &e->heads[e->cell[index]];
+    while (*link != index) {
+        link = &e->next[*link];
+    }
+    *link = e->next[index];
+}
+
+int entities_add(Entities* e, float x, float y, int texture_id, float size) {
+    if (e->count >= e->capacity && !entities_grow(e)) {
+        return -1;
+    }
+    int index = e->count++;
+    e->x[index] = x;
+    e->y[index] = y;
+    e->size[index] = size;
+    e->texture_id[index] = texture_id;
+    e->mark[index] = 0;
+    if (size > e->max_size) e->max_size = size;
+    entities_link(e, index, entities_cell_of(e, x, y));
+    return index;
+}
+
+void entities_remove(Entities* e, int index) {
+    if (index < 0 || index >= e->count) return;
+    entities_unlink(e, index);
+
+    // La dernière entité prend la place libérée
+    int last = --e->count;
+    if (index != last) {
+        entities_unlink(e, last);
+        e->x[index] = e->x[last];
+        e->y[index] = e->y[last];
+        e->size[index] = e->size[last];
+        e->texture_id[index] = e->texture_id[last];
+        e->mark[index] = 0;
+        entities_link(e, index, e->cell[last]);
+    }
+}
+
+void entities_move(Entities* e, int index, float x, float y) {
+    if (index < 0 || index >= e->count) return;
+    e->x[index] = x;
+    e->y[index] = y;
+    int cell = entities_cell_of(e, x, y);
+    if (cell != e->cell[index]) {
+        entities_unlink(e, index);
+        entities_link(e, index, cell);
+    }
+}
+
+int entities_load_from_file(Entities* e, const char* filename) {
+    // Fichier optionnel: pas de message quand la map n'en a pas
+    FILE* file = fopen(filename, "r");
+    if (!file) return 0;
+
+    entities_clear(e);
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        float x, y, size;
+        int texture_id;
+        if (strncmp(line, "ENTITY", 6) == 0 &&
+            sscanf(line, "ENTITY %f %f %d %f", &x, &y, &texture_id, &size) == 4) {
+            if (entities_add(e, x, y, texture_id, size) < 0) break;
+        }
+    }
+
+    fclose(file);
+    printf("Entités chargées depuis %s (%d entités)\n", filename, e->count);
+    return 1;
+}
+
+void entities_scatter(Entities* e, Map* map, int count, int texture_count, Uint32 seed) {
+    Uint32 state = seed ? seed : 1;
+    int attempts = count * 8;
+    int added = 0;
+    while (added < count && attempts-- > 0) {
+        // xorshift32: même répartition d'un lancement à l'autre
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int tx = (int)(state % (Uint32)map->width);
+        int ty = (int)((state >> 12) % (Uint32)map->height);
+        if (MAP_TILE(map, LAYER_WALL, tx, ty).type == TILE_SOLID) continue;
+
+        float jitter_x = ((state >> 4) & 255) / 255.0f * 0.6f - 0.3f;
+        float jitter_y = ((state >> 20) & 255) / 255.0f * 0.6f - 0.3f;
+        float size = 0.5f + ((state >> 8) & 15) / 30.0f;
+        int texture_id = texture_count > 0 ? (int)((state >> 16) % (Uint32)texture_count) : 0;
+        if (entities_add(e, tx + 0.5f + jitter_x, ty + 0.5f + jitter_y, texture_id, size) < 0) break;
+        added++;
+    }
+    printf("Entités de test: %d ajoutées (%d au total)\n", added, e->count);
+}
+
+// Pixels [left, right] de l'écran (non bornés) derrière les murs de toutes leurs
+// colonnes à la profondeur depth (ou hors de l'écran)
+static int entities_occluded(const EntitiesOcclusion* o, float left, float right, float depth) {
+    int x0 = left <= 0.0f ? 0 : (left >= (float)o->screen_width ? o->screen_width : (int)left);
+    int x1 = right < 0.0f ? -1 : (right >= (float)o->screen_width ? o->screen_width - 1 : (int)right);
+    for (int g = x0 / o->group_width; x0 <= x1 && g <= x1 / o->group_width; g++) {
+        if (o->far[g] > depth) return 0;
+    }
+    return 1;
+}
+
+// Cellule [x0, x1] x [y0, y1] entièrement hors du champ de vue (ses quatre coins
+// derrière la caméra ou tous du même côté extérieur d'un bord du champ), ou
+// entièrement derrière les murs des colonnes qu'elle couvre à l'écran
+static int entities_cell_hidden(const Player* p, const EntitiesOcclusion* o, float inv_det,
+                                float x0, float y0, float x1, float y1) {
+    int behind = 0, left = 0, right = 0;
+    float near = INFINITY, screen_min = INFINITY, screen_max = -INFINITY;
+    for (int corner = 0; corner < 4; corner++) {
+        float rx = (corner & 1 ? x1 : x0) - p->x;
+        float ry = (corner & 2 ? y1 : y0) - p->y;
+        float depth = inv_det * (-p->plane_y * rx + p->plane_x * ry);
+        float side = inv_det * (p->dir_y * rx - p->dir_x * ry);
+        behind += depth < ENTITIES_NEAR;
+        left += side < -depth;
+        right += side > depth;
+        if (depth < near) near = depth;
+        if (depth >= ENTITIES_NEAR) {
+            float screen = side / depth;
+            if (screen < screen_min) screen_min = screen;
+            if (screen > screen_max) screen_max = screen;
+        }
+    }
+    if (behind == 4 || left == 4 || right == 4) return 1;
+
+    // Profondeur linéaire: la plus proche est celle d'un coin. Une cellule qui
+    // touche le plan proche n'a pas d'étendue à l'écran bornée
+    if (!o || behind > 0) return 0;
+    float half = 0.5f * o->screen_width;
+    return entities_occluded(o, half * (1.0f + screen_min), half * (1.0f + screen_max), near);
+}
+
+// Entités d'une cellule visibles, ajoutées à e->visible
+static void entities_cull_cell(Entities* e, int cell, const Map* map, const Player* player,
+                               const EntitiesOcclusion* occlusion, float inv_det, float plane_length,
+                               float max_distance) {
+    int from_x = (int)player->x;
+    int from_y = (int)player->y;
+    for (int i = e->heads[cell]; i >= 0; i = e->next[i]) {
+        float rx = e->x[i] - player->x;
+        float ry = e->y[i] - player->y;
+        float depth = inv_det * (-player->plane_y * rx + player->plane_x * ry);
+        if (depth < ENTITIES_NEAR || depth > max_distance) continue;
+        float side = inv_det * (player->dir_y * rx - player->dir_x * ry);
+        float half = e->size[i] * 0.5f / plane_length;
+        if (side - half > depth || side + half < -depth) continue;
+        float view_x = side / depth;
+        float view_half = half / depth;
+        if (occlusion) {
+            float screen = 0.5f * occlusion->screen_width;
+            if (entities_occluded(occlusion, screen * (1.0f + view_x - view_half),
+                                  screen * (1.0f + view_x + view_half), depth)) continue;
+        }
+        if (!pvs_tile_visible(map->pvs, from_x, from_y, (int)e->x[i], (int)e->y[i])) continue;
+
+        e->depth[i] = depth;
+        e->view_x[i] = view_x;
+        e->view_half[i] = view_half;
+        e->mark[i] = e->frame;
+        e->visible[e->visible_count++] = i;
+    }
+}
+
+int entities_cull_view(Entities* e, const Map* map, const Player* player, float max_distance,
+                       const EntitiesOcclusion* occlusion) {
+    // Frame 0 réservée aux entités déjà placées dans l'ordre
+    if (++e->frame == 0) e->frame = 1;
+    e->visible_count = 0;
+    float det = player->plane_x * player->dir_y - player->dir_x * player->plane_y;
+    if (e->count == 0 || det == 0.0f) return 0;
+    float inv_det = 1.0f / det;
+    float plane_length = sqrtf(player->plane_x * player->plane_x + player->plane_y * player->plane_y);
+    float margin = e->max_size * 0.5f;
+
+    // Boîte du triangle de vue: la caméra et les bords du champ à max_distance
+    float left_x = player->x + (player->dir_x - player->plane_x) * max_distance;
+    float left_y = player->y + (player->dir_y - player->plane_y) * max_distance;
+    float right_x = player->x + (player->dir_x + player->plane_x) * max_distance;
+    float right_y = player->y + (player->dir_y + player->plane_y) * max_distance;
+    float min_x = fminf(player->x, fminf(left_x, right_x)) - margin;
+    float min_y = fminf(player->y, fminf(left_y, right_y)) - margin;
+    float max_x = fmaxf(player->x, fmaxf(left_x, right_x)) + margin;
+    float max_y = fmaxf(player->y, fmaxf(left_y, right_y)) + margin;
+    float grid_x = (float)(e->cells_x << ENTITIES_CELL_SHIFT);
+    float grid_y = (float)(e->cells_y << ENTITIES_CELL_SHIFT);
+    int cell_x0 = min_x <= 0.0f ? 0 : (min_x >= grid_x ? e->cells_x : (int)min_x >> ENTITIES_CELL_SHIFT);
+    int cell_y0 = min_y <= 0.0f ? 0 : (min_y >= grid_y ? e->cells_y : (int)min_y >> ENTITIES_CELL_SHIFT);
+    int cell_x1 = max_x < 0.0f ? -1 : (max_x >= grid_x ? e->cells_x - 1 : (int)max_x >> ENTITIES_CELL_SHIFT);
+    int cell_y1 = max_y < 0.0f ? -1 : (max_y >= grid_y ? e->cells_y - 1 : (int)max_y >> ENTITIES_CELL_SHIFT);
+    float span = (float)(1 << ENTITIES_CELL_SHIFT) + 2.0f * margin;
+
+    for (int cy = cell_y0; cy <= cell_y1; cy++) {
+        for (int cx = cell_x0; cx <= cell_x1; cx++) {
+            int cell = cy * e->cells_x + cx;
+            if (e->heads[cell] < 0) continue;
+            float x0 = (float)(cx << ENTITIES_CELL_SHIFT) - margin;
+            float y0 = (float)(cy << ENTITIES_CELL_SHIFT) - margin;
+            if (entities_cell_hidden(player, occlusion, inv_det, x0, y0, x0 + span, y0 + span)) continue;
+            entities_cull_cell(e, cell, map, player, occlusion, inv_det, plane_length, max_distance);
+        }
+    }
+    // Entités hors de la map, testées une à une
+    entities_cull_cell(e, e->cells_x * e->cells_y, map, player, occlusion, inv_det, plane_length, max_distance);
+    return e->visible_count;
+}
+
+static int entities_compare_keys(const void* a, const void* b) {
+    Uint64 ka = *(const Uint64*)a;
+    Uint64 kb = *(const Uint64*)b;
+    return ka < kb ? 1 : (ka > kb ? -1 : 0);
+}
+
+void entities_sort_view(Entities* e) {
+    // Les entités encore visibles gardent leur rang de la frame précédente, les
+    // nouvelles suivent: l'ordre n'est que localement perturbé
+    int n = 0;
+    for (int k = 0; k < e->order_count; k++) {
+        int i = e->order[k];
+        if (i < e->count && e->mark[i] == e->frame) {
+            e->mark[i] = 0;
+            e->order[n++] = i;
+        }
+    }
+    int kept = n;
+    for (int k = 0; k < e->visible_count; k++) {
+        int i = e->visible[k];
+        if (e->mark[i] == e->frame) {
+            e->mark[i] = 0;
+            e->order[n++] = i;
+        }
+    }
+    e->order_count = n;
+
+    // Beaucoup de nouvelles entités (première frame, téléportation): tri complet.
+    // Profondeurs positives: leurs bits se comparent comme des entiers
+    int added = n - kept;
+    e->resorted = added > 32 && added * ENTITIES_SORT_RESORT > n;
+    if (e->resorted) {
+        for (int k = 0; k < n; k++) {
+            Uint32 bits;
+            memcpy(&bits, &e->depth[e->order[k]], sizeof(bits));
+            e->sort_keys[k] = ((Uint64)bits << 32) | (Uint32)e->order[k];
+        }
+        qsort(e->sort_keys, n, sizeof(Uint64), entities_compare_keys);
+        for (int k = 0; k < n; k++) {
+            e->order[k] = (int)(Uint32)e->sort_keys[k];
+        }
+        return;
+    }
+
+    // Tri par insertion, linéaire sur un ordre presque trié
+    for (int k = 1; k < n; k++) {
+        int i = e->order[k];
+        float d = e->depth[i];
+        int j = k;
+        while (j > 0 && e->depth[e->order[j - 1]] < d) {
+            e->order[j] = e->order[j - 1];
+            j--;
+        }
+        e->order[j] = i;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "player.h"
+
+#define ENTITIES_MAX 65536            // Entités par map
+#define ENTITIES_CELL_SHIFT 2         // Cellules du hachage spatial: 4x4 tiles
+#define ENTITIES_NEAR 0.1f            // Profondeur minimale d'un sprite (plan proche)
+#define ENTITIES_SORT_RESORT 8        // Plus d'1/8 de nouveaux sprites: tri complet
+
+// Entités affichées en sprites (décors, objets, personnages), rangées en colonnes
+// (SoA): le culling ne lit que les positions, le rendu que les entités visibles.
+// Chaque entité est chaînée dans la cellule de la grille qui la contient
+typedef struct Entities {
+    int count;
+    int capacity;
+    float* x;                     // Position monde (pied du sprite)
+    float* y;
+    float* size;                  // Hauteur et largeur, 1 = hauteur d'un mur
+    int* texture_id;
+    int* cell;                    // Cellule du hachage spatial
+    int* next;                    // Entité suivante de la même cellule, -1 en fin de liste
+    float max_size;               // Plus grande taille (marge du culling des cellules)
+
+    // Hachage spatial: tête de liste de chaque cellule de 4x4 tiles, une cellule
+    // supplémentaire (la dernière) pour les entités hors de la map
+    int cells_x, cells_y;
+    int* heads;                   // [cells_x * cells_y + 1]
+
+    // Vue de la frame (entities_cull_view): entités visibles, leur profondeur, leur
+    // centre et leur demi-largeur à l'écran (normalisés: -1 bord gauche, 1 bord droit)
+    float* depth;
+    float* view_x;
+    float* view_half;
+    int* visible;
+    int visible_count;
+
+    // Tri cohérent d'une frame à l'autre: l'ordre de la frame précédente, presque
+    // trié, sert de départ au tri par insertion
+    int* order;                   // Visibles du plus loin au plus proche
+    int order_count;
+    Uint32* mark;                 // Frame de visibilité (0 une fois placée dans l'ordre)
+    Uint32 frame;
+    Uint64* sort_keys;            // Tri complet: bits de la profondeur puis index
+    int resorted;                 // Tri complet à la dernière frame (trop de nouveaux sprites)
+} Entities;
+
+// Grille des dimensions de la map, NULL en cas d'erreur
+Entities* entities_create(int map_width, int map_height);
+void entities_destroy(Entities* e);
+void entities_clear(Entities* e);
+
+// Renvoie l'index de l'entité, -1 si la limite est atteinte. La suppression déplace
+// la dernière entité à l'index libéré
+int entities_add(Entities* e, float x, float y, int texture_id, float size);
+void entities_remove(Entities* e, int index);
+void entities_move(Entities* e, int index, float x, float y);
+
+// Fichier "<map>.entities": une ligne "ENTITY x y texture taille" par entité
+int entities_load_from_file(Entities* e, const char* filename);
+
+// Décors de test (textures 0 .. texture_count - 1) répartis sur les tiles vides de la map
+void entities_scatter(Entities* e, Map* map, int count, int texture_count, Uint32 seed);
+
+// Murs de l'écran pour le culling par occlusion: profondeur du mur le plus lointain
+// de chaque groupe de group_width colonnes (INFINITY pour une colonne sans mur)
+typedef struct {
+    const float* far;
+    int group_width;
+    int screen_width;
+} EntitiesOcclusion;
+
+// Entités devant la caméra jusqu'à max_distance: cellules du champ de vue non
+// cachées par les murs (occlusion, NULL: champ de vue seul), puis chaque entité
+// (champ, murs, PVS de la tile de la caméra). Renvoie leur nombre (e->visible)
+int entities_cull_view(Entities* e, const Map* map, const Player* player, float max_distance,
+                       const EntitiesOcclusion* occlusion);
+
+// Visibles triées du plus loin au plus proche dans e->order
+void entities_sort_view(Entities* e);
+
+#endif
@@ -0,0 +1,275 @@
+#include "file_watch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+
+// Dossier suivi par ReadDirectoryChangesW: une lecture asynchrone toujours en
+// attente, relancée après chaque lot de noms
+typedef struct {
+    HANDLE dir;
+    OVERLAPPED overlapped;
+    int pending;                  // Lecture en cours: le système peut écrire dans buffer
+    DWORD buffer[2048];           // FILE_NOTIFY_INFORMATION, alignés sur DWORD
+} FileWatchDir;
+
+static int file_watch_read_changes(FileWatchDir* watch) {
+    ResetEvent(watch->overlapped.hEvent);
+    watch->pending = ReadDirectoryChangesW(watch->dir, watch->buffer, sizeof(watch->buffer), FALSE,
+                                           FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                           FILE_NOTIFY_CHANGE_SIZE,
+                                           NULL, &watch->overlapped, NULL) != 0;
+    return watch->pending;
+}
+
+static void file_watch_close_dir(FileWatchDir* watch) {
+    if (watch->pending) {
+        // Attendre l'annulation: le système ne doit plus écrire dans buffer
+        DWORD bytes;
+        CancelIo(watch->dir);
+        GetOverlappedResult(watch->dir, &watch->overlapped, &bytes, TRUE);
+    }
+    if (watch->dir != INVALID_HANDLE_VALUE) {
+        CloseHandle(watch->dir);
+    }
+    if (watch->overlapped.hEvent) {
+        CloseHandle(watch->overlapped.hEvent);
+    }
+    free(watch);
+}
+
+static FileWatchDir* file_watch_open_dir(const char* dir) {
+    FileWatchDir* watch = calloc(1, sizeof(FileWatchDir));
+    if (!watch) return NULL;
+
+    watch->dir = CreateFileA(dir, FILE_LIST_DIRECTORY,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                             OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    watch->overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    if (watch->dir == INVALID_HANDLE_VALUE || !watch->overlapped.hEvent ||
+        !file_watch_read_changes(watch)) {
+        file_watch_close_dir(watch);
+        return NULL;
+    }
+    return watch;
+}
+#endif
+
+int file_watch_init(FileWatch* fw) {
+    fw->count = 0;
+    fw->last_poll = SDL_GetTicks();
+
+#if defined(__linux__)
+    fw->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fw->fd < 0) {
+        printf("inotify indisponible, rescan périodique des dossiers\n");
+    }
+#endif
+    return 1;
+}
+
+int file_watch_add_dir(FileWatch* fw, const char* dir) {
+    if (fw->count >= FILE_WATCH_MAX_DIRS) {
+        printf("Erreur: trop de dossiers surveillés (%d max)\n", FILE_WATCH_MAX_DIRS);
+        return -1;
+    }
+
+    int index = fw->count;
+    snprintf(fw->dirs[index], FILE_WATCH_PATH_MAX, "%s", dir);
+
+#if defined(__linux__)
+    fw->wd[index] = -1;
+    if (fw->fd >= 0) {
+        // Fichiers fermés après écriture, renommés, créés ou supprimés
+        fw->wd[index] = inotify_add_watch(fw->fd, dir,
+                                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE);
+        if (fw->wd[index] < 0) {
+            printf("Impossible de surveiller %s\n", dir);
+        }
+    }
+#elif defined(_WIN32)
+    fw->handles[index] = file_watch_open_dir(dir);
+    if (!fw->handles[index]) {
+        printf("Impossible de surveiller %s\n", dir);
+    }
+#endif
+
+    fw->count++;
+    return index;
+}
+
+// Événements de la frame et dossiers dont un événement n'a pas tenu dans le tableau
+typedef struct {
+    FileWatchEvent* events;
+    int count;
+    int max_events;
+    int overflow[FILE_WATCH_MAX_DIRS];
+} FileWatchBatch;
+
+static void file_watch_push(FileWatchBatch* batch, int dir_index, const char* name) {
+    if (batch->count >= batch->max_events) {
+        batch->overflow[dir_index] = 1;
+        return;
+    }
+    batch->events[batch->count].dir_index = dir_index;
+    snprintf(batch->events[batch->count].name, FILE_WATCH_PATH_MAX, "%s", name);
+    batch->count++;
+}
+
+// Tableau plein: les noms d'un dossier débordé sont remplacés par un seul
+// événement de rescan, rien n'est perdu (max_events >= FILE_WATCH_MAX_DIRS)
+static int file_watch_finish(FileWatchBatch* batch, int dir_count) {
+    for (;;) {
+        int kept = 0;
+        int rescans = 0;
+        for (int e = 0; e < batch->count; e++) {
+            kept += !batch->overflow[batch->events[e].dir_index];
+        }
+        for (int i = 0; i < dir_count; i++) rescans += batch->overflow[i];
+        if (rescans == 0) return batch->count;
+        if (kept + rescans <= batch->max_events) break;
+
+        // Pas de place pour les rescans: le dossier du premier nom gardé est rescanné aussi
+        for (int e = 0; e < batch->count; e++) {
+            if (!batch->overflow[batch->events[e].dir_index]) {
+                batch->overflow[batch->events[e].dir_index] = 1;
+                break;
+            }
+        }
+    }
+
+    int count = 0;
+    for (int e = 0; e < batch->count; e++) {
+        if (!batch->overflow[batch->events[e].dir_index]) {
+            batch->events[count++] = batch->events[e];
+        }
+    }
+    for (int i = 0; i < dir_count; i++) {
+        if (batch->overflow[i]) {
+            batch->events[count].dir_index = i;
+            batch->events[count].name[0] = '\0';
+            count++;
+        }
+    }
+    return count;
+}
+
+// Dossier signalé par le système (sinon rescan périodique)
+static int file_watch_notified(const FileWatch* fw, int index) {
+#if defined(__linux__)
+    return fw->fd >= 0 && fw->wd[index] >= 0;
+#elif defined(_WIN32)
+    return fw->handles[index] != NULL;
+#else
+    (void)fw;
+    (void)index;
+    return 0;
+#endif
+}
+
+int file_watch_poll(FileWatch* fw, FileWatchEvent* events, int max_events) {
+    FileWatchBatch batch = { events, 0, max_events, {0} };
+
+#if defined(__linux__)
+    if (fw->fd >= 0) {
+        char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        for (;;) {
+            ssize_t len = read(fw->fd, buffer, sizeof(buffer));
+            if (len <= 0) break;   // EAGAIN: plus rien en attente
+
+            for (char* p = buffer; p < buffer + len; ) {
+                struct inotify_event* ev = (struct inotify_event*)p;
+                if (ev->mask & IN_Q_OVERFLOW) {
+                    // File d'événements saturée: demander un rescan complet
+                    for (int i = 0; i < fw->count; i++) {
+                        batch.overflow[i] = 1;
+                    }
+                } else if (ev->len > 0) {
+                    for (int i = 0; i < fw->count; i++) {
+                        if (fw->wd[i] == ev->wd) {
+                            file_watch_push(&batch, i, ev->name);
+                            break;
+                        }
+                    }
+                }
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+        }
+    }
+#elif defined(_WIN32)
+    for (int i = 0; i < fw->count; i++) {
+        FileWatchDir* watch = fw->handles[i];
+        if (!watch) continue;
+
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(watch->dir, &watch->overlapped, &bytes, FALSE)) {
+            if (GetLastError() == ERROR_IO_INCOMPLETE) continue;   // Rien de nouveau
+            bytes = 0;
+        }
+        watch->pending = 0;
+
+        if (bytes == 0) {
+            // Tampon du système débordé (ou erreur): les noms sont perdus, rescan du dossier
+            batch.overflow[i] = 1;
+        } else {
+            const BYTE* p = (const BYTE*)watch->buffer;
+            for (;;) {
+                const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)p;
+                char name[FILE_WATCH_PATH_MAX];
+                int len = WideCharToMultiByte(CP_UTF8, 0, info->FileName,
+                                              (int)(info->FileNameLength / sizeof(WCHAR)),
+                                              name, sizeof(name) - 1, NULL, NULL);
+                if (len > 0) {
+                    name[len] = '\0';
+                    file_watch_push(&batch, i, name);
+                }
+                if (info->NextEntryOffset == 0) break;
+                p += info->NextEntryOffset;
+            }
+        }
+
+        if (!file_watch_read_changes(watch)) {
+            // Surveillance perdue: le dossier passe au rescan périodique
+            printf("Surveillance de %s interrompue\n", fw->dirs[i]);
+            file_watch_close_dir(watch);
+            fw->handles[i] = NULL;
+            batch.overflow[i] = 1;
+        }
+    }
+#endif
+
+    // Dossiers sans notification système (indisponible ou surveillance refusée):
+    // rescan périodique
+    Uint32 now = SDL_GetTicks();
+    if (now - fw->last_poll >= FILE_WATCH_POLL_MS) {
+        fw->last_poll = now;
+        for (int i = 0; i < fw->count; i++) {
+            if (!file_watch_notified(fw, i)) {
+                file_watch_push(&batch, i, "");
+            }
+        }
+    }
+    return file_watch_finish(&batch, fw->count);
+}
+
+void file_watch_destroy(FileWatch* fw) {
+#if defined(__linux__)
+    if (fw->fd >= 0) {
+        close(fw->fd);
+        fw->fd = -1;
+    }
+#elif defined(_WIN32)
+    for (int i = 0; i < fw->count; i++) {
+        if (fw->handles[i]) {
+            file_watch_close_dir(fw->handles[i]);
+            fw->handles[i] = NULL;
+        }
+    }
+#endif
+    fw->count = 0;
+}
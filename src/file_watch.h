@@ -0,0 +1,38 @@
+#ifndef FILE_WATCH_H
+#define FILE_WATCH_H
+
+#include <SDL2/SDL.h>
+
+#define FILE_WATCH_MAX_DIRS 4
+#define FILE_WATCH_PATH_MAX 256
+#define FILE_WATCH_POLL_MS 1000   // Période de rescan quand aucune notification système n'existe
+
+// Événement de changement dans un dossier surveillé.
+// name vide = "quelque chose a changé", le consommateur doit rescanner le dossier.
+typedef struct {
+    int dir_index;
+    char name[FILE_WATCH_PATH_MAX];
+} FileWatchEvent;
+
+typedef struct {
+    int count;
+    char dirs[FILE_WATCH_MAX_DIRS][FILE_WATCH_PATH_MAX];
+#if defined(__linux__)
+    int fd;                                    // inotify
+    int wd[FILE_WATCH_MAX_DIRS];
+#elif defined(_WIN32)
+    void* handles[FILE_WATCH_MAX_DIRS];        // ReadDirectoryChangesW (NULL: non surveillé)
+#endif
+    Uint32 last_poll;
+} FileWatch;
+
+// Surveillance non bloquante de dossiers (inotify sous Linux,
+// ReadDirectoryChangesW sous Windows, rescan périodique ailleurs).
+// Quand events déborde, les noms d'un dossier sont remplacés par un événement
+// de rescan: max_events doit valoir au moins FILE_WATCH_MAX_DIRS
+int file_watch_init(FileWatch* fw);
+int file_watch_add_dir(FileWatch* fw, const char* dir);
+int file_watch_poll(FileWatch* fw, FileWatchEvent* events, int max_events);
+void file_watch_destroy(FileWatch* fw);
+
+#endif
@@ -0,0 +1,63 @@
+#include "game_clock.h"
+
+void game_clock_init(GameClock* clock, int tick_rate, int max_fps) {
+    clock->frequency = SDL_GetPerformanceFrequency();
+    clock->last = SDL_GetPerformanceCounter();
+    clock->accumulator = 0.0;
+    clock->tick = 1.0 / (tick_rate > 0 ? tick_rate : GAME_TICK_RATE);
+    clock->frame_period = max_fps > 0 ? clock->frequency / max_fps : 0;
+    clock->next_frame = clock->last + clock->frame_period;
+    clock->ticks = 0;
+}
+
+// Mesurer le temps écoulé et renvoyer le nombre de ticks de simulation à exécuter
+int game_clock_begin_frame(GameClock* clock) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    clock->accumulator += (double)(now - clock->last) / clock->frequency;
+    clock->last = now;
+
+    int ticks = (int)(clock->accumulator / clock->tick);
+    if (ticks > GAME_MAX_TICKS_PER_FRAME) {
+        // Frame beaucoup trop longue (chargement, fenêtre déplacée): ne pas rattraper
+        ticks = GAME_MAX_TICKS_PER_FRAME;
+        clock->accumulator = ticks * clock->tick;
+    }
+    clock->accumulator -= ticks * clock->tick;
+    clock->ticks += ticks;
+    return ticks;
+}
+
+// Position du rendu entre le tick précédent (0) et le dernier tick (1)
+float game_clock_alpha(GameClock* clock) {
+    return (float)(clock->accumulator / clock->tick);
+}
+
+// Temps de simulation (s) au dernier tick: avance par pas fixes, s'arrête avec la
+// simulation quand le retard est abandonné
+double game_clock_time(GameClock* clock) {
+    return clock->ticks * clock->tick;
+}
+
+// Attendre l'échéance de la frame: SDL_Delay pour l'essentiel, boucle active pour la fin
+void game_clock_end_frame(GameClock* clock) {
+    if (clock->frame_period == 0) return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= clock->next_frame) {
+        // En retard d'une frame ou plus: repartir de maintenant plutôt que d'enchaîner
+        if (now - clock->next_frame > clock->frame_period) {
+            clock->next_frame = now;
+        }
+        clock->next_frame += clock->frame_period;
+        return;
+    }
+
+    double remaining_ms = (double)(clock->next_frame - now) * 1000.0 / clock->frequency;
+    if (remaining_ms > GAME_SPIN_MS) {
+        SDL_Delay((Uint32)(remaining_ms - GAME_SPIN_MS));
+    }
+    while (SDL_GetPerformanceCounter() < clock->next_frame) {
+        // Attente active sur les dernières millisecondes
+    }
+    clock->next_frame += clock->frame_period;
+}
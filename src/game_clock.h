@@ -0,0 +1,29 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+#include <SDL2/SDL.h>
+
+#define GAME_TICK_RATE 120            // Ticks de simulation par seconde (pas fixe)
+#define GAME_MAX_TICKS_PER_FRAME 8    // Au-delà, le retard est abandonné (pas de spirale)
+#define GAME_FPS_DEFAULT 60           // Cadence visée sans vsync, 0 = illimitée
+#define GAME_SPIN_MS 2.0              // Fin de l'attente en boucle active (précision de SDL_Delay)
+
+// Horloge de la boucle principale: simulation à pas fixe sur le compteur haute
+// résolution, fraction restante pour interpoler le rendu, limiteur de cadence précis
+typedef struct {
+    Uint64 frequency;
+    Uint64 last;                // Compteur au début de la frame précédente
+    double accumulator;         // Temps de simulation en attente (s)
+    double tick;                // Durée d'un tick (s)
+    Uint64 frame_period;        // Durée visée d'une frame en ticks du compteur, 0 = illimitée
+    Uint64 next_frame;          // Échéance de la prochaine frame
+    Uint64 ticks;               // Ticks simulés depuis l'initialisation
+} GameClock;
+
+void game_clock_init(GameClock* clock, int tick_rate, int max_fps);
+int game_clock_begin_frame(GameClock* clock);
+float game_clock_alpha(GameClock* clock);
+double game_clock_time(GameClock* clock);
+void game_clock_end_frame(GameClock* clock);
+
+#endif
@@ -0,0 +1,293 @@
+#include "hot_reload.h"
+#include "pvs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static time_t hot_reload_mtime(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_mtime : 0;
+}
+
+static const char* hot_reload_basename(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static void hot_reload_texture_path(int id, char* out_path, size_t out_size) {
+    snprintf(out_path, out_size, "textures/texture%d.bmp", id + 1);
+}
+
+int hot_reload_init(HotReload* hr, const char* map_path) {
+    file_watch_init(&hr->watch);
+    hr->maps_dir = file_watch_add_dir(&hr->watch, "maps");
+    hr->textures_dir = file_watch_add_dir(&hr->watch, "textures");
+    hr->textures_rescan_pending = 0;
+    hr->textures_rescan_tick = SDL_GetTicks() - HOT_RELOAD_RESCAN_MS;
+
+    for (int i = 0; i < MAX_TEXTURES; i++) {
+        char path[64];
+        hot_reload_texture_path(i, path, sizeof(path));
+        hr->texture_mtimes[i] = hot_reload_mtime(path);
+    }
+
+    hot_reload_set_map(hr, map_path);
+    return 1;
+}
+
+void hot_reload_set_map(HotReload* hr, const char* map_path) {
+    snprintf(hr->map_path, sizeof(hr->map_path), "%s", map_path);
+    snprintf(hr->lights_path, sizeof(hr->lights_path), "%s.lights", map_path);
+    hr->map_mtime = hot_reload_mtime(hr->map_path);
+    hr->lights_mtime = hot_reload_mtime(hr->lights_path);
+}
+
+void hot_reload_destroy(HotReload* hr) {
+    file_watch_destroy(&hr->watch);
+}
+
+// Cellule différente de la map chargée, appliquée une fois le fichier lu sans erreur
+typedef struct {
+    size_t index;
+    Tile tiles[NUM_LAYERS];
+} HotReloadCell;
+
+// Comparer la map sur disque à la map chargée pendant sa lecture: pas de seconde
+// map, seules les cellules modifiées sont gardées puis recopiées
+static void hot_reload_apply_map(HotReload* hr, Map* map, HotReloadResult* result) {
+    size_t size;
+    char* data = map_read_file(hr->map_path, &size);
+    if (!data) return;
+
+    MapReader reader;
+    map_reader_open(&reader, data, size, hr->map_path);
+    if (reader.width != map->width || reader.height != map->height) {
+        result->flags |= HOT_RELOAD_NEEDS_FULL;
+        free(data);
+        return;
+    }
+
+    HotReloadCell* changes = NULL;
+    int count = 0;
+    int capacity = 0;
+    Tile tiles[NUM_LAYERS];
+    while (map_reader_next(&reader, tiles)) {
+        size_t i = reader.cell - 1;
+        int changed = 0;
+        for (int layer = 0; layer < NUM_LAYERS; layer++) {
+            const Tile* current = &map->layers[layer][i];
+            changed |= current->type != tiles[layer].type || current->texture_id != tiles[layer].texture_id;
+        }
+        if (!changed) continue;
+
+        if (count == capacity) {
+            int grown = capacity ? capacity * 2 : 64;
+            HotReloadCell* cells = realloc(changes, grown * sizeof(HotReloadCell));
+            if (!cells) {
+                printf("Erreur allocation des tiles modifiées (%d)\n", grown);
+                free(changes);
+                free(data);
+                return;
+            }
+            changes = cells;
+            capacity = grown;
+        }
+        changes[count].index = i;
+        memcpy(changes[count].tiles, tiles, sizeof(tiles));
+        count++;
+    }
+    free(data);
+    if (reader.failed) {
+        free(changes);
+        return;
+    }
+
+    map->player_start_x = reader.player_start_x;
+    map->player_start_y = reader.player_start_y;
+
+    for (int k = 0; k < count; k++) {
+        size_t i = changes[k].index;
+        int x = (int)(i % map->width);
+        int y = (int)(i / map->width);
+        for (int layer = 0; layer < NUM_LAYERS; layer++) {
+            map->layers[layer][i] = changes[k].tiles[layer];
+        }
+
+        if (k == 0) {
+            result->dirty_x0 = result->dirty_x1 = x;
+            result->dirty_y0 = result->dirty_y1 = y;
+        } else {
+            if (x < result->dirty_x0) result->dirty_x0 = x;
+            if (x > result->dirty_x1) result->dirty_x1 = x;
+            if (y < result->dirty_y0) result->dirty_y0 = y;
+            if (y > result->dirty_y1) result->dirty_y1 = y;
+        }
+    }
+    result->changed_tiles = count;
+
+    if (count > 0) {
+        result->flags |= HOT_RELOAD_TILES;
+    }
+    free(changes);
+}
+
+static int hot_reload_light_equals(Light* a, Light* b) {
+    return a->x == b->x && a->y == b->y && a->r == b->r && a->g == b->g && a->b == b->b &&
+           a->intensity == b->intensity && a->radius == b->radius &&
+           a->animation == b->animation && a->anim_rate == b->anim_rate && a->anim_depth == b->anim_depth;
+}
+
+// Appliquer uniquement les lumières ajoutées, déplacées ou supprimées
+static void hot_reload_apply_lights(HotReload* hr, LightManager* lm, HotReloadResult* result) {
+    LightManager* fresh = malloc(sizeof(LightManager));
+    if (!fresh) return;
+    if (!lighting_load_from_file(fresh, hr->lights_path)) {
+        free(fresh);
+        return;
+    }
+
+    if (lm->ambient_r != fresh->ambient_r || lm->ambient_g != fresh->ambient_g ||
+        lm->ambient_b != fresh->ambient_b || lm->ambient_intensity != fresh->ambient_intensity) {
+        lighting_set_ambient(lm, fresh->ambient_r, fresh->ambient_g, fresh->ambient_b, fresh->ambient_intensity);
+        result->changed_lights++;
+    }
+
+    int common = lm->count < fresh->count ? lm->count : fresh->count;
+    for (int i = 0; i < common; i++) {
+        Light* incoming = &fresh->lights[i];
+        if (!hot_reload_light_equals(&lm->lights[i], incoming)) {
+            lighting_set_light(lm, i, incoming->x, incoming->y, incoming->r, incoming->g, incoming->b,
+                               incoming->intensity, incoming->radius);
+            lighting_set_animation(lm, i, incoming->animation, incoming->anim_rate, incoming->anim_depth);
+            result->changed_lights++;
+        }
+    }
+    for (int i = common; i < fresh->count; i++) {
+        Light* incoming = &fresh->lights[i];
+        int index = lighting_add_light(lm, incoming->x, incoming->y, incoming->r, incoming->g, incoming->b,
+                                       incoming->intensity, incoming->radius);
+        lighting_set_animation(lm, index, incoming->animation, incoming->anim_rate, incoming->anim_depth);
+        result->changed_lights++;
+    }
+    while (lm->count > fresh->count) {
+        lighting_remove_light(lm, lm->count - 1);
+        result->changed_lights++;
+    }
+
+    if (result->changed_lights > 0) {
+        result->flags |= HOT_RELOAD_LIGHTS;
+    }
+    free(fresh);
+}
+
+static void hot_reload_apply_texture(HotReload* hr, TextureManager* tm, int id, HotReloadResult* result) {
+    char path[64];
+    hot_reload_texture_path(id, path, sizeof(path));
+    hr->texture_mtimes[id] = hot_reload_mtime(path);
+
+    if (textures_reload(tm, id)) {
+        result->changed_textures++;
+        result->flags |= HOT_RELOAD_TEXTURES;
+    }
+}
+
+// Fichiers dont la date a changé depuis leur dernière application
+static void hot_reload_rescan_maps(HotReload* hr, int* map_dirty, int* lights_dirty) {
+    *map_dirty |= hot_reload_mtime(hr->map_path) != hr->map_mtime;
+    *lights_dirty |= hot_reload_mtime(hr->lights_path) != hr->lights_mtime;
+}
+
+static void hot_reload_rescan_textures(HotReload* hr, int* texture_dirty) {
+    for (int id = 0; id < MAX_TEXTURES; id++) {
+        char path[64];
+        hot_reload_texture_path(id, path, sizeof(path));
+        texture_dirty[id] |= hot_reload_mtime(path) != hr->texture_mtimes[id];
+    }
+}
+
+int hot_reload_poll(HotReload* hr, Map* map, LightManager* lm, TextureManager* tm, HotReloadResult* result) {
+    memset(result, 0, sizeof(*result));
+
+    FileWatchEvent events[HOT_RELOAD_MAX_EVENTS];
+    int event_count = file_watch_poll(&hr->watch, events, HOT_RELOAD_MAX_EVENTS);
+    Uint32 now = SDL_GetTicks();
+    int rescan_due = now - hr->textures_rescan_tick >= HOT_RELOAD_RESCAN_MS;
+    if (event_count == 0 && !(hr->textures_rescan_pending && rescan_due)) return 0;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    int map_dirty = 0;
+    int lights_dirty = 0;
+    int texture_dirty[MAX_TEXTURES] = {0};
+    const char* cache_name = hot_reload_basename(TEXTURES_CACHE_FILE);
+
+    // Tableau plein: des noms ont pu manquer, tous les fichiers suivis sont
+    // comparés à leur date comme pour un rescan
+    int rescan_all = event_count >= HOT_RELOAD_MAX_EVENTS;
+    if (rescan_all) {
+        hot_reload_rescan_maps(hr, &map_dirty, &lights_dirty);
+        hr->textures_rescan_pending = 1;
+    }
+
+    for (int i = 0; i < event_count && !rescan_all; i++) {
+        FileWatchEvent* ev = &events[i];
+        if (ev->dir_index == hr->maps_dir) {
+            if (ev->name[0] == '\0') {
+                // Pas de nom de fichier (débordement, rescan périodique): comparer les dates
+                hot_reload_rescan_maps(hr, &map_dirty, &lights_dirty);
+            } else if (strcmp(ev->name, hot_reload_basename(hr->map_path)) == 0) {
+                map_dirty = 1;
+            } else if (strcmp(ev->name, hot_reload_basename(hr->lights_path)) == 0) {
+                lights_dirty = 1;
+            }
+        } else if (ev->dir_index == hr->textures_dir) {
+            if (ev->name[0] == '\0') {
+                hr->textures_rescan_pending = 1;
+            } else if (strncmp(ev->name, cache_name, strlen(cache_name)) != 0) {
+                // textures.cache (et son .tmp) est écrit par le moteur lui-même
+                int id = textures_id_from_name(ev->name);
+                if (id >= 0) texture_dirty[id] = 1;
+            }
+        }
+    }
+
+    // Sans nom de fichier, textures/ est comparé à ses dates: jusqu'à MAX_TEXTURES
+    // stat, regroupés en un rescan au plus tous les HOT_RELOAD_RESCAN_MS
+    if (hr->textures_rescan_pending && rescan_due) {
+        hot_reload_rescan_textures(hr, texture_dirty);
+        hr->textures_rescan_pending = 0;
+        hr->textures_rescan_tick = now;
+    }
+
+    if (map_dirty) {
+        hr->map_mtime = hot_reload_mtime(hr->map_path);
+        hot_reload_apply_map(hr, map, result);
+        if ((result->flags & HOT_RELOAD_TILES) && lm->occluders) {
+            // Ombres: seule la zone modifiée est relue, seules les lumières qui la
+            // couvrent sont recalculées
+            Uint8* grid = map_build_occluders_rect(map, result->dirty_x0, result->dirty_y0,
+                                                   result->dirty_x1, result->dirty_y1);
+            if (grid) {
+                lighting_update_occluders(lm, grid, result->dirty_x0, result->dirty_y0,
+                                          result->dirty_x1, result->dirty_y1);
+                free(grid);
+            }
+        }
+        if (result->flags & HOT_RELOAD_TILES) {
+            pvs_update(map->pvs, map, result->dirty_x0, result->dirty_y0,
+                       result->dirty_x1, result->dirty_y1);
+        }
+    }
+    if (lights_dirty && !(result->flags & HOT_RELOAD_NEEDS_FULL)) {
+        hr->lights_mtime = hot_reload_mtime(hr->lights_path);
+        hot_reload_apply_lights(hr, lm, result);
+    }
+    for (int id = 0; id < MAX_TEXTURES; id++) {
+        if (texture_dirty[id]) {
+            hot_reload_apply_texture(hr, tm, id, result);
+        }
+    }
+
+    result->ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    return result->flags;
+}
@@ -0,0 +1,52 @@
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include <SDL2/SDL.h>
+#include <time.h>
+#include "map.h"
+#include "textures.h"
+#include "file_watch.h"
+#include "../editor/lighting.h"
+
+#define HOT_RELOAD_MAX_EVENTS 64
+#define HOT_RELOAD_RESCAN_MS 250    // Écart minimal entre deux rescans du dossier textures/
+
+// Ce qui a été appliqué lors d'un hot-reload
+enum {
+    HOT_RELOAD_NONE = 0,
+    HOT_RELOAD_TILES = 1,
+    HOT_RELOAD_LIGHTS = 2,
+    HOT_RELOAD_TEXTURES = 4,
+    HOT_RELOAD_NEEDS_FULL = 8     // Taille de map changée: rechargement complet nécessaire
+};
+
+typedef struct {
+    int flags;
+    int changed_tiles;
+    int dirty_x0, dirty_y0;       // Rectangle englobant des tiles modifiées (inclusif)
+    int dirty_x1, dirty_y1;
+    int changed_lights;
+    int changed_textures;
+    double ms;
+} HotReloadResult;
+
+// Surveille la map courante, son fichier .lights et le dossier textures/
+typedef struct {
+    FileWatch watch;
+    int maps_dir;
+    int textures_dir;
+    char map_path[512];
+    char lights_path[520];
+    time_t map_mtime;
+    time_t lights_mtime;
+    time_t texture_mtimes[MAX_TEXTURES];
+    int textures_rescan_pending;  // Rescan de textures/ demandé, fait au plus tous les HOT_RELOAD_RESCAN_MS
+    Uint32 textures_rescan_tick;
+} HotReload;
+
+int hot_reload_init(HotReload* hr, const char* map_path);
+void hot_reload_set_map(HotReload* hr, const char* map_path);
+int hot_reload_poll(HotReload* hr, Map* map, LightManager* lm, TextureManager* tm, HotReloadResult* result);
+void hot_reload_destroy(HotReload* hr);
+
+#endif
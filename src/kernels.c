@@ -0,0 +1,531 @@
+#include "kernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef KERNELS_X86
+#include <immintrin.h>
+#endif
+
+static const char* kernels_names[KERNEL_LEVELS] = {"scalar", "sse2", "avx2", "avx512"};
+
+// Référence: même calcul que l'ancienne boucle des colonnes de murs
+static void kernels_light_span_scalar(Uint32* pixels, int count, float r, float g, float b) {
+    for (int i = 0; i < count; i++) {
+        Uint32 color = pixels[i];
+        int fr = (int)(((color >> 24) & 0xFF) * r);
+        int fg = (int)(((color >> 16) & 0xFF) * g);
+        int fb = (int)(((color >> 8) & 0xFF) * b);
+        
+        if (fr > 255) fr = 255;
+        if (fg > 255) fg = 255;
+        if (fb > 255) fb = 255;
+        
+        pixels[i] = ((Uint8)fr << 24) | ((Uint8)fg << 16) | ((Uint8)fb << 8) | (color & 0xFF);
+    }
+}
+
+// Référence: lighting_accumulate sur chaque échantillon (le facteur de visibilité
+// vaut exactement 1 sans ombre, la multiplication ne change alors rien)
+static void kernels_light_samples_scalar(const KernelLight* light, const float* x, const float* y,
+                                         const float* visible, int count, float* r, float* g, float* b) {
+    float radius = sqrtf(light->radius_squared);
+    for (int i = 0; i < count; i++) {
+        float dx = x[i] - light->x;
+        float dy = y[i] - light->y;
+        float distance_squared = dx * dx + dy * dy;
+        if (distance_squared > light->radius_squared || visible[i] == 0.0f) continue;
+        
+        float attenuation = 1.0f - sqrtf(distance_squared) / radius;
+        attenuation = attenuation * attenuation;
+        if (attenuation < MIN_LIGHT_CONTRIBUTION) continue;
+        
+        float contribution = light->scale * attenuation * visible[i];
+        r[i] += light->r * contribution;
+        g[i] += light->g * contribution;
+        b[i] += light->b * contribution;
+    }
+}
+
+#ifdef KERNELS_X86
+// Le minimum à 255 est pris en flottant avant la troncature: même résultat que
+// le scalaire, sans min entier (SSE4.1)
+KERNEL_TARGET("sse2")
+static void kernels_light_span_sse2(Uint32* pixels, int count, float r, float g, float b) {
+    __m128 factor_r = _mm_set1_ps(r);
+    __m128 factor_g = _mm_set1_ps(g);
+    __m128 factor_b = _mm_set1_ps(b);
+    __m128 limit = _mm_set1_ps(255.0f);
+    __m128i byte = _mm_set1_epi32(0xFF);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i color = _mm_loadu_si128((const __m128i*)(pixels + i));
+        __m128 cr = _mm_cvtepi32_ps(_mm_srli_epi32(color, 24));
+        __m128 cg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(color, 16), byte));
+        __m128 cb = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(color, 8), byte));
+        __m128i fr = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(cr, factor_r), limit));
+        __m128i fg = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(cg, factor_g), limit));
+        __m128i fb = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(cb, factor_b), limit));
+        __m128i out = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(fr, 24),
+                                                _mm_slli_epi32(_mm_and_si128(fg, byte), 16)),
+                                   _mm_or_si128(_mm_slli_epi32(_mm_and_si128(fb, byte), 8),
+                                                _mm_and_si128(color, byte)));
+        _mm_storeu_si128((__m128i*)(pixels + i), out);
+    }
+    kernels_light_span_scalar(pixels + i, count - i, r, g, b);
+}
+
+KERNEL_TARGET("avx2")
+static void kernels_light_span_avx2(Uint32* pixels, int count, float r, float g, float b) {
+    __m256 factor_r = _mm256_set1_ps(r);
+    __m256 factor_g = _mm256_set1_ps(g);
+    __m256 factor_b = _mm256_set1_ps(b);
+    __m256 limit = _mm256_set1_ps(255.0f);
+    __m256i byte = _mm256_set1_epi32(0xFF);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i color = _mm256_loadu_si256((const __m256i*)(pixels + i));
+        __m256 cr = _mm256_cvtepi32_ps(_mm256_srli_epi32(color, 24));
+        __m256 cg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(color, 16), byte));
+        __m256 cb = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(color, 8), byte));
+        __m256i fr = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_mul_ps(cr, factor_r), limit));
+        __m256i fg = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_mul_ps(cg, factor_g), limit));
+        __m256i fb = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_mul_ps(cb, factor_b), limit));
+        __m256i out = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(fr, 24),
+                                                      _mm256_slli_epi32(_mm256_and_si256(fg, byte), 16)),
+                                      _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(fb, byte), 8),
+                                                      _mm256_and_si256(color, byte)));
+        _mm256_storeu_si256((__m256i*)(pixels + i), out);
+    }
+    kernels_light_span_sse2(pixels + i, count - i, r, g, b);
+}
+
+KERNEL_TARGET("avx512f")
+static void kernels_light_span_avx512(Uint32* pixels, int count, float r, float g, float b) {
+    __m512 factor_r = _mm512_set1_ps(r);
+    __m512 factor_g = _mm512_set1_ps(g);
+    __m512 factor_b = _mm512_set1_ps(b);
+    __m512 limit = _mm512_set1_ps(255.0f);
+    __m512i byte = _mm512_set1_epi32(0xFF);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i color = _mm512_loadu_si512(pixels + i);
+        __m512 cr = _mm512_cvtepi32_ps(_mm512_srli_epi32(color, 24));
+        __m512 cg = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(color, 16), byte));
+        __m512 cb = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(color, 8), byte));
+        __m512i fr = _mm512_cvttps_epi32(_mm512_min_ps(_mm512_mul_ps(cr, factor_r), limit));
+        __m512i fg = _mm512_cvttps_epi32(_mm512_min_ps(_mm512_mul_ps(cg, factor_g), limit));
+        __m512i fb = _mm512_cvttps_epi32(_mm512_min_ps(_mm512_mul_ps(cb, factor_b), limit));
+        __m512i out = _mm512_or_si512(_mm512_or_si512(_mm512_slli_epi32(fr, 24),
+                                                      _mm512_slli_epi32(_mm512_and_si512(fg, byte), 16)),
+                                      _mm512_or_si512(_mm512_slli_epi32(_mm512_and_si512(fb, byte), 8),
+                                                      _mm512_and_si512(color, byte)));
+        _mm512_storeu_si512(pixels + i, out);
+    }
+    kernels_light_span_avx2(pixels + i, count - i, r, g, b);
+}
+
+// Échantillons écartés: contribution mise à 0, ajouter +0 ne change pas la somme
+KERNEL_TARGET("sse2")
+static void kernels_light_samples_sse2(const KernelLight* light, const float* x, const float* y,
+                                       const float* visible, int count, float* r, float* g, float* b) {
+    __m128 light_x = _mm_set1_ps(light->x);
+    __m128 light_y = _mm_set1_ps(light->y);
+    __m128 radius_squared = _mm_set1_ps(light->radius_squared);
+    __m128 radius = _mm_set1_ps(sqrtf(light->radius_squared));
+    __m128 scale = _mm_set1_ps(light->scale);
+    __m128 color_r = _mm_set1_ps(light->r);
+    __m128 color_g = _mm_set1_ps(light->g);
+    __m128 color_b = _mm_set1_ps(light->b);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 minimum = _mm_set1_ps(MIN_LIGHT_CONTRIBUTION);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), light_x);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), light_y);
+        __m128 distance_squared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 attenuation = _mm_sub_ps(one, _mm_div_ps(_mm_sqrt_ps(distance_squared), radius));
+        attenuation = _mm_mul_ps(attenuation, attenuation);
+        __m128 keep = _mm_and_ps(_mm_cmple_ps(distance_squared, radius_squared),
+                                 _mm_cmpge_ps(attenuation, minimum));
+        __m128 contribution = _mm_and_ps(keep, _mm_mul_ps(_mm_mul_ps(scale, attenuation),
+                                                          _mm_loadu_ps(visible + i)));
+        _mm_storeu_ps(r + i, _mm_add_ps(_mm_loadu_ps(r + i), _mm_mul_ps(color_r, contribution)));
+        _mm_storeu_ps(g + i, _mm_add_ps(_mm_loadu_ps(g + i), _mm_mul_ps(color_g, contribution)));
+        _mm_storeu_ps(b + i, _mm_add_ps(_mm_loadu_ps(b + i), _mm_mul_ps(color_b, contribution)));
+    }
+    kernels_light_samples_scalar(light, x + i, y + i, visible + i, count - i, r + i, g + i, b + i);
+}
+
+KERNEL_TARGET("avx2")
+static void kernels_light_samples_avx2(const KernelLight* light, const float* x, const float* y,
+                                       const float* visible, int count, float* r, float* g, float* b) {
+    __m256 light_x = _mm256_set1_ps(light->x);
+    __m256 light_y = _mm256_set1_ps(light->y);
+    __m256 radius_squared = _mm256_set1_ps(light->radius_squared);
+    __m256 radius = _mm256_set1_ps(sqrtf(light->radius_squared));
+    __m256 scale = _mm256_set1_ps(light->scale);
+    __m256 color_r = _mm256_set1_ps(light->r);
+    __m256 color_g = _mm256_set1_ps(light->g);
+    __m256 color_b = _mm256_set1_ps(light->b);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 minimum = _mm256_set1_ps(MIN_LIGHT_CONTRIBUTION);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), light_x);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), light_y);
+        __m256 distance_squared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 attenuation = _mm256_sub_ps(one, _mm256_div_ps(_mm256_sqrt_ps(distance_squared), radius));
+        attenuation = _mm256_mul_ps(attenuation, attenuation);
+        __m256 keep = _mm256_and_ps(_mm256_cmp_ps(distance_squared, radius_squared, _CMP_LE_OQ),
+                                    _mm256_cmp_ps(attenuation, minimum, _CMP_GE_OQ));
+        __m256 contribution = _mm256_and_ps(keep, _mm256_mul_ps(_mm256_mul_ps(scale, attenuation),
+                                                                _mm256_loadu_ps(visible + i)));
+        _mm256_storeu_ps(r + i, _mm256_add_ps(_mm256_loadu_ps(r + i), _mm256_mul_ps(color_r, contribution)));
+        _mm256_storeu_ps(g + i, _mm256_add_ps(_mm256_loadu_ps(g + i), _mm256_mul_ps(color_g, contribution)));
+        _mm256_storeu_ps(b + i, _mm256_add_ps(_mm256_loadu_ps(b + i), _mm256_mul_ps(color_b, contribution)));
+    }
+    kernels_light_samples_sse2(light, x + i, y + i, visible + i, count - i, r + i, g + i, b + i);
+}
+
+// Produits arrondis à part avant les sommes (pas de FMA): mêmes valeurs que le scalaire
+KERNEL_TARGET("avx512f")
+static void kernels_light_samples_avx512(const KernelLight* light, const float* x, const float* y,
+                                         const float* visible, int count, float* r, float* g, float* b) {
+    const int round = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+    __m512 light_x = _mm512_set1_ps(light->x);
+    __m512 light_y = _mm512_set1_ps(light->y);
+    __m512 radius_squared = _mm512_set1_ps(light->radius_squared);
+    __m512 radius = _mm512_set1_ps(sqrtf(light->radius_squared));
+    __m512 scale = _mm512_set1_ps(light->scale);
+    __m512 color_r = _mm512_set1_ps(light->r);
+    __m512 color_g = _mm512_set1_ps(light->g);
+    __m512 color_b = _mm512_set1_ps(light->b);
+    __m512 one = _mm512_set1_ps(1.0f);
+    __m512 minimum = _mm512_set1_ps(MIN_LIGHT_CONTRIBUTION);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(x + i), light_x);
+        __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(y + i), light_y);
+        __m512 distance_squared = _mm512_add_ps(_mm512_mul_round_ps(dx, dx, round),
+                                                _mm512_mul_round_ps(dy, dy, round));
+        __m512 attenuation = _mm512_sub_ps(one, _mm512_div_ps(_mm512_sqrt_ps(distance_squared), radius));
+        attenuation = _mm512_mul_ps(attenuation, attenuation);
+        __mmask16 keep = _mm512_cmp_ps_mask(distance_squared, radius_squared, _CMP_LE_OQ) &
+                         _mm512_cmp_ps_mask(attenuation, minimum, _CMP_GE_OQ);
+        __m512 contribution = _mm512_maskz_mul_ps(keep, _mm512_mul_ps(scale, attenuation),
+                                                  _mm512_loadu_ps(visible + i));
+        _mm512_storeu_ps(r + i, _mm512_add_ps(_mm512_loadu_ps(r + i),
+                                              _mm512_mul_round_ps(color_r, contribution, round)));
+        _mm512_storeu_ps(g + i, _mm512_add_ps(_mm512_loadu_ps(g + i),
+                                              _mm512_mul_round_ps(color_g, contribution, round)));
+        _mm512_storeu_ps(b + i, _mm512_add_ps(_mm512_loadu_ps(b + i),
+                                              _mm512_mul_round_ps(color_b, contribution, round)));
+    }
+    kernels_light_samples_avx2(light, x + i, y + i, visible + i, count - i, r + i, g + i, b + i);
+}
+#endif
+
+// Registre: une entrée par niveau, chaque variante se rabat sur la précédente
+// pour la fin des tableaux
+static const KernelSet kernels_table[KERNEL_LEVELS] = {
+    {KERNEL_SCALAR, "scalar", NULL, kernels_light_span_scalar, kernels_light_samples_scalar},
+#ifdef KERNELS_X86
+    {KERNEL_SSE2, "sse2", raycaster_cast_packets_sse2, kernels_light_span_sse2, kernels_light_samples_sse2},
+    {KERNEL_AVX2, "avx2", raycaster_cast_packets_avx2, kernels_light_span_avx2, kernels_light_samples_avx2},
+    {KERNEL_AVX512, "avx512", raycaster_cast_packets_avx512, kernels_light_span_avx512,
+     kernels_light_samples_avx512},
+#endif
+};
+
+#if defined(KERNELS_X86) && defined(__SSE2__)
+const KernelSet* kernels = &kernels_table[KERNEL_SSE2];
+#else
+const KernelSet* kernels = &kernels_table[KERNEL_SCALAR];
+#endif
+
+// Jeu composé par kernels_select(KERNEL_AUTO)
+static KernelSet kernels_auto;
+
+int kernels_detect(void) {
+    int level = KERNEL_SCALAR;
+#ifdef KERNELS_X86
+    if (SDL_HasSSE2()) {
+        level = KERNEL_SSE2;
+        if (SDL_HasAVX2()) {
+            level = KERNEL_AVX2;
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+            if (SDL_HasAVX512F()) level = KERNEL_AVX512;
+#endif
+        }
+    }
+#endif
+    return level;
+}
+
+int kernels_parse_level(const char* name) {
+    if (strcmp(name, "auto") == 0) return KERNEL_AUTO;
+    for (int level = 0; level < KERNEL_LEVELS; level++) {
+        if (strcmp(name, kernels_names[level]) == 0) return level;
+    }
+    return -1;
+}
+
+const char* kernels_level_name(int level) {
+    if (level == KERNEL_AUTO) return "auto";
+    return level >= 0 && level < KERNEL_LEVELS ? kernels_names[level] : "?";
+}
+
+static Uint32 kernels_random(Uint32* state) {
+    // xorshift32: entrées de vérification identiques d'un lancement à l'autre
+    Uint32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+#define KERNELS_CHECK_PIXELS 1021    // Pas un multiple des largeurs: les fins sont testées
+#define KERNELS_CHECK_MAP 40
+#define KERNELS_CHECK_WIDTH 203
+#define KERNELS_CHECK_POSES 24
+#define KERNELS_CHECK_SAMPLES 61     // Échantillons d'une tuile, fins comprises
+#define KERNELS_CALIBRATE_PASSES 5
+
+static const float kernels_check_factors[][3] = {
+    {0.0f, 0.0f, 0.0f}, {0.35f, 0.72f, 1.0f}, {1.4f, 2.2f, 0.93f}, {4.0f, 0.01f, 12.5f}
+};
+#define KERNELS_CHECK_FACTORS (int)(sizeof(kernels_check_factors) / sizeof(kernels_check_factors[0]))
+
+// Scène commune à la vérification et au calibrage. Map sans bordure complète:
+// des rayons sortent de la grille (hors map = mur)
+static int kernels_check_map(Map* map) {
+    if (!map_alloc(map, KERNELS_CHECK_MAP, KERNELS_CHECK_MAP)) return 0;
+    Uint32 seed = 0x1B873593;
+    for (int y = 0; y < KERNELS_CHECK_MAP; y++) {
+        for (int x = 0; x < KERNELS_CHECK_MAP; x++) {
+            int wall = (int)(kernels_random(&seed) % 100) < 12;
+            MAP_TILE(map, LAYER_WALL, x, y).type = wall ? TILE_SOLID : TILE_EMPTY;
+        }
+    }
+    return 1;
+}
+
+static void kernels_check_pose(Player* player, Uint32* seed) {
+    float x = 1.0f + (kernels_random(seed) % 1000) * (KERNELS_CHECK_MAP - 2) / 1000.0f;
+    float y = 1.0f + (kernels_random(seed) % 1000) * (KERNELS_CHECK_MAP - 2) / 1000.0f;
+    float angle = (kernels_random(seed) % 3600) * (float)M_PI / 1800.0f;
+    player_init(player, x, y, cosf(angle), sinf(angle));
+}
+
+// Toutes les colonnes d'une pose avec les paquets du jeu, comme raycaster_cast_columns
+static void kernels_cast_row(const KernelSet* set, Player* player, Map* map, float max_distance, RayHit* hits) {
+    int done = set->cast_packets ? set->cast_packets(player, map, 0, KERNELS_CHECK_WIDTH,
+                                                     KERNELS_CHECK_WIDTH, max_distance, hits) : 0;
+    for (int i = done; i < KERNELS_CHECK_WIDTH; i++) {
+        raycaster_cast_column(player, map, i, KERNELS_CHECK_WIDTH, max_distance, &hits[i]);
+    }
+}
+
+static int kernels_check_light_span(const KernelSet* set, Uint32 seed) {
+    Uint32 reference[KERNELS_CHECK_PIXELS];
+    Uint32 pixels[KERNELS_CHECK_PIXELS];
+    for (int f = 0; f < KERNELS_CHECK_FACTORS; f++) {
+        const float* factor = kernels_check_factors[f];
+        for (int i = 0; i < KERNELS_CHECK_PIXELS; i++) {
+            reference[i] = pixels[i] = kernels_random(&seed);
+        }
+        kernels_light_span_scalar(reference, KERNELS_CHECK_PIXELS, factor[0], factor[1], factor[2]);
+        set->light_span(pixels, KERNELS_CHECK_PIXELS, factor[0], factor[1], factor[2]);
+        if (memcmp(reference, pixels, sizeof(pixels)) != 0) return 0;
+    }
+    return 1;
+}
+
+// Échantillons autour de la lumière, en deçà et au-delà du rayon; visibilité
+// complète, nulle ou partielle (valeurs 0-255 des ombres)
+static void kernels_check_samples(KernelLight* light, float* x, float* y, float* visible, Uint32* seed) {
+    light->x = 8.0f + (kernels_random(seed) % 1000) / 1000.0f;
+    light->y = 8.0f + (kernels_random(seed) % 1000) / 1000.0f;
+    float radius = 1.0f + (kernels_random(seed) % 700) / 100.0f;
+    light->radius_squared = radius * radius;
+    light->scale = (kernels_random(seed) % 400) / 100.0f;
+    light->r = (kernels_random(seed) % 100) / 100.0f;
+    light->g = (kernels_random(seed) % 100) / 100.0f;
+    light->b = (kernels_random(seed) % 100) / 100.0f;
+    for (int i = 0; i < KERNELS_CHECK_SAMPLES; i++) {
+        x[i] = (kernels_random(seed) % 16000) / 1000.0f;
+        y[i] = (kernels_random(seed) % 16000) / 1000.0f;
+        int shade = (int)(kernels_random(seed) % 512) - 128;
+        shade = shade < 0 ? 0 : (shade > 255 ? 255 : shade);
+        visible[i] = shade == 255 ? 1.0f : shade * (1.0f / 255.0f);
+    }
+}
+
+static int kernels_check_light_samples(const KernelSet* set, Uint32 seed) {
+    float x[KERNELS_CHECK_SAMPLES], y[KERNELS_CHECK_SAMPLES], visible[KERNELS_CHECK_SAMPLES];
+    float reference[3][KERNELS_CHECK_SAMPLES];
+    float light[3][KERNELS_CHECK_SAMPLES];
+    for (int i = 0; i < KERNELS_CHECK_SAMPLES; i++) {
+        for (int c = 0; c < 3; c++) {
+            reference[c][i] = light[c][i] = 0.1f * c;
+        }
+    }
+    // Plusieurs lumières cumulées sur les mêmes échantillons, comme une tuile
+    for (int n = 0; n < 8; n++) {
+        KernelLight source;
+        kernels_check_samples(&source, x, y, visible, &seed);
+        kernels_light_samples_scalar(&source, x, y, visible, KERNELS_CHECK_SAMPLES,
+                                     reference[0], reference[1], reference[2]);
+        set->light_samples(&source, x, y, visible, KERNELS_CHECK_SAMPLES, light[0], light[1], light[2]);
+    }
+    return memcmp(reference, light, sizeof(light)) == 0;
+}
+
+static int kernels_check_cast(const KernelSet* set, Map* map, Uint32 seed) {
+    static RayHit reference[KERNELS_CHECK_WIDTH];
+    static RayHit hits[KERNELS_CHECK_WIDTH];
+    for (int pose = 0; pose < KERNELS_CHECK_POSES; pose++) {
+        Player player;
+        kernels_check_pose(&player, &seed);
+        float max_distance = pose % 3 == 0 ? 7.5f : 0.0f;
+        
+        memset(reference, 0, sizeof(reference));
+        memset(hits, 0, sizeof(hits));
+        kernels_cast_row(&kernels_table[KERNEL_SCALAR], &player, map, max_distance, reference);
+        kernels_cast_row(set, &player, map, max_distance, hits);
+        if (memcmp(reference, hits, sizeof(hits)) != 0) return 0;
+    }
+    return 1;
+}
+
+// Durée (ms) de la meilleure passe de chaque noyau sur la scène de vérification
+static double kernels_time_cast(const KernelSet* set, Map* map) {
+    static RayHit hits[KERNELS_CHECK_WIDTH];
+    double best = 1e30;
+    for (int pass = 0; pass < KERNELS_CALIBRATE_PASSES; pass++) {
+        Uint32 seed = 0xE6546B64;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int pose = 0; pose < KERNELS_CHECK_POSES; pose++) {
+            Player player;
+            kernels_check_pose(&player, &seed);
+            kernels_cast_row(set, &player, map, 0.0f, hits);
+        }
+        double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static double kernels_time_light_span(const KernelSet* set) {
+    static Uint32 pixels[KERNELS_CHECK_PIXELS];
+    Uint32 seed = 0xCC9E2D51;
+    for (int i = 0; i < KERNELS_CHECK_PIXELS; i++) {
+        pixels[i] = kernels_random(&seed);
+    }
+    double best = 1e30;
+    for (int pass = 0; pass < KERNELS_CALIBRATE_PASSES; pass++) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int repeat = 0; repeat < 64; repeat++) {
+            const float* factor = kernels_check_factors[repeat % KERNELS_CHECK_FACTORS];
+            set->light_span(pixels, KERNELS_CHECK_PIXELS, factor[0], factor[1], factor[2]);
+        }
+        double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static double kernels_time_light_samples(const KernelSet* set) {
+    static float x[KERNELS_CHECK_SAMPLES], y[KERNELS_CHECK_SAMPLES], visible[KERNELS_CHECK_SAMPLES];
+    static float light[3][KERNELS_CHECK_SAMPLES];
+    KernelLight source;
+    Uint32 seed = 0x85EBCA6B;
+    kernels_check_samples(&source, x, y, visible, &seed);
+    double best = 1e30;
+    for (int pass = 0; pass < KERNELS_CALIBRATE_PASSES; pass++) {
+        memset(light, 0, sizeof(light));
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int repeat = 0; repeat < 256; repeat++) {
+            set->light_samples(&source, x, y, visible, KERNELS_CHECK_SAMPLES, light[0], light[1], light[2]);
+        }
+        double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+// Le niveau détecté fixe les variantes permises; chaque noyau prend ensuite la
+// plus rapide mesurée (un jeu d'instructions plus large n'est pas toujours
+// gagnant: rayons divergents, gathers lents selon les CPU)
+static void kernels_calibrate(int best) {
+    Map map;
+    kernels_auto = kernels_table[best];
+    kernels_auto.name = "auto";
+    if (best == KERNEL_SCALAR || !kernels_check_map(&map)) return;
+    
+    double cast_ms = 1e30, light_ms = 1e30, samples_ms = 1e30;
+    int cast_level = best, light_level = best, samples_level = best;
+    for (int level = KERNEL_SCALAR; level <= best; level++) {
+        double ms = kernels_time_cast(&kernels_table[level], &map);
+        if (ms < cast_ms) {
+            cast_ms = ms;
+            cast_level = level;
+        }
+        ms = kernels_time_light_span(&kernels_table[level]);
+        if (ms < light_ms) {
+            light_ms = ms;
+            light_level = level;
+        }
+        ms = kernels_time_light_samples(&kernels_table[level]);
+        if (ms < samples_ms) {
+            samples_ms = ms;
+            samples_level = level;
+        }
+    }
+    kernels_auto.cast_packets = kernels_table[cast_level].cast_packets;
+    kernels_auto.light_span = kernels_table[light_level].light_span;
+    kernels_auto.light_samples = kernels_table[samples_level].light_samples;
+    map_free(&map);
+    printf("Noyaux auto (CPU %s): rayons %s, éclairage %s, échantillons %s\n", kernels_names[best],
+           kernels_names[cast_level], kernels_names[light_level], kernels_names[samples_level]);
+}
+
+int kernels_select(int level) {
+    int best = kernels_detect();
+    if (level == KERNEL_AUTO) {
+        kernels_calibrate(best);
+        kernels = &kernels_auto;
+        return 1;
+    }
+    if (level < 0 || level > best) {
+        printf("Noyaux %s non supportés par ce CPU (meilleur: %s)\n",
+               kernels_level_name(level), kernels_level_name(best));
+        return 0;
+    }
+    kernels = &kernels_table[level];
+    return 1;
+}
+
+int kernels_check(void) {
+    Map map;
+    if (!kernels_check_map(&map)) return KERNEL_LEVELS;
+    
+    int best = kernels_detect();
+    int failures = 0;
+    for (int level = KERNEL_SSE2; level <= best; level++) {
+        const KernelSet* set = &kernels_table[level];
+        int light_ok = kernels_check_light_span(set, 0xCC9E2D51);
+        int samples_ok = kernels_check_light_samples(set, 0x85EBCA6B);
+        int cast_ok = kernels_check_cast(set, &map, 0xE6546B64);
+        printf("Noyaux %-7s éclairage %s  échantillons %s  rayons %s\n", set->name,
+               light_ok ? "✓" : "✗ DIFFÈRE", samples_ok ? "✓" : "✗ DIFFÈRE", cast_ok ? "✓" : "✗ DIFFÈRE");
+        failures += !(light_ok && samples_ok && cast_ok);
+    }
+    if (best == KERNEL_SCALAR) {
+        printf("Noyaux: scalaire seulement, rien à comparer\n");
+    }
+    map_free(&map);
+    return failures;
+}
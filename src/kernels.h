@@ -0,0 +1,78 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "player.h"
+#include "raycaster.h"
+
+// Variantes SIMD compilées dans le même binaire (attribut target de GCC/Clang),
+// choisies au démarrage selon le CPU. Ailleurs, seul le scalaire existe.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Jeux d'instructions, du plus sûr au plus rapide
+enum {
+    KERNEL_SCALAR = 0,
+    KERNEL_SSE2 = 1,
+    KERNEL_AVX2 = 2,
+    KERNEL_AVX512 = 3,
+    KERNEL_LEVELS = 4,
+    KERNEL_AUTO = 4             // Variantes du CPU, la plus rapide mesurée par noyau
+};
+
+// Paquets de rayons des colonnes x .. x + count - 1: renvoie le nombre de
+// colonnes traitées (multiple de la largeur du paquet), le reste est scalaire
+typedef int (*KernelCastPackets)(Player* player, Map* map, int x, int count, int w,
+                                 float max_distance, RayHit* hits);
+
+// Éclairage d'une suite de pixels RGBA8888: canal * facteur tronqué et borné à 255,
+// alpha conservé (colonnes de murs)
+typedef void (*KernelLightSpan)(Uint32* pixels, int count, float r, float g, float b);
+
+// Lumière appliquée à des échantillons de sol (éclairage différé)
+typedef struct {
+    float x, y;
+    float radius_squared;
+    float scale;                    // intensity * anim_scale
+    float r, g, b;
+} KernelLight;
+
+// Une lumière sur count échantillons (x, y, visibilité 0..1 des ombres): ajoute à
+// r, g, b sa contribution, nulle au-delà du rayon et sous MIN_LIGHT_CONTRIBUTION.
+// Même calcul et même arrondi que lighting_calculate_light_fast
+typedef void (*KernelLightSamples)(const KernelLight* light, const float* x, const float* y,
+                                   const float* visible, int count, float* r, float* g, float* b);
+
+typedef struct {
+    int level;                      // KERNEL_* (pour KERNEL_AUTO: niveau du CPU)
+    const char* name;
+    KernelCastPackets cast_packets;   // NULL: rayons un par un
+    KernelLightSpan light_span;
+    KernelLightSamples light_samples;
+} KernelSet;
+
+// Noyaux en service: niveau de base du binaire (SSE2 en x86-64) tant que
+// kernels_select n'a pas été appelé
+extern const KernelSet* kernels;
+
+#ifdef KERNELS_X86
+// Variantes des paquets de rayons (raycaster.c)
+int raycaster_cast_packets_sse2(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits);
+int raycaster_cast_packets_avx2(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits);
+int raycaster_cast_packets_avx512(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits);
+#endif
+
+int kernels_detect(void);                      // Meilleur niveau du CPU (et du binaire)
+int kernels_parse_level(const char* name);     // "auto", "scalar", "sse2"... -1 si inconnu
+const char* kernels_level_name(int level);
+int kernels_select(int level);                 // 0 si le CPU ne le supporte pas
+                                               // (KERNEL_AUTO: calibrage de quelques ms)
+
+// Compare chaque variante supportée au scalaire sur des entrées synthétiques,
+// renvoie le nombre de variantes qui diffèrent
+int kernels_check(void);
+
+#endif
@@ -0,0 +1,93 @@
+#include "latency.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void latency_init(LatencyTracker* lt, int enabled) {
+    memset(lt, 0, sizeof(*lt));
+    lt->enabled = enabled;
+    lt->frequency = SDL_GetPerformanceFrequency();
+    lt->last_report = SDL_GetPerformanceCounter();
+}
+
+// Horodater une entrée clavier (hors répétition automatique)
+void latency_input(LatencyTracker* lt, const SDL_Event* event) {
+    if (!lt->enabled) return;
+    if (event->type != SDL_KEYDOWN && event->type != SDL_KEYUP) return;
+    if (event->key.repeat) return;
+    if (event->key.timestamp <= lt->last_timestamp) return;
+    lt->last_timestamp = event->key.timestamp;
+    if (lt->input_time) return;  // On suit la plus ancienne entrée en attente
+
+    // event->key.timestamp est en ms (SDL_GetTicks): reculer le compteur d'autant
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 age_ms = SDL_GetTicks() - event->key.timestamp;
+    Uint64 age = (Uint64)age_ms * lt->frequency / 1000;
+    lt->input_time = age < now ? now - age : now;
+    lt->consumed = 0;
+}
+
+void latency_mark(LatencyTracker* lt, int stage) {
+    if (!lt->enabled || !lt->input_time) return;
+    if (stage == LATENCY_STAGE_UPDATE) {
+        if (lt->consumed) return;  // Premier tick qui voit l'entrée
+        lt->consumed = 1;
+    } else if (!lt->consumed) {
+        return;
+    }
+    lt->stage_time[stage] = SDL_GetPerformanceCounter();
+}
+
+// L'image contenant l'entrée vient d'être présentée: enregistrer la mesure
+void latency_present(LatencyTracker* lt) {
+    if (!lt->enabled) return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lt->input_time && lt->consumed) {
+        double to_ms = 1000.0 / lt->frequency;
+        Uint64 update = lt->stage_time[LATENCY_STAGE_UPDATE];
+        Uint64 render = lt->stage_time[LATENCY_STAGE_RENDER];
+        int i = lt->next;
+        lt->total_ms[i] = (float)((now - lt->input_time) * to_ms);
+        lt->stage_ms[0][i] = (float)((update - lt->input_time) * to_ms);
+        lt->stage_ms[1][i] = (float)((render - update) * to_ms);
+        lt->stage_ms[2][i] = (float)((now - render) * to_ms);
+        lt->next = (i + 1) % LATENCY_MAX_SAMPLES;
+        if (lt->count < LATENCY_MAX_SAMPLES) lt->count++;
+        lt->new_samples++;
+        lt->input_time = 0;
+        lt->consumed = 0;
+    }
+
+    if (lt->new_samples && (now - lt->last_report) * 1000 / lt->frequency >= LATENCY_REPORT_MS) {
+        latency_report(lt);
+    }
+}
+
+static int latency_compare(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static float latency_mean(const float* values, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += values[i];
+    return count ? (float)(sum / count) : 0.0f;
+}
+
+void latency_report(LatencyTracker* lt) {
+    lt->last_report = SDL_GetPerformanceCounter();
+    if (!lt->enabled || lt->count == 0) return;
+
+    float sorted[LATENCY_MAX_SAMPLES];
+    memcpy(sorted, lt->total_ms, lt->count * sizeof(float));
+    qsort(sorted, lt->count, sizeof(float), latency_compare);
+
+    int n = lt->count;
+    printf("Latence entrée->image (%d mesures): p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms\n",
+           n, sorted[n / 2], sorted[n * 90 / 100], sorted[n * 99 / 100], sorted[n - 1]);
+    printf("  moyenne par étape: entrée->simulation %.1f ms, rendu %.1f ms, présentation %.1f ms\n",
+           latency_mean(lt->stage_ms[0], n), latency_mean(lt->stage_ms[1], n), latency_mean(lt->stage_ms[2], n));
+    lt->new_samples = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <SDL2/SDL.h>
+
+#define LATENCY_MAX_SAMPLES 1024      // Mesures gardées pour les percentiles
+#define LATENCY_REPORT_MS 5000        // Période du rapport dans la console
+
+// Étapes traversées par une entrée avant d'être visible
+enum {
+    LATENCY_STAGE_UPDATE = 0,         // Consommée par player_update (ou échantillonnage tardif)
+    LATENCY_STAGE_RENDER = 1,         // raycaster_render terminé
+    LATENCY_STAGES = 2
+};
+
+// Mesure entrée -> image présentée. L'instant de l'entrée vient du timestamp SDL
+// de l'événement, ramené sur le compteur haute résolution.
+typedef struct {
+    int enabled;
+    Uint64 frequency;
+    Uint64 input_time;                // Plus ancienne entrée pas encore affichée, 0 = aucune
+    Uint64 stage_time[LATENCY_STAGES];
+    int consumed;                     // L'entrée en attente a été prise par la simulation
+    Uint32 last_timestamp;            // Événement déjà horodaté (lu en avance puis dépilé)
+    float total_ms[LATENCY_MAX_SAMPLES];
+    float stage_ms[LATENCY_STAGES + 1][LATENCY_MAX_SAMPLES];  // entrée->update, update->rendu, rendu->présentation
+    int count;                        // Mesures stockées (anneau)
+    int next;
+    int new_samples;
+    Uint64 last_report;
+} LatencyTracker;
+
+void latency_init(LatencyTracker* lt, int enabled);
+void latency_input(LatencyTracker* lt, const SDL_Event* event);
+void latency_mark(LatencyTracker* lt, int stage);
+void latency_present(LatencyTracker* lt);
+void latency_report(LatencyTracker* lt);
+
+#endif
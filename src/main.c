@@ -1,223 +1,474 @@
-#define SDL_MAIN_HANDLED
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
-#include <stdio.h>
-#include <stdbool.h>
-#include <stdlib.h>
-#include <string.h>
-
-#include "map.h"
-#include "player.h"
-#include "textures.h"
-#include "raycaster.h"
-#include "map_loader.h"
-#include "../editor/lighting.h"
-
-int main(int argc, char* argv[]) {
-    // Initialisation SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        printf("Erreur SDL_Init: %s\n", SDL_GetError());
-        return 1;
-    }
-    
-    // Créer la fenêtre redimensionnable
-    SDL_Window* window = SDL_CreateWindow("Moteur 2.5D - Raycaster",
-                                          SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                                          SCREEN_WIDTH, SCREEN_HEIGHT, 
-                                          SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
-    if (!window) {
-        printf("Erreur SDL_CreateWindow: %s\n", SDL_GetError());
-        SDL_Quit();
-        return 1;
-    }
-    
-    // Créer le renderer
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
-        printf("Erreur SDL_CreateRenderer: %s\n", SDL_GetError());
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
-    
-    // Initialiser les modules
-    Map game_map;
-    Player player;
-    TextureManager texture_manager;
-    RaycastRenderer raycaster;
-    LightManager light_manager;
-    
-    // Charger les textures
-    if (textures_init(&texture_manager, renderer) == 0) {
-        printf("Aucune texture chargée, continuation avec des couleurs par défaut\n");
-    }
-    
-    // Initialiser le système d'éclairage
-    lighting_init(&light_manager);
-    
-    // Initialiser le raycaster avec la taille initiale
-    int current_width = SCREEN_WIDTH;
-    int current_height = SCREEN_HEIGHT;
-    if (!raycaster_init(&raycaster, renderer, current_width, current_height)) {
-        printf("Erreur initialisation raycaster\n");
-        textures_destroy(&texture_manager);
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
-    }
-    
-    // Connecter le système d'éclairage au raycaster
-    raycaster_set_lighting(&raycaster, &light_manager);
-    
-    // Système de chargement de maps
-    char current_map[256] = "maps/map.txt";
-    
-    // Charger la map par défaut ou depuis les arguments
-    if (argc > 1) {
-        snprintf(current_map, sizeof(current_map), "maps/%s", argv[1]);
-        if (strstr(argv[1], ".txt") == NULL) {
-            strcat(current_map, ".txt");
-        }
-    }
-    
-    // Charger la map
-    printf("Tentative de chargement: %s\n", current_map);
-    if (!map_load(&game_map, current_map)) {
-        printf("Erreur chargement %s, création d'une map par défaut\n", current_map);
-        map_init(&game_map);
-        
-        // Créer une map de test simple
-        for (int y = 0; y < game_map.height; y++) {
-            for (int x = 0; x < game_map.width; x++) {
-                if (x == 0 || x == game_map.width-1 || y == 0 || y == game_map.height-1) {
-                    // Murs extérieurs
-                    game_map.layers[LAYER_WALL][y][x].type = TILE_SOLID;
-                    game_map.layers[LAYER_WALL][y][x].texture_id = 1;
-                } else if (x == 5 && y > 3 && y < game_map.height-3) {
-                    // Mur intérieur vertical
-                    game_map.layers[LAYER_WALL][y][x].type = TILE_SOLID;
-                    game_map.layers[LAYER_WALL][y][x].texture_id = 2;
-                }
-            }
-        }
-    }
-    
-    // Charger les données d'éclairage
-    char light_filename[512];
-    snprintf(light_filename, sizeof(light_filename), "%s.lights", current_map);
-    if (!lighting_load_from_file(&light_manager, light_filename)) {
-        // Créer quelques lumières blanches faibles par défaut si aucun fichier trouvé
-        printf("Création de lumières par défaut (blanches)\n");
-        lighting_add_light(&light_manager, game_map.width/2.0f, game_map.height/2.0f, 1.0f, 1.0f, 1.0f, 1.5f, 6.0f); // Lumière blanche centrale
-        lighting_add_light(&light_manager, 3.0f, 3.0f, 1.0f, 1.0f, 1.0f, 1.2f, 4.0f);   // Lumière blanche coin
-        if (game_map.width > 15 && game_map.height > 10) {
-            lighting_add_light(&light_manager, game_map.width-3.0f, game_map.height-3.0f, 1.0f, 1.0f, 1.0f, 1.3f, 5.0f); // Lumière blanche autre coin
-        }
-    }
-    
-    // Initialiser le joueur à la position de spawn de la map
-    player_init(&player, game_map.player_start_x, game_map.player_start_y, -1.0f, 0.0f);
-    
-    // Variables pour le timing
-    Uint32 last_time = SDL_GetTicks();
-    bool quit = false;
-    SDL_Event event;
-    
-    printf("Moteur 2.5D démarré!\n");
-    printf("Map chargée: %s (%dx%d)\n", current_map, game_map.width, game_map.height);
-    printf("Player start: %.1f,%.1f\n", game_map.player_start_x, game_map.player_start_y);
-    printf("Système d'éclairage: %d lumières actives\n", light_manager.count);
-    printf("Contrôles:\n");
-    printf("  WASD ou Flèches - Mouvement\n");
-    printf("  Q/E - Mouvement latéral\n");
-    printf("  L - Charger une nouvelle map\n");
-    printf("  O - Toggle éclairage (test performance)\n");
-    printf("  ESC - Quitter\n");
-    printf("Usage: %s [nom_de_map] (sans extension .txt)\n", argv[0]);
-    
-    // Boucle principale
-    while (!quit) {
-        // Calcul du temps écoulé
-        Uint32 current_time = SDL_GetTicks();
-        float delta_time = (current_time - last_time) / 1000.0f;
-        last_time = current_time;
-        
-        // Gestion des événements
-        while (SDL_PollEvent(&event)) {
-            switch (event.type) {
-                case SDL_QUIT:
-                    quit = true;
-                    break;
-                case SDL_KEYDOWN:
-                    if (event.key.keysym.sym == SDLK_ESCAPE) {
-                        quit = true;
-                    } else if (event.key.keysym.sym == SDLK_o) {
-                        // Toggle éclairage on/off pour test de performance
-                        if (raycaster.light_manager) {
-                            raycaster_set_lighting(&raycaster, NULL);
-                            printf("\n💡 Éclairage DÉSACTIVÉ (test performance)\n");
-                        } else {
-                            raycaster_set_lighting(&raycaster, &light_manager);
-                            printf("\n💡 Éclairage ACTIVÉ (%d lumières)\n", light_manager.count);
-                        }
-                    } else if (event.key.keysym.sym == SDLK_l) {
-                        // Charger une nouvelle map
-                        printf("\n=== CHARGEMENT DE MAP ===\n");
-                        
-                        if (map_loader_load_interactive(&game_map, current_map, sizeof(current_map))) {
-                            // Réinitialiser le joueur à la position de spawn de la nouvelle map
-                            player_init(&player, game_map.player_start_x, game_map.player_start_y, -1.0f, 0.0f);
-                            
-                            // Charger les lumières correspondantes
-                            char light_filename[512];
-                            snprintf(light_filename, sizeof(light_filename), "%s.lights", current_map);
-                            lighting_load_from_file(&light_manager, light_filename);
-                        }
-                        
-                        printf("=========================\n\n");
-                    }
-                    break;
-                case SDL_WINDOWEVENT:
-                    if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
-                        // Fenêtre redimensionnée
-                        current_width = event.window.data1;
-                        current_height = event.window.data2;
-                        printf("Fenêtre redimensionnée: %dx%d\n", current_width, current_height);
-                        
-                        // Recréer le raycaster avec la nouvelle taille
-                        raycaster_destroy(&raycaster);
-                        if (!raycaster_init(&raycaster, renderer, current_width, current_height)) {
-                            printf("Erreur lors du redimensionnement\n");
-                            quit = true;
-                        } else {
-                            // Reconnecter le système d'éclairage
-                            raycaster_set_lighting(&raycaster, &light_manager);
-                        }
-                    }
-                    break;
-            }
-        }
-        
-        // Mise à jour du joueur
-        const Uint8* keys = SDL_GetKeyboardState(NULL);
-        player_update(&player, &game_map, keys, delta_time);
-        
-        // Rendu
-        raycaster_render(&raycaster, &player, &game_map, &texture_manager);
-        raycaster_present(&raycaster);
-        
-        // Limiter les FPS
-        SDL_Delay(16); // ~60 FPS
-    }
-    
-    // Nettoyage
-    raycaster_destroy(&raycaster);
-    textures_destroy(&texture_manager);
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
-    
-    printf("Moteur fermé proprement\n");
-    return 0;
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "map.h"
+#include "player.h"
+#include "textures.h"
+#include "raycaster.h"
+#include "map_loader.h"
+#include "pvs.h"
+#include "kernels.h"
+#include "map_catalog.h"
+#include "hot_reload.h"
+#include "game_clock.h"
+#include "latency.h"
+#include "ui.h"
+#include "../editor/lighting.h"
+
+int main(int argc, char* argv[]) {
+    // Options de lancement (avant la création du renderer pour --vsync)
+    bool palette_mode = false;
+    float fog_distance = 0.0f;                     // 0 = distance de vue illimitée
+    float fog_toggle_distance = RAYCASTER_FOG_DEFAULT;
+    bool vsync = false;
+    int max_fps = GAME_FPS_DEFAULT;                // Ignoré avec --vsync
+    bool measure_latency = false;
+    bool late_input = false;                       // Clavier et caméra lus juste avant le rendu
+    bool checker = false;                          // Rendu en damier avec reconstruction temporelle
+    bool adaptive = false;                         // Lancer de rayons adaptatif
+    bool deferred = false;                         // Éclairage différé (G-buffer)
+    int kernel_level = KERNEL_AUTO;                // Variantes SIMD (--kernel)
+    bool kernel_check = false;                     // Comparer les variantes au scalaire au démarrage
+    int test_sprites = 0;                          // Décors de test ajoutés à chaque map (--sprites)
+    
+    // Système de chargement de maps
+    char current_map[512] = "maps/map.txt";
+    
+    // Charger la map par défaut ou depuis les arguments (les options commencent par --)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--8bit") == 0) {
+            palette_mode = true;
+        } else if (strcmp(argv[i], "--fog") == 0 && i + 1 < argc) {
+            fog_distance = (float)atof(argv[++i]);
+            if (fog_distance > 0.0f) fog_toggle_distance = fog_distance;
+        } else if (strcmp(argv[i], "--vsync") == 0) {
+            vsync = true;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            max_fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            measure_latency = true;
+        } else if (strcmp(argv[i], "--late-input") == 0) {
+            late_input = true;
+        } else if (strcmp(argv[i], "--checker") == 0) {
+            checker = true;
+        } else if (strcmp(argv[i], "--adaptive") == 0) {
+            adaptive = true;
+        } else if (strcmp(argv[i], "--deferred") == 0) {
+            deferred = true;
+        } else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            kernel_level = kernels_parse_level(argv[++i]);
+            if (kernel_level < 0) {
+                printf("Noyaux inconnus: %s (auto, scalar, sse2, avx2, avx512)\n", argv[i]);
+                kernel_level = KERNEL_AUTO;
+            }
+        } else if (strcmp(argv[i], "--kernel-check") == 0) {
+            kernel_check = true;
+        } else if (strcmp(argv[i], "--sprites") == 0 && i + 1 < argc) {
+            test_sprites = atoi(argv[++i]);
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            printf("Option inconnue: %s\n", argv[i]);
+        } else {
+            snprintf(current_map, sizeof(current_map), "maps/%s", argv[i]);
+            if (strstr(argv[i], ".txt") == NULL) {
+                strcat(current_map, ".txt");
+            }
+        }
+    }
+    
+    // Noyaux SIMD du CPU; une variante qui diffère du scalaire n'est pas utilisée
+    if (kernel_check && kernels_check() > 0) {
+        printf("Variantes SIMD incorrectes: noyaux scalaires\n");
+        kernel_level = KERNEL_SCALAR;
+    }
+    if (!kernels_select(kernel_level)) {
+        kernels_select(KERNEL_AUTO);
+    } else if (kernel_level != KERNEL_AUTO) {
+        printf("Noyaux imposés: %s\n", kernels->name);
+    }
+    
+    // Initialisation SDL
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("Erreur SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    
+    // Créer la fenêtre redimensionnable
+    SDL_Window* window = SDL_CreateWindow("Moteur 2.5D - Raycaster",
+                                          SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                          SCREEN_WIDTH, SCREEN_HEIGHT, 
+                                          SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+    if (!window) {
+        printf("Erreur SDL_CreateWindow: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    
+    // Créer le renderer
+    Uint32 renderer_flags = SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, renderer_flags);
+    if (!renderer) {
+        printf("Erreur SDL_CreateRenderer: %s\n", SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    
+    // Initialiser les modules
+    Map* game_map = NULL;
+    Player player;
+    TextureManager texture_manager;
+    RaycastRenderer raycaster;
+    LightManager* light_manager = NULL;
+    MapLoadJob load_job;
+    MapCatalog catalog;
+    MapPicker picker;
+    HotReload hot_reload;
+    Palette* palette = NULL;      // Construite au premier passage en mode 8 bits
+    
+    // Indexer les maps une fois, le catalogue suit ensuite les changements du dossier
+    map_loader_job_init(&load_job);
+    map_catalog_init(&catalog, "maps");
+    ui_picker_init(&picker, &catalog);
+    
+    // Charger les textures
+    if (textures_init(&texture_manager, renderer) == 0) {
+        printf("Aucune texture chargée, continuation avec des couleurs par défaut\n");
+    }
+    
+    // Initialiser le raycaster avec la taille initiale
+    int current_width = SCREEN_WIDTH;
+    int current_height = SCREEN_HEIGHT;
+    if (!raycaster_init(&raycaster, renderer, current_width, current_height)) {
+        printf("Erreur initialisation raycaster\n");
+        textures_destroy(&texture_manager);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    
+    // Charger le niveau initial (map + lumières)
+    printf("Tentative de chargement: %s\n", current_map);
+    if (!map_loader_load_level(current_map, &game_map, &light_manager)) {
+        printf("Erreur chargement %s, création d'une map par défaut\n", current_map);
+        game_map = malloc(sizeof(Map));
+        light_manager = malloc(sizeof(LightManager));
+        if (!game_map || !light_manager || !map_init(game_map)) {
+            printf("Erreur allocation map par défaut\n");
+            return 1;
+        }
+        
+        // Créer une map de test simple
+        for (int y = 0; y < game_map->height; y++) {
+            for (int x = 0; x < game_map->width; x++) {
+                if (x == 0 || x == game_map->width-1 || y == 0 || y == game_map->height-1) {
+                    // Murs extérieurs
+                    MAP_TILE(game_map, LAYER_WALL, x, y).type = TILE_SOLID;
+                    MAP_TILE(game_map, LAYER_WALL, x, y).texture_id = 1;
+                } else if (x == 5 && y > 3 && y < game_map->height-3) {
+                    // Mur intérieur vertical
+                    MAP_TILE(game_map, LAYER_WALL, x, y).type = TILE_SOLID;
+                    MAP_TILE(game_map, LAYER_WALL, x, y).texture_id = 2;
+                }
+            }
+        }
+        
+        lighting_init(light_manager);
+        map_loader_default_lights(light_manager, game_map);
+        map_loader_attach_occluders(game_map, light_manager);
+        map_loader_attach_pvs(game_map);
+    }
+    map_loader_add_test_entities(game_map, test_sprites, texture_manager.count);
+    
+    // Connecter le système d'éclairage au raycaster
+    raycaster_set_lighting(&raycaster, light_manager);
+    
+    // Distance de vue limitée par le brouillard
+    raycaster_set_fog(&raycaster, fog_distance, RAYCASTER_FOG_COLOR);
+    
+    // Rendu en damier demandé au lancement
+    if (checker) {
+        checker = raycaster_set_checker(&raycaster, 1);
+    }
+    
+    // Lancer adaptatif demandé au lancement
+    raycaster_set_adaptive(&raycaster, adaptive ? RAYCASTER_ADAPTIVE_STEP : 0);
+    
+    // Éclairage différé demandé au lancement
+    if (deferred) {
+        deferred = raycaster_set_deferred(&raycaster, 1);
+    }
+    
+    // Mode 8 bits demandé au lancement
+    if (palette_mode) {
+        palette = palette_create(&texture_manager);
+        palette_mode = palette != NULL;
+        raycaster_set_palette(&raycaster, palette_mode ? palette : NULL);
+    }
+    
+    // Surveiller la map courante, ses lumières et les textures pour le hot-reload
+    hot_reload_init(&hot_reload, current_map);
+    
+    // Initialiser le joueur à la position de spawn de la map
+    player_init(&player, game_map->player_start_x, game_map->player_start_y, -1.0f, 0.0f);
+    
+    // Simulation à pas fixe; le rendu interpole entre les deux derniers ticks
+    GameClock game_clock;
+    game_clock_init(&game_clock, GAME_TICK_RATE, vsync ? 0 : max_fps);
+    Player previous_player = player;
+    Player render_player;
+    LatencyTracker latency;
+    latency_init(&latency, measure_latency);
+    bool quit = false;
+    SDL_Event event;
+    
+    printf("Moteur 2.5D démarré!\n");
+    printf("Map chargée: %s (%dx%d)\n", current_map, game_map->width, game_map->height);
+    printf("Player start: %.1f,%.1f\n", game_map->player_start_x, game_map->player_start_y);
+    printf("Système d'éclairage: %d lumières actives\n", light_manager->count);
+    printf("Contrôles:\n");
+    printf("  WASD ou Flèches - Mouvement\n");
+    printf("  Q/E - Mouvement latéral\n");
+    printf("  L - Sélecteur de maps (chargement en arrière-plan)\n");
+    printf("  O - Toggle éclairage (test performance)\n");
+    printf("  P - Toggle mode 8 bits palettisé\n");
+    printf("  F - Toggle brouillard / distance de vue limitée\n");
+    printf("  C - Toggle rendu en damier (reconstruction temporelle)\n");
+    printf("  G - Toggle éclairage différé (G-buffer, tuiles d'écran)\n");
+    printf("  ESC - Quitter\n");
+    printf("Usage: %s [nom_de_map] [--8bit] [--fog distance] [--fps N | --vsync] [--latency] [--late-input] [--checker] [--adaptive] [--deferred] [--kernel auto|scalar|sse2|avx2|avx512] [--kernel-check] [--sprites N] (nom sans extension .txt)\n", argv[0]);
+    
+    // Boucle principale
+    while (!quit) {
+        // Nombre de ticks de simulation dus depuis la frame précédente
+        int ticks = game_clock_begin_frame(&game_clock);
+        
+        // Appliquer les changements du dossier maps/ signalés par le système
+        map_catalog_poll(&catalog);
+        
+        // Récupérer un niveau chargé en arrière-plan: simple échange de pointeurs
+        Map* loaded_map;
+        LightManager* loaded_lights;
+        if (map_loader_job_poll(&load_job, &loaded_map, &loaded_lights) == 1) {
+            Map* old_map = game_map;
+            LightManager* old_lights = light_manager;
+            
+            game_map = loaded_map;
+            light_manager = loaded_lights;
+            if (raycaster.light_manager) {
+                raycaster_set_lighting(&raycaster, light_manager);
+            }
+            snprintf(current_map, sizeof(current_map), "%s", load_job.path);
+            hot_reload_set_map(&hot_reload, current_map);
+            
+            // Réinitialiser le joueur à la position de spawn de la nouvelle map
+            player_init(&player, game_map->player_start_x, game_map->player_start_y, -1.0f, 0.0f);
+            previous_player = player;  // Pas d'interpolation à travers la téléportation
+            raycaster_reset_history(&raycaster);  // Ni de reprojection depuis l'ancienne map
+            map_loader_job_release(&load_job, old_map, old_lights);  // Libéré hors de la frame
+            
+            printf("✓ Map '%s' chargée (%dx%d, %d lumières)\n", current_map,
+                   game_map->width, game_map->height, light_manager->count);
+        }
+        
+        // Hot-reload: n'appliquer que les tiles, lumières et textures modifiées
+        HotReloadResult reload;
+        if (!map_loader_job_busy(&load_job) &&
+            hot_reload_poll(&hot_reload, game_map, light_manager, &texture_manager, &reload)) {
+            if (reload.flags & HOT_RELOAD_NEEDS_FULL) {
+                // Dimensions changées: rechargement complet en arrière-plan
+                printf("Hot-reload: taille de %s modifiée, rechargement complet\n", current_map);
+                map_loader_job_start(&load_job, current_map, test_sprites, texture_manager.count);
+            }
+            if ((reload.flags & HOT_RELOAD_TEXTURES) && palette) {
+                // Réindexer avec la palette existante (pas de nouvelle quantification)
+                palette_index_textures(palette, &texture_manager);
+            }
+            if (reload.flags & (HOT_RELOAD_TILES | HOT_RELOAD_LIGHTS | HOT_RELOAD_TEXTURES)) {
+                printf("Hot-reload: %d tiles", reload.changed_tiles);
+                if (reload.changed_tiles > 0) {
+                    printf(" (zone %d,%d-%d,%d)", reload.dirty_x0, reload.dirty_y0,
+                           reload.dirty_x1, reload.dirty_y1);
+                }
+                printf(", %d lumières, %d textures en %.2f ms\n",
+                       reload.changed_lights, reload.changed_textures, reload.ms);
+            }
+        }
+        
+        // Gestion des événements
+        while (SDL_PollEvent(&event)) {
+            latency_input(&latency, &event);
+            switch (event.type) {
+                case SDL_QUIT:
+                    quit = true;
+                    break;
+                case SDL_KEYDOWN:
+                    if (picker.open) {
+                        // Le sélecteur capture le clavier tant qu'il est ouvert
+                        if (ui_picker_handle_key(&picker, event.key.keysym.sym) == UI_PICKER_CHOSEN) {
+                            char path[512];
+                            map_loader_build_path(ui_picker_selected_name(&picker), path, sizeof(path));
+                            printf("\n=== CHARGEMENT DE MAP: %s ===\n", path);
+                            map_loader_job_start(&load_job, path, test_sprites, texture_manager.count);
+                        }
+                    } else if (event.key.keysym.sym == SDLK_ESCAPE) {
+                        quit = true;
+                    } else if (event.key.keysym.sym == SDLK_o) {
+                        // Toggle éclairage on/off pour test de performance
+                        if (raycaster.light_manager) {
+                            raycaster_set_lighting(&raycaster, NULL);
+                            printf("\n💡 Éclairage DÉSACTIVÉ (test performance)\n");
+                        } else {
+                            raycaster_set_lighting(&raycaster, light_manager);
+                            printf("\n💡 Éclairage ACTIVÉ (%d lumières)\n", light_manager->count);
+                        }
+                    } else if (event.key.keysym.sym == SDLK_p) {
+                        // Toggle rendu 8 bits (palette partagée + tables d'éclairage)
+                        if (!palette) {
+                            palette = palette_create(&texture_manager);
+                        }
+                        palette_mode = palette && !palette_mode;
+                        raycaster_set_palette(&raycaster, palette_mode ? palette : NULL);
+                        printf("\n🎨 Mode 8 bits %s\n", palette_mode ? "ACTIVÉ" : "DÉSACTIVÉ");
+                    } else if (event.key.keysym.sym == SDLK_f) {
+                        // Toggle brouillard: les rayons s'arrêtent à la distance de vue
+                        fog_distance = fog_distance > 0.0f ? 0.0f : fog_toggle_distance;
+                        raycaster_set_fog(&raycaster, fog_distance, RAYCASTER_FOG_COLOR);
+                        if (fog_distance > 0.0f) {
+                            printf("\n🌫 Brouillard ACTIVÉ (distance %.1f)\n", fog_distance);
+                        } else {
+                            printf("\n🌫 Brouillard DÉSACTIVÉ\n");
+                        }
+                    } else if (event.key.keysym.sym == SDLK_c) {
+                        // Toggle rendu en damier: moitié du sol/plafond ombrée par frame
+                        checker = !checker && raycaster_set_checker(&raycaster, 1);
+                        if (!checker) {
+                            raycaster_set_checker(&raycaster, 0);
+                        }
+                        printf("\n▦ Rendu en damier %s\n", checker ? "ACTIVÉ" : "DÉSACTIVÉ");
+                    } else if (event.key.keysym.sym == SDLK_r) {
+                        // Toggle lancer adaptatif: colonnes déduites entre rayons d'une même face
+                        adaptive = !adaptive;
+                        raycaster_set_adaptive(&raycaster, adaptive ? RAYCASTER_ADAPTIVE_STEP : 0);
+                        printf("\n⟂ Lancer de rayons adaptatif %s\n", adaptive ? "ACTIVÉ" : "DÉSACTIVÉ");
+                    } else if (event.key.keysym.sym == SDLK_g) {
+                        // Toggle éclairage différé: géométrie puis éclairage par tuiles d'écran
+                        deferred = !deferred && raycaster_set_deferred(&raycaster, 1);
+                        if (!deferred) {
+                            raycaster_set_deferred(&raycaster, 0);
+                        }
+                        printf("\n▤ Éclairage différé %s\n", deferred ? "ACTIVÉ" : "DÉSACTIVÉ");
+                    } else if (event.key.keysym.sym == SDLK_l) {
+                        // Ouvrir le sélecteur de maps (sans bloquer le rendu)
+                        if (map_loader_job_busy(&load_job)) {
+                            printf("Chargement déjà en cours: %s\n", load_job.path);
+                        } else {
+                            ui_picker_open(&picker, current_map);
+                        }
+                    }
+                    break;
+                case SDL_WINDOWEVENT:
+                    if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
+                        // Fenêtre redimensionnée
+                        current_width = event.window.data1;
+                        current_height = event.window.data2;
+                        printf("Fenêtre redimensionnée: %dx%d\n", current_width, current_height);
+                        
+                        // Recréer le raycaster avec la nouvelle taille
+                        raycaster_destroy(&raycaster);
+                        if (!raycaster_init(&raycaster, renderer, current_width, current_height)) {
+                            printf("Erreur lors du redimensionnement\n");
+                            quit = true;
+                        } else {
+                            // Reconnecter le système d'éclairage et la palette
+                            raycaster_set_lighting(&raycaster, light_manager);
+                            raycaster_set_palette(&raycaster, palette_mode ? palette : NULL);
+                            raycaster_set_fog(&raycaster, fog_distance, RAYCASTER_FOG_COLOR);
+                            if (checker) {
+                                checker = raycaster_set_checker(&raycaster, 1);
+                            }
+                            raycaster_set_adaptive(&raycaster, adaptive ? RAYCASTER_ADAPTIVE_STEP : 0);
+                            if (deferred) {
+                                deferred = raycaster_set_deferred(&raycaster, 1);
+                            }
+                        }
+                    }
+                    break;
+            }
+        }
+        
+        // Simulation du joueur à pas fixe (le sélecteur ouvert garde le clavier)
+        const Uint8* keys = SDL_GetKeyboardState(NULL);
+        for (int t = 0; t < ticks; t++) {
+            previous_player = player;
+            if (!picker.open) {
+                player_update(&player, game_map, keys, (float)game_clock.tick);
+                latency_mark(&latency, LATENCY_STAGE_UPDATE);
+            }
+        }
+        if (late_input && !picker.open) {
+            // Échantillonnage tardif: clavier relu maintenant, caméra avancée depuis le dernier
+            // tick au lieu d'être interpolée entre les deux derniers (jusqu'à un tick de moins)
+            SDL_Event pending[16];
+            SDL_PumpEvents();
+            int pending_count = SDL_PeepEvents(pending, 16, SDL_PEEKEVENT, SDL_KEYDOWN, SDL_KEYUP);
+            for (int i = 0; i < pending_count; i++) {
+                latency_input(&latency, &pending[i]);
+            }
+            render_player = player;
+            player_update(&render_player, game_map, SDL_GetKeyboardState(NULL),
+                          game_clock_alpha(&game_clock) * (float)game_clock.tick);
+            latency_mark(&latency, LATENCY_STAGE_UPDATE);
+        } else {
+            player_interpolate(&previous_player, &player, game_clock_alpha(&game_clock), &render_player);
+        }
+        
+        // Lumières animées au temps de la simulation: seules celles dont l'intensité
+        // change sont retouchées
+        lighting_animate(light_manager, game_clock_time(&game_clock));
+        
+        // Culling des lumières hors du champ de vue pour cette frame
+        lighting_cull_view(light_manager, render_player.x, render_player.y, render_player.dir_x, render_player.dir_y,
+                           render_player.plane_x, render_player.plane_y, raycaster.fog_distance);
+        pvs_prepare(game_map->pvs, game_map, render_player.x, render_player.y);
+        pvs_cull_lights(game_map->pvs, light_manager, render_player.x, render_player.y);
+        
+        // Rendu
+        raycaster_render(&raycaster, &render_player, game_map, &texture_manager);
+        latency_mark(&latency, LATENCY_STAGE_RENDER);
+        if (picker.open || map_loader_job_busy(&load_job)) {
+            // Les overlays dessinent en 32 bits: convertir l'image 8 bits d'abord
+            raycaster_expand(&raycaster);
+        }
+        ui_picker_draw(&picker, raycaster.screen_buffer, raycaster.screen_width, raycaster.screen_height);
+        if (map_loader_job_busy(&load_job)) {
+            ui_draw_loading(raycaster.screen_buffer, raycaster.screen_width, raycaster.screen_height, load_job.path);
+        }
+        raycaster_present(&raycaster);
+        latency_present(&latency);
+        
+        // Limiter les FPS: échéance précise (le temps de la frame est déduit), rien avec vsync
+        game_clock_end_frame(&game_clock);
+    }
+    
+    // Nettoyage
+    latency_report(&latency);
+    map_loader_job_destroy(&load_job);
+    map_catalog_destroy(&catalog);
+    hot_reload_destroy(&hot_reload);
+    palette_destroy(palette);
+    map_loader_free_level(game_map, light_manager);
+    raycaster_destroy(&raycaster);
+    textures_destroy(&texture_manager);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    
+    printf("Moteur fermé proprement\n");
+    return 0;
 }
\ No newline at end of file
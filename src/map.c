@@ -1,130 +1,317 @@
-#include "map.h"
-#include <stdio.h>
-#include <string.h>
-
-void map_init(Map* map) {
-    map->width = MAP_WIDTH_DEFAULT;
-    map->height = MAP_HEIGHT_DEFAULT;
-    map->player_start_x = MAP_WIDTH_DEFAULT / 2.0f;
-    map->player_start_y = MAP_HEIGHT_DEFAULT / 2.0f;
-    
-    // Initialiser toutes les tiles à vide
-    for (int layer = 0; layer < NUM_LAYERS; layer++) {
-        for (int y = 0; y < MAP_HEIGHT_MAX; y++) {
-            for (int x = 0; x < MAP_WIDTH_MAX; x++) {
-                map->layers[layer][y][x].type = TILE_EMPTY;
-                map->layers[layer][y][x].texture_id = 0;
-            }
-        }
-    }
-}
-
-int map_load(Map* map, const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("Erreur : impossible d'ouvrir %s pour lecture\n", filename);
-        return 0;
-    }
-    
-    map_init(map);
-    
-    char line[256];
-    // Lire la première ligne pour vérifier s'il y a une taille
-    if (fgets(line, sizeof(line), file)) {
-        if (strncmp(line, "SIZE", 4) == 0) {
-            int w, h;
-            if (sscanf(line, "SIZE %d %d", &w, &h) == 2) {
-                if (w > 0 && w <= MAP_WIDTH_MAX && h > 0 && h <= MAP_HEIGHT_MAX) {
-                    map->width = w;
-                    map->height = h;
-                    printf("Taille de map chargée: %dx%d\n", map->width, map->height);
-                } else {
-                    printf("Taille invalide dans le fichier, utilisation par défaut\n");
-                }
-            }
-        } else {
-            // Ancien format sans taille, revenir au début du fichier
-            rewind(file);
-        }
-    }
-    
-    // Lire le player start si présent
-    if (fgets(line, sizeof(line), file)) {
-        if (strncmp(line, "PLAYER_START", 12) == 0) {
-            float px, py;
-            if (sscanf(line, "PLAYER_START %f %f", &px, &py) == 2) {
-                map->player_start_x = px;
-                map->player_start_y = py;
-                printf("Player start chargé: %.1f,%.1f\n", map->player_start_x, map->player_start_y);
-            }
-        } else {
-            // Pas de player start, revenir en arrière et utiliser défaut
-            fseek(file, -strlen(line), SEEK_CUR);
-        }
-    }
-    
-    // Charger les données de la map
-    for (int y = 0; y < map->height; y++) {
-        for (int x = 0; x < map->width; x++) {
-            int floor_type, floor_tex, ceiling_type, ceiling_tex, wall_type, wall_tex;
-            
-            // Lire les données pour les 3 layers : floor, ceiling, wall
-            if (fscanf(file, "%d,%d %d,%d %d,%d", 
-                      &floor_type, &floor_tex, 
-                      &ceiling_type, &ceiling_tex, 
-                      &wall_type, &wall_tex) == 6) {
-                
-                // Floor layer
-                map->layers[LAYER_FLOOR][y][x].type = floor_type;
-                map->layers[LAYER_FLOOR][y][x].texture_id = floor_tex;
-                
-                // Ceiling layer
-                map->layers[LAYER_CEILING][y][x].type = ceiling_type;
-                map->layers[LAYER_CEILING][y][x].texture_id = ceiling_tex;
-                
-                // Wall layer
-                map->layers[LAYER_WALL][y][x].type = wall_type;
-                map->layers[LAYER_WALL][y][x].texture_id = wall_tex;
-            } else {
-                // En cas d'erreur de lecture, initialiser à vide
-                for (int l = 0; l < NUM_LAYERS; l++) {
-                    map->layers[l][y][x].type = TILE_EMPTY;
-                    map->layers[l][y][x].texture_id = 0;
-                }
-            }
-        }
-    }
-    
-    fclose(file);
-    printf("Map chargée depuis %s (%dx%d, start: %.1f,%.1f)\n", 
-           filename, map->width, map->height, map->player_start_x, map->player_start_y);
-    return 1;
-}
-
-int map_is_wall(Map* map, int x, int y) {
-    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
-        return 1; // Considérer les bordures comme des murs
-    }
-    return map->layers[LAYER_WALL][y][x].type == TILE_SOLID;
-}
-
-int map_get_wall_texture(Map* map, int x, int y) {
-    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
-        return 0;
-    }
-    return map->layers[LAYER_WALL][y][x].texture_id;
-}
-
-int map_get_floor_texture(Map* map, int x, int y) {
-    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
-        return 0;
-    }
-    return map->layers[LAYER_FLOOR][y][x].texture_id;
-}
-
-int map_get_ceiling_texture(Map* map, int x, int y) {
-    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
-        return 0;
-    }
-    return map->layers[LAYER_CEILING][y][x].texture_id;
-}
\ No newline at end of file
+#include "map.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int map_alloc(Map* map, int width, int height) {
+    map->width = width;
+    map->height = height;
+    map->pvs = NULL;
+    map->entities = NULL;
+
+    // Un seul bloc pour les 3 layers, initialisé à vide (TILE_EMPTY, texture 0)
+    size_t cells = (size_t)width * height;
+    Tile* tiles = calloc(cells * NUM_LAYERS, sizeof(Tile));
+    if (!tiles) {
+        printf("Erreur allocation map %dx%d\n", width, height);
+        for (int layer = 0; layer < NUM_LAYERS; layer++) {
+            map->layers[layer] = NULL;
+        }
+        return 0;
+    }
+
+    for (int layer = 0; layer < NUM_LAYERS; layer++) {
+        map->layers[layer] = tiles + cells * layer;
+    }
+    return 1;
+}
+
+void map_free(Map* map) {
+    free(map->layers[0]);
+    for (int layer = 0; layer < NUM_LAYERS; layer++) {
+        map->layers[layer] = NULL;
+    }
+}
+
+int map_init(Map* map) {
+    map->player_start_x = MAP_WIDTH_DEFAULT / 2.0f;
+    map->player_start_y = MAP_HEIGHT_DEFAULT / 2.0f;
+    return map_alloc(map, MAP_WIDTH_DEFAULT, MAP_HEIGHT_DEFAULT);
+}
+
+static void map_reader_error(MapReader* reader, const char* message) {
+    printf("Erreur %s:%d:%d: %s\n", reader->source_name, reader->line,
+           (int)(reader->p - reader->line_start) + 1, message);
+}
+
+// Sauter espaces et fins de ligne en comptant les lignes
+static void map_reader_skip_space(MapReader* reader) {
+    while (reader->p < reader->end) {
+        char c = *reader->p;
+        if (c == '\n') {
+            reader->line++;
+            reader->line_start = reader->p + 1;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            break;
+        }
+        reader->p++;
+    }
+}
+
+// Entier signé, erreur signalée à la position du nombre (what: champ attendu)
+static int map_reader_int(MapReader* reader, int* out, const char* what) {
+    const char* p = reader->p;
+    int negative = 0;
+    if (p < reader->end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    if (p >= reader->end || *p < '0' || *p > '9') {
+        char message[64];
+        snprintf(message, sizeof(message), "entier attendu (%s)", what);
+        map_reader_error(reader, message);
+        return 0;
+    }
+
+    int value = 0;
+    while (p < reader->end && *p >= '0' && *p <= '9') {
+        int digit = *p - '0';
+        if (value > (INT_MAX - digit) / 10) {
+            char message[64];
+            snprintf(message, sizeof(message), "entier trop grand (%s)", what);
+            map_reader_error(reader, message);
+            return 0;
+        }
+        value = value * 10 + digit;
+        p++;
+    }
+    reader->p = p;
+    *out = negative ? -value : value;
+    return 1;
+}
+
+// Lire un couple "type,texture"
+static int map_reader_pair(MapReader* reader, Tile* tile) {
+    if (!map_reader_int(reader, &tile->type, "type")) {
+        return 0;
+    }
+    if (reader->p >= reader->end || *reader->p != ',') {
+        map_reader_error(reader, "',' attendue");
+        return 0;
+    }
+    reader->p++;
+    if (!map_reader_int(reader, &tile->texture_id, "texture")) {
+        return 0;
+    }
+    return 1;
+}
+
+// Lire une ligne d'en-tête "MOT ..." si elle est présente
+static const char* map_reader_header(MapReader* reader, const char* keyword) {
+    size_t len = strlen(keyword);
+    if ((size_t)(reader->end - reader->p) < len || strncmp(reader->p, keyword, len) != 0) {
+        return NULL;
+    }
+
+    const char* args = reader->p + len;
+    while (reader->p < reader->end && *reader->p != '\n') {
+        reader->p++;
+    }
+    map_reader_skip_space(reader);
+    return args;
+}
+
+void map_reader_open(MapReader* reader, const char* data, size_t size, const char* source_name) {
+    reader->p = data;
+    reader->end = data + size;
+    reader->line_start = data;
+    reader->line = 1;
+    reader->source_name = source_name;
+    reader->width = MAP_WIDTH_DEFAULT;
+    reader->height = MAP_HEIGHT_DEFAULT;
+    reader->player_start_x = MAP_WIDTH_DEFAULT / 2.0f;
+    reader->player_start_y = MAP_HEIGHT_DEFAULT / 2.0f;
+    reader->cell = 0;
+    reader->truncated = 0;
+    reader->failed = 0;
+
+    map_reader_skip_space(reader);
+
+    // En-tête optionnel: taille puis player start
+    const char* args = map_reader_header(reader, "SIZE");
+    if (args) {
+        int w, h;
+        if (sscanf(args, "%d %d", &w, &h) == 2 &&
+            w > 0 && w <= MAP_WIDTH_MAX && h > 0 && h <= MAP_HEIGHT_MAX) {
+            reader->width = w;
+            reader->height = h;
+        } else {
+            printf("Taille invalide dans %s, utilisation par défaut\n", source_name);
+        }
+    }
+
+    args = map_reader_header(reader, "PLAYER_START");
+    if (args) {
+        float px, py;
+        if (sscanf(args, "%f %f", &px, &py) == 2) {
+            reader->player_start_x = px;
+            reader->player_start_y = py;
+        }
+    }
+}
+
+// Données: "floor_type,floor_tex ceiling_type,ceiling_tex wall_type,wall_tex" par cellule
+int map_reader_next(MapReader* reader, Tile* tiles) {
+    if (reader->failed || reader->cell >= (size_t)reader->width * reader->height) {
+        return 0;
+    }
+    reader->cell++;
+
+    if (!reader->truncated) {
+        map_reader_skip_space(reader);
+        if (reader->p >= reader->end) {
+            // Fichier tronqué: les cellules restantes restent vides
+            map_reader_error(reader, "fin de fichier, cellules manquantes laissées vides");
+            reader->truncated = 1;
+        }
+    }
+    if (reader->truncated) {
+        memset(tiles, 0, sizeof(Tile) * NUM_LAYERS);
+        return 1;
+    }
+
+    for (int layer = 0; layer < NUM_LAYERS; layer++) {
+        if (layer > 0) map_reader_skip_space(reader);
+        if (!map_reader_pair(reader, &tiles[layer])) {
+            reader->failed = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int map_parse(Map* map, const char* data, size_t size, const char* source_name) {
+    MapReader reader;
+    map_reader_open(&reader, data, size, source_name);
+
+    if (!map_alloc(map, reader.width, reader.height)) {
+        return 0;
+    }
+    map->player_start_x = reader.player_start_x;
+    map->player_start_y = reader.player_start_y;
+
+    Tile* floor_tiles = map->layers[LAYER_FLOOR];
+    Tile* ceiling_tiles = map->layers[LAYER_CEILING];
+    Tile* wall_tiles = map->layers[LAYER_WALL];
+    Tile tiles[NUM_LAYERS];
+
+    for (size_t i = 0; !reader.truncated && map_reader_next(&reader, tiles); i++) {
+        floor_tiles[i] = tiles[LAYER_FLOOR];
+        ceiling_tiles[i] = tiles[LAYER_CEILING];
+        wall_tiles[i] = tiles[LAYER_WALL];
+    }
+
+    if (reader.failed) {
+        map_free(map);
+        return 0;
+    }
+    return 1;
+}
+
+char* map_read_file(const char* filename, size_t* out_size) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    // Lire le fichier entier en une fois
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char* data = malloc((size_t)size + 1);
+    if (!data) {
+        printf("Erreur : allocation de %ld octets pour %s\n", size, filename);
+        fclose(file);
+        return NULL;
+    }
+
+    *out_size = fread(data, 1, (size_t)size, file);
+    fclose(file);
+    data[*out_size] = '\0';
+    return data;
+}
+
+int map_load(Map* map, const char* filename) {
+    size_t size;
+    char* data = map_read_file(filename, &size);
+    if (!data) {
+        printf("Erreur : impossible d'ouvrir %s pour lecture\n", filename);
+        return 0;
+    }
+
+    int ok = map_parse(map, data, size, filename);
+    free(data);
+
+    if (ok) {
+        printf("Map chargée depuis %s (%dx%d, start: %.1f,%.1f)\n",
+               filename, map->width, map->height, map->player_start_x, map->player_start_y);
+    }
+    return ok;
+}
+
+int map_is_wall(Map* map, int x, int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
+        return 1; // Considérer les bordures comme des murs
+    }
+    return MAP_TILE(map, LAYER_WALL, x, y).type == TILE_SOLID;
+}
+
+// Grille des tiles qui bloquent la lumière (1 = mur), à libérer par l'appelant
+Uint8* map_build_occluders(Map* map) {
+    return map_build_occluders_rect(map, 0, 0, map->width - 1, map->height - 1);
+}
+
+// Même grille restreinte au rectangle inclusif [x0, x1] x [y0, y1], ligne par ligne
+Uint8* map_build_occluders_rect(Map* map, int x0, int y0, int x1, int y1) {
+    int width = x1 - x0 + 1;
+    int height = y1 - y0 + 1;
+    Uint8* grid = malloc((size_t)width * height);
+    if (!grid) {
+        printf("Erreur allocation grille d'ombres %dx%d\n", width, height);
+        return NULL;
+    }
+    for (int y = 0; y < height; y++) {
+        const Tile* walls = &MAP_TILE(map, LAYER_WALL, x0, y0 + y);
+        for (int x = 0; x < width; x++) {
+            grid[y * width + x] = walls[x].type == TILE_SOLID;
+        }
+    }
+    return grid;
+}
+
+int map_get_wall_texture(Map* map, int x, int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
+        return 0;
+    }
+    return MAP_TILE(map, LAYER_WALL, x, y).texture_id;
+}
+
+int map_get_floor_texture(Map* map, int x, int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
+        return 0;
+    }
+    return MAP_TILE(map, LAYER_FLOOR, x, y).texture_id;
+}
+
+int map_get_ceiling_texture(Map* map, int x, int y) {
+    if (x < 0 || x >= map->width || y < 0 || y >= map->height) {
+        return 0;
+    }
+    return MAP_TILE(map, LAYER_CEILING, x, y).texture_id;
+}
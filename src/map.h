@@ -1,47 +1,80 @@
-#ifndef MAP_H
-#define MAP_H
-
-#include <SDL2/SDL.h>
-
-#define MAP_WIDTH_MAX 40
-#define MAP_HEIGHT_MAX 30
-#define MAP_WIDTH_DEFAULT 20
-#define MAP_HEIGHT_DEFAULT 15
-#define TILE_SIZE 32
-
-// Layers de la map
-enum {
-    LAYER_FLOOR = 0,
-    LAYER_CEILING = 1,
-    LAYER_WALL = 2,
-    NUM_LAYERS = 3
-};
-
-// Types de tiles
-enum {
-    TILE_EMPTY = 0,
-    TILE_SOLID = 1
-};
-
-typedef struct {
-    int type;       // TILE_EMPTY ou TILE_SOLID
-    int texture_id; // ID de la texture
-} Tile;
-
-typedef struct {
-    Tile layers[NUM_LAYERS][MAP_HEIGHT_MAX][MAP_WIDTH_MAX];
-    int width;
-    int height;
-    float player_start_x;
-    float player_start_y;
-} Map;
-
-// Fonctions publiques
-int map_load(Map* map, const char* filename);
-int map_is_wall(Map* map, int x, int y);
-int map_get_wall_texture(Map* map, int x, int y);
-int map_get_floor_texture(Map* map, int x, int y);
-int map_get_ceiling_texture(Map* map, int x, int y);
-void map_init(Map* map);
-
-#endif
\ No newline at end of file
+#ifndef MAP_H
+#define MAP_H
+
+#include <SDL2/SDL.h>
+
+#define MAP_WIDTH_MAX 4096
+#define MAP_HEIGHT_MAX 4096
+#define MAP_WIDTH_DEFAULT 20
+#define MAP_HEIGHT_DEFAULT 15
+#define TILE_SIZE 32
+
+// Layers de la map
+enum {
+    LAYER_FLOOR = 0,
+    LAYER_CEILING = 1,
+    LAYER_WALL = 2,
+    NUM_LAYERS = 3
+};
+
+// Types de tiles
+enum {
+    TILE_EMPTY = 0,
+    TILE_SOLID = 1
+};
+
+typedef struct {
+    int type;       // TILE_EMPTY ou TILE_SOLID
+    int texture_id; // ID de la texture
+} Tile;
+
+struct Pvs;
+struct Entities;
+
+typedef struct {
+    Tile* layers[NUM_LAYERS];   // width * height tiles par layer, ligne par ligne
+    int width;
+    int height;
+    float player_start_x;
+    float player_start_y;
+    struct Pvs* pvs;            // Ensembles visibles précalculés (NULL: aucun), libérés par map_loader
+    struct Entities* entities;  // Sprites de la map (NULL: aucun), libérés par map_loader
+} Map;
+
+// Lecture d'une map texte cellule par cellule, sans allouer ses layers:
+// map_reader_open lit l'en-tête, map_reader_next les cellules ligne par ligne
+typedef struct {
+    const char* p;
+    const char* end;
+    const char* line_start;     // Position des messages d'erreur
+    int line;
+    const char* source_name;
+    int width;
+    int height;
+    float player_start_x;
+    float player_start_y;
+    size_t cell;                // Cellules lues
+    int truncated;              // Fin de fichier: les cellules suivantes sont vides
+    int failed;                 // Erreur de syntaxe, lecture arrêtée
+} MapReader;
+
+// Accès direct à une tile (sans vérification des bornes)
+#define MAP_TILE(map, layer, x, y) ((map)->layers[layer][(y) * (map)->width + (x)])
+
+// Fonctions publiques
+int map_load(Map* map, const char* filename);
+int map_parse(Map* map, const char* data, size_t size, const char* source_name);
+char* map_read_file(const char* filename, size_t* out_size);
+void map_reader_open(MapReader* reader, const char* data, size_t size, const char* source_name);
+int map_reader_next(MapReader* reader, Tile* tiles);
+int map_is_wall(Map* map, int x, int y);
+Uint8* map_build_occluders(Map* map);
+Uint8* map_build_occluders_rect(Map* map, int x0, int y0, int x1, int y1);
+int map_get_wall_texture(Map* map, int x, int y);
+int map_get_floor_texture(Map* map, int x, int y);
+int map_get_ceiling_texture(Map* map, int x, int y);
+int map_alloc(Map* map, int width, int height);
+int map_init(Map* map);
+void map_free(Map* map);
+
+#endif
@@ -0,0 +1,297 @@
+#include "map_catalog.h"
+#include "map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define MAP_CATALOG_MAX_EVENTS 64
+
+// Couleurs des murs dans les vignettes, par texture
+static const Uint32 map_catalog_wall_colors[8] = {
+    0xB04040FF, 0x4080C0FF, 0xC0A040FF, 0x40A060FF,
+    0xA060C0FF, 0x40B0B0FF, 0xC07030FF, 0x909090FF
+};
+
+// "foo.txt" ou "foo.txt.lights" -> "foo"; 0 si ce n'est pas un fichier de map
+static int map_catalog_name_from_file(const char* filename, char* out_name) {
+    const char* ext = strstr(filename, ".txt");
+    if (!ext || (ext[4] != '\0' && strcmp(ext + 4, ".lights") != 0)) {
+        return 0;
+    }
+    size_t len = ext - filename;
+    if (len == 0 || len >= MAP_CATALOG_NAME_MAX) {
+        return 0;
+    }
+    memcpy(out_name, filename, len);
+    out_name[len] = '\0';
+    return 1;
+}
+
+static int map_catalog_index_of(MapCatalog* cat, const char* name, int* insert_at) {
+    // Recherche dichotomique (entrées triées par nom)
+    int lo = 0, hi = cat->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = strcmp(cat->entries[mid].name, name);
+        if (cmp == 0) return mid;
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    if (insert_at) *insert_at = lo;
+    return -1;
+}
+
+static void map_catalog_remove(MapCatalog* cat, int index) {
+    memmove(&cat->entries[index], &cat->entries[index + 1],
+            (cat->count - index - 1) * sizeof(MapCatalogEntry));
+    cat->count--;
+    cat->version++;
+}
+
+static MapCatalogEntry* map_catalog_insert(MapCatalog* cat, int index) {
+    if (cat->count == cat->capacity) {
+        int capacity = cat->capacity ? cat->capacity * 2 : 32;
+        MapCatalogEntry* entries = realloc(cat->entries, capacity * sizeof(MapCatalogEntry));
+        if (!entries) {
+            printf("Erreur allocation catalogue de maps\n");
+            return NULL;
+        }
+        cat->entries = entries;
+        cat->capacity = capacity;
+    }
+    memmove(&cat->entries[index + 1], &cat->entries[index],
+            (cat->count - index) * sizeof(MapCatalogEntry));
+    cat->count++;
+    return &cat->entries[index];
+}
+
+// Vignette remplie pendant la lecture des cellules, sans allouer la map: chaque
+// cellule colore les pixels qui l'échantillonnent (au plus proche, proportions gardées)
+static int map_catalog_read_thumbnail(MapCatalogEntry* entry, MapReader* reader) {
+    int size = MAP_CATALOG_THUMB_SIZE;
+    int longest = reader->width > reader->height ? reader->width : reader->height;
+    for (int i = 0; i < size * size; i++) {
+        entry->thumbnail[i] = 0x000000FF;
+    }
+
+    Tile tiles[NUM_LAYERS];
+    while (map_reader_next(reader, tiles)) {
+        int x = (int)((reader->cell - 1) % reader->width);
+        int y = (int)((reader->cell - 1) / reader->width);
+
+        // Pixels [tx0, tx1[ x [ty0, ty1[ tels que tx * longest / size == x (idem en y)
+        int tx0 = (x * size + longest - 1) / longest;
+        int tx1 = ((x + 1) * size + longest - 1) / longest;
+        int ty0 = (y * size + longest - 1) / longest;
+        int ty1 = ((y + 1) * size + longest - 1) / longest;
+        if (tx1 > size) tx1 = size;
+        if (ty1 > size) ty1 = size;
+        if (tx0 >= tx1 || ty0 >= ty1) continue;
+
+        Uint32 color;
+        if (tiles[LAYER_WALL].type == TILE_SOLID) {
+            color = map_catalog_wall_colors[tiles[LAYER_WALL].texture_id & 7];
+        } else if (tiles[LAYER_FLOOR].type != TILE_EMPTY) {
+            color = 0x383838FF;
+        } else {
+            color = 0x181818FF;
+        }
+        for (int ty = ty0; ty < ty1; ty++) {
+            for (int tx = tx0; tx < tx1; tx++) {
+                entry->thumbnail[ty * size + tx] = color;
+            }
+        }
+    }
+    if (reader->failed) return 0;
+
+    int px = (int)(reader->player_start_x * size / longest);
+    int py = (int)(reader->player_start_y * size / longest);
+    if (px >= 0 && px < size && py >= 0 && py < size) {
+        entry->thumbnail[py * size + px] = 0x00FF00FF;
+    }
+    return 1;
+}
+
+static void map_catalog_read_map(MapCatalogEntry* entry, const char* path) {
+    entry->width = 0;
+    entry->height = 0;
+    entry->player_start_x = 0.0f;
+    entry->player_start_y = 0.0f;
+
+    size_t size;
+    char* data = map_read_file(path, &size);
+    if (!data) {
+        memset(entry->thumbnail, 0, sizeof(entry->thumbnail));
+        return;
+    }
+
+    // En-tête puis cellules lues au fil de l'eau: seule la vignette est gardée
+    MapReader reader;
+    map_reader_open(&reader, data, size, path);
+    if (map_catalog_read_thumbnail(entry, &reader)) {
+        entry->width = reader.width;
+        entry->height = reader.height;
+        entry->player_start_x = reader.player_start_x;
+        entry->player_start_y = reader.player_start_y;
+    } else {
+        memset(entry->thumbnail, 0, sizeof(entry->thumbnail));
+    }
+    free(data);
+}
+
+static int map_catalog_count_lights(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return 0;
+
+    int count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "LIGHT ", 6) == 0) count++;
+    }
+    fclose(file);
+    return count;
+}
+
+// Relire une map si elle (ou ses lumières) a changé depuis la dernière visite.
+// force: le système a signalé une écriture, même si mtime/taille semblent identiques.
+static void map_catalog_refresh(MapCatalog* cat, const char* name, int force) {
+    char path[FILE_WATCH_PATH_MAX + MAP_CATALOG_NAME_MAX + 16];
+    char lights_path[sizeof(path) + 8];
+    snprintf(path, sizeof(path), "%s/%s.txt", cat->dir, name);
+    snprintf(lights_path, sizeof(lights_path), "%s.lights", path);
+
+    int insert_at = 0;
+    int index = map_catalog_index_of(cat, name, &insert_at);
+
+    struct stat map_stat;
+    if (stat(path, &map_stat) != 0) {
+        if (index >= 0) map_catalog_remove(cat, index);
+        return;
+    }
+
+    struct stat lights_stat;
+    time_t lights_mtime = stat(lights_path, &lights_stat) == 0 ? lights_stat.st_mtime : 0;
+
+    MapCatalogEntry* entry;
+    int map_changed = 1;
+    int lights_changed = 1;
+    if (index >= 0) {
+        entry = &cat->entries[index];
+        map_changed = entry->mtime != map_stat.st_mtime || entry->file_size != (long)map_stat.st_size;
+        lights_changed = entry->lights_mtime != lights_mtime;
+        if (force) {
+            map_changed = lights_changed = 1;
+        }
+        if (!map_changed && !lights_changed) return;
+    } else {
+        entry = map_catalog_insert(cat, insert_at);
+        if (!entry) return;
+        snprintf(entry->name, sizeof(entry->name), "%s", name);
+    }
+
+    if (map_changed) {
+        entry->mtime = map_stat.st_mtime;
+        entry->file_size = (long)map_stat.st_size;
+        map_catalog_read_map(entry, path);
+    }
+    if (lights_changed) {
+        entry->lights_mtime = lights_mtime;
+        entry->light_count = lights_mtime ? map_catalog_count_lights(lights_path) : 0;
+    }
+    cat->version++;
+}
+
+void map_catalog_rescan(MapCatalog* cat) {
+    DIR* dir = opendir(cat->dir);
+    if (!dir) {
+        printf("Impossible d'ouvrir le dossier %s/\n", cat->dir);
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        char name[MAP_CATALOG_NAME_MAX];
+        char* ext = strrchr(entry->d_name, '.');
+        if (ext && strcmp(ext, ".txt") == 0 && map_catalog_name_from_file(entry->d_name, name)) {
+            map_catalog_refresh(cat, name, 0);
+        }
+    }
+    closedir(dir);
+
+    // Retirer les maps disparues (parcours à rebours, la suppression décale)
+    for (int i = cat->count - 1; i >= 0; i--) {
+        char name[MAP_CATALOG_NAME_MAX];
+        snprintf(name, sizeof(name), "%s", cat->entries[i].name);
+        map_catalog_refresh(cat, name, 0);
+    }
+}
+
+int map_catalog_init(MapCatalog* cat, const char* dir) {
+    snprintf(cat->dir, sizeof(cat->dir), "%s", dir);
+    cat->entries = NULL;
+    cat->count = 0;
+    cat->capacity = 0;
+    cat->version = 0;
+
+    file_watch_init(&cat->watch);
+    file_watch_add_dir(&cat->watch, dir);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    map_catalog_rescan(cat);
+    double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    printf("Catalogue de maps: %d maps indexées dans %s/ (%.1f ms)\n", cat->count, dir, ms);
+    return cat->count;
+}
+
+int map_catalog_poll(MapCatalog* cat) {
+    FileWatchEvent events[MAP_CATALOG_MAX_EVENTS];
+    int event_count = file_watch_poll(&cat->watch, events, MAP_CATALOG_MAX_EVENTS);
+    if (event_count == 0) return 0;
+
+    int version = cat->version;
+    for (int i = 0; i < event_count; i++) {
+        char name[MAP_CATALOG_NAME_MAX];
+        if (events[i].name[0] == '\0') {
+            map_catalog_rescan(cat);
+        } else if (map_catalog_name_from_file(events[i].name, name)) {
+            map_catalog_refresh(cat, name, 1);
+        }
+    }
+    return cat->version != version;
+}
+
+void map_catalog_destroy(MapCatalog* cat) {
+    file_watch_destroy(&cat->watch);
+    free(cat->entries);
+    cat->entries = NULL;
+    cat->count = 0;
+    cat->capacity = 0;
+}
+
+int map_catalog_count(MapCatalog* cat) {
+    return cat->count;
+}
+
+const MapCatalogEntry* map_catalog_get(MapCatalog* cat, int index) {
+    if (index < 0 || index >= cat->count) return NULL;
+    return &cat->entries[index];
+}
+
+int map_catalog_find(MapCatalog* cat, const char* name) {
+    return map_catalog_index_of(cat, name, NULL);
+}
+
+void map_catalog_print(MapCatalog* cat) {
+    printf("\n=== MAPS DISPONIBLES ===\n");
+    if (cat->count == 0) {
+        printf("  Aucune map trouvée dans le dossier %s/\n", cat->dir);
+    }
+    for (int i = 0; i < cat->count; i++) {
+        MapCatalogEntry* entry = &cat->entries[i];
+        printf("  %d. %-24s %4dx%-4d %3d lumières  %ld octets\n", i + 1, entry->name,
+               entry->width, entry->height, entry->light_count, entry->file_size);
+    }
+    printf("========================\n");
+}
@@ -0,0 +1,44 @@
+#ifndef MAP_CATALOG_H
+#define MAP_CATALOG_H
+
+#include <SDL2/SDL.h>
+#include <time.h>
+#include "file_watch.h"
+
+#define MAP_CATALOG_NAME_MAX 64
+#define MAP_CATALOG_THUMB_SIZE 32
+
+// Métadonnées d'une map, calculées une fois puis mises à jour sur changement du fichier
+typedef struct {
+    char name[MAP_CATALOG_NAME_MAX];   // Nom sans extension
+    int width, height;
+    float player_start_x, player_start_y;
+    int light_count;
+    long file_size;
+    time_t mtime;
+    time_t lights_mtime;
+    Uint32 thumbnail[MAP_CATALOG_THUMB_SIZE * MAP_CATALOG_THUMB_SIZE]; // RGBA8888
+} MapCatalogEntry;
+
+typedef struct {
+    char dir[FILE_WATCH_PATH_MAX];
+    MapCatalogEntry* entries;          // Triées par nom
+    int count;
+    int capacity;
+    int version;                       // Incrémentée à chaque changement
+    FileWatch watch;
+} MapCatalog;
+
+// Construction et mise à jour
+int map_catalog_init(MapCatalog* cat, const char* dir);
+int map_catalog_poll(MapCatalog* cat);
+void map_catalog_rescan(MapCatalog* cat);
+void map_catalog_destroy(MapCatalog* cat);
+
+// Requêtes
+int map_catalog_count(MapCatalog* cat);
+const MapCatalogEntry* map_catalog_get(MapCatalog* cat, int index);
+int map_catalog_find(MapCatalog* cat, const char* name);
+void map_catalog_print(MapCatalog* cat);
+
+#endif
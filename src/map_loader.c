@@ -1,83 +1,248 @@
-#include "map_loader.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <dirent.h>
-#include <sys/stat.h>
-
-int map_loader_file_exists(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file) {
-        fclose(file);
-        return 1;
-    }
-    return 0;
-}
-
-void map_loader_list_available_maps(void) {
-    printf("\n=== MAPS DISPONIBLES ===\n");
-    
-    DIR* dir = opendir("maps");
-    if (dir) {
-        struct dirent* entry;
-        int map_count = 0;
-        
-        while ((entry = readdir(dir)) != NULL) {
-            char* ext = strrchr(entry->d_name, '.');
-            if (ext && strcmp(ext, ".txt") == 0) {
-                // Retirer l'extension pour l'affichage
-                char map_name[256];
-                strncpy(map_name, entry->d_name, sizeof(map_name));
-                map_name[ext - entry->d_name] = '\0';
-                
-                printf("  %d. %s\n", ++map_count, map_name);
-            }
-        }
-        closedir(dir);
-        
-        if (map_count == 0) {
-            printf("  Aucune map trouvée dans le dossier maps/\n");
-        }
-    } else {
-        printf("  Impossible d'ouvrir le dossier maps/\n");
-        printf("  Assurez-vous que le dossier existe.\n");
-    }
-    printf("========================\n");
-}
-
-int map_loader_load_interactive(Map* map, char* loaded_map_name, size_t name_size) {
-    map_loader_list_available_maps();
-    
-    printf("Entrez le nom de la map (sans .txt) ou 'cancel' pour annuler: ");
-    fflush(stdout);
-    
-    char input[256];
-    if (fgets(input, sizeof(input), stdin)) {
-        // Retirer le \n
-        input[strcspn(input, "\n")] = '\0';
-        
-        if (strlen(input) == 0 || strcmp(input, "cancel") == 0) {
-            printf("Chargement annulé.\n");
-            return 0;
-        }
-        
-        char full_path[512];
-        snprintf(full_path, sizeof(full_path), "maps/%s.txt", input);
-        
-        if (!map_loader_file_exists(full_path)) {
-            printf("Erreur: Le fichier %s n'existe pas.\n", full_path);
-            return 0;
-        }
-        
-        if (map_load(map, full_path)) {
-            snprintf(loaded_map_name, name_size, "%s", full_path);
-            printf("✓ Map '%s' chargée avec succès!\n", input);
-            return 1;
-        } else {
-            printf("✗ Erreur lors du chargement de %s\n", full_path);
-            return 0;
-        }
-    }
-    
-    return 0;
-}
\ No newline at end of file
+#include "map_loader.h"
+#include "pvs.h"
+#include "entities.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int map_loader_file_exists(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (file) {
+        fclose(file);
+        return 1;
+    }
+    return 0;
+}
+
+void map_loader_build_path(const char* map_name, char* out_path, size_t out_size) {
+    snprintf(out_path, out_size, "maps/%s.txt", map_name);
+}
+
+void map_loader_default_lights(LightManager* lm, Map* map) {
+    // Quelques lumières blanches faibles quand la map n'a pas de fichier .lights
+    printf("Création de lumières par défaut (blanches)\n");
+    lighting_add_light(lm, map->width/2.0f, map->height/2.0f, 1.0f, 1.0f, 1.0f, 1.5f, 6.0f); // Lumière blanche centrale
+    lighting_add_light(lm, 3.0f, 3.0f, 1.0f, 1.0f, 1.0f, 1.2f, 4.0f);   // Lumière blanche coin
+    if (map->width > 15 && map->height > 10) {
+        lighting_add_light(lm, map->width-3.0f, map->height-3.0f, 1.0f, 1.0f, 1.0f, 1.3f, 5.0f); // Lumière blanche autre coin
+    }
+}
+
+void map_loader_attach_occluders(Map* map, LightManager* lm) {
+    // Les murs de la map projettent les ombres des lumières
+    Uint8* grid = map_build_occluders(map);
+    if (!grid) return;
+    Uint64 start = SDL_GetPerformanceCounter();
+    lighting_set_occluders(lm, grid, map->width, map->height);
+    printf("Ombres: visibilité de %d lumières calculée (%.1f ms)\n", lm->count,
+           (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+    free(grid);
+}
+
+void map_loader_attach_pvs(Map* map) {
+    // Visibilité tile à tile pour écarter les lumières cachées par les murs
+    Uint64 start = SDL_GetPerformanceCounter();
+    map->pvs = pvs_build(map);
+    if (!map->pvs) return;
+    if (map->pvs->cells_ready < map->width * map->height) {
+        printf("PVS: %dx%d tiles, calculé autour du joueur au fil des frames\n", map->width, map->height);
+        return;
+    }
+    printf("PVS: %d Ko pour %dx%d tiles (%.1f ms)\n", (int)(map->pvs->bits_used * sizeof(Uint32) / 1024),
+           map->width, map->height,
+           (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
+void map_loader_attach_entities(Map* map, const char* path) {
+    // Sprites du fichier "<map>.entities" s'il existe
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s.entities", path);
+    if (!map_loader_file_exists(filename)) return;
+    map->entities = entities_create(map->width, map->height);
+    if (map->entities && !entities_load_from_file(map->entities, filename)) {
+        entities_destroy(map->entities);
+        map->entities = NULL;
+    }
+}
+
+void map_loader_add_test_entities(Map* map, int count, int texture_count) {
+    // Charge de sprites (--sprites): décors répartis sur les tiles vides
+    if (count <= 0) return;
+    if (!map->entities) {
+        map->entities = entities_create(map->width, map->height);
+        if (!map->entities) return;
+    }
+    entities_scatter(map->entities, map, count, texture_count, 1);
+}
+
+int map_loader_load_level(const char* path, Map** out_map, LightManager** out_lights) {
+    Map* map = malloc(sizeof(Map));
+    LightManager* lights = malloc(sizeof(LightManager));
+    if (!map || !lights) {
+        printf("Erreur allocation niveau %s\n", path);
+        free(map);
+        free(lights);
+        return 0;
+    }
+
+    if (!map_load(map, path)) {
+        free(map);
+        free(lights);
+        return 0;
+    }
+
+    // Charger les lumières correspondantes
+    char light_filename[512];
+    snprintf(light_filename, sizeof(light_filename), "%s.lights", path);
+    lighting_init(lights);
+    if (!lighting_load_from_file(lights, light_filename)) {
+        map_loader_default_lights(lights, map);
+    }
+
+    // Caches dérivés prêts avant la bascule
+    map_loader_attach_occluders(map, lights);
+    map_loader_attach_pvs(map);
+    map_loader_attach_entities(map, path);
+    lighting_update_cache(lights);
+
+    *out_map = map;
+    *out_lights = lights;
+    return 1;
+}
+
+void map_loader_free_level(Map* map, LightManager* lights) {
+    if (map) {
+        pvs_destroy(map->pvs);
+        entities_destroy(map->entities);
+        map_free(map);
+        free(map);
+    }
+    if (lights) {
+        lighting_destroy(lights);
+        free(lights);
+    }
+}
+
+static int map_loader_job_thread(void* data) {
+    MapLoadJob* job = (MapLoadJob*)data;
+
+    Map* map;
+    LightManager* lights;
+    if (map_loader_load_level(job->path, &map, &lights)) {
+        map_loader_add_test_entities(map, job->test_sprites, job->texture_count);
+        job->map = map;
+        job->lights = lights;
+        // Publier le résultat avant le changement d'état
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&job->state, MAP_LOAD_READY);
+    } else {
+        SDL_AtomicSet(&job->state, MAP_LOAD_FAILED);
+    }
+    return 0;
+}
+
+static int map_loader_release_thread(void* data) {
+    MapLoadJob* job = (MapLoadJob*)data;
+    map_loader_free_level(job->release_map, job->release_lights);
+    return 0;
+}
+
+// Attendre la fin de la libération précédente (déjà terminée en temps normal)
+static void map_loader_job_wait_release(MapLoadJob* job) {
+    if (job->release_thread) {
+        SDL_WaitThread(job->release_thread, NULL);
+        job->release_thread = NULL;
+    }
+    job->release_map = NULL;
+    job->release_lights = NULL;
+}
+
+void map_loader_job_init(MapLoadJob* job) {
+    job->thread = NULL;
+    SDL_AtomicSet(&job->state, MAP_LOAD_IDLE);
+    job->path[0] = '\0';
+    job->test_sprites = 0;
+    job->texture_count = 0;
+    job->map = NULL;
+    job->lights = NULL;
+    job->release_thread = NULL;
+    job->release_map = NULL;
+    job->release_lights = NULL;
+}
+
+int map_loader_job_busy(MapLoadJob* job) {
+    return job->thread != NULL;
+}
+
+int map_loader_job_start(MapLoadJob* job, const char* path, int test_sprites, int texture_count) {
+    if (job->thread) {
+        printf("Chargement déjà en cours: %s\n", job->path);
+        return 0;
+    }
+
+    snprintf(job->path, sizeof(job->path), "%s", path);
+    job->test_sprites = test_sprites;
+    job->texture_count = texture_count;
+    job->map = NULL;
+    job->lights = NULL;
+    SDL_AtomicSet(&job->state, MAP_LOAD_RUNNING);
+
+    job->thread = SDL_CreateThread(map_loader_job_thread, "map_loader", job);
+    if (!job->thread) {
+        printf("Erreur création thread de chargement: %s\n", SDL_GetError());
+        SDL_AtomicSet(&job->state, MAP_LOAD_IDLE);
+        return 0;
+    }
+    return 1;
+}
+
+int map_loader_job_poll(MapLoadJob* job, Map** out_map, LightManager** out_lights) {
+    if (!job->thread) return 0;
+
+    int state = SDL_AtomicGet(&job->state);
+    if (state == MAP_LOAD_RUNNING) return 0;
+
+    // Le thread a terminé son travail, l'attente est immédiate
+    SDL_WaitThread(job->thread, NULL);
+    job->thread = NULL;
+    SDL_AtomicSet(&job->state, MAP_LOAD_IDLE);
+
+    if (state == MAP_LOAD_FAILED) {
+        printf("✗ Erreur lors du chargement de %s\n", job->path);
+        return -1;
+    }
+
+    SDL_MemoryBarrierAcquire();
+    *out_map = job->map;
+    *out_lights = job->lights;
+    job->map = NULL;
+    job->lights = NULL;
+    return 1;
+}
+
+// Ancien niveau rendu par le thread principal après la bascule: libéré sur un
+// thread de travail (sur place si sa création échoue)
+void map_loader_job_release(MapLoadJob* job, Map* map, LightManager* lights) {
+    map_loader_job_wait_release(job);
+    job->release_map = map;
+    job->release_lights = lights;
+    job->release_thread = SDL_CreateThread(map_loader_release_thread, "map_release", job);
+    if (!job->release_thread) {
+        printf("Erreur création thread de libération: %s\n", SDL_GetError());
+        map_loader_free_level(map, lights);
+        job->release_map = NULL;
+        job->release_lights = NULL;
+    }
+}
+
+void map_loader_job_destroy(MapLoadJob* job) {
+    if (job->thread) {
+        SDL_WaitThread(job->thread, NULL);
+        job->thread = NULL;
+    }
+    map_loader_job_wait_release(job);
+    if (SDL_AtomicGet(&job->state) == MAP_LOAD_READY) {
+        map_loader_free_level(job->map, job->lights);
+    }
+    map_loader_job_init(job);
+}
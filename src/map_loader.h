@@ -1,11 +1,54 @@
-#ifndef MAP_LOADER_H
-#define MAP_LOADER_H
-
-#include "map.h"
-
-// Fonctions pour le chargement dynamique de maps
-void map_loader_list_available_maps(void);
-int map_loader_load_interactive(Map* map, char* loaded_map_name, size_t name_size);
-int map_loader_file_exists(const char* filename);
-
-#endif
\ No newline at end of file
+#ifndef MAP_LOADER_H
+#define MAP_LOADER_H
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "../editor/lighting.h"
+
+// États d'un chargement asynchrone
+enum {
+    MAP_LOAD_IDLE = 0,
+    MAP_LOAD_RUNNING = 1,
+    MAP_LOAD_READY = 2,
+    MAP_LOAD_FAILED = 3
+};
+
+// Chargement d'un niveau sur un thread de travail.
+// Le thread principal continue de rendre l'ancien niveau et récupère
+// le nouveau Map/LightManager d'un bloc via map_loader_job_poll, puis
+// rend l'ancien via map_loader_job_release pour qu'il soit libéré à part.
+typedef struct {
+    SDL_Thread* thread;
+    SDL_atomic_t state;         // MAP_LOAD_*
+    char path[512];
+    int test_sprites;           // Décors de test ajoutés avant la publication (--sprites)
+    int texture_count;
+    Map* map;                   // Résultat, possédé par le job jusqu'au poll
+    LightManager* lights;
+    SDL_Thread* release_thread; // Libération de l'ancien niveau en cours
+    Map* release_map;
+    LightManager* release_lights;
+} MapLoadJob;
+
+// Fonctions pour le chargement dynamique de maps
+int map_loader_file_exists(const char* filename);
+void map_loader_build_path(const char* map_name, char* out_path, size_t out_size);
+
+// Chargement complet d'un niveau (map + lumières + caches dérivés)
+int map_loader_load_level(const char* path, Map** out_map, LightManager** out_lights);
+void map_loader_default_lights(LightManager* lm, Map* map);
+void map_loader_attach_occluders(Map* map, LightManager* lm);
+void map_loader_attach_pvs(Map* map);
+void map_loader_attach_entities(Map* map, const char* path);
+void map_loader_add_test_entities(Map* map, int count, int texture_count);
+void map_loader_free_level(Map* map, LightManager* lights);
+
+// Chargement asynchrone
+void map_loader_job_init(MapLoadJob* job);
+int map_loader_job_start(MapLoadJob* job, const char* path, int test_sprites, int texture_count);
+int map_loader_job_poll(MapLoadJob* job, Map** out_map, LightManager** out_lights);
+void map_loader_job_release(MapLoadJob* job, Map* map, LightManager* lights);
+int map_loader_job_busy(MapLoadJob* job);
+void map_loader_job_destroy(MapLoadJob* job);
+
+#endif
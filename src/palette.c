@@ -0,0 +1,316 @@
+#include "palette.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PALETTE_CELLS (1 << (3 * PALETTE_INVERSE_BITS))
+
+// Histogramme des couleurs en cellules RGB 5:5:5
+typedef struct {
+    Uint32* count;
+    Uint64* sum;            // Somme r, g, b des pixels de chaque cellule
+} PaletteHistogram;
+
+// Boîte de la coupe médiane: segment [start, end) du tableau de cellules
+typedef struct {
+    int start;
+    int end;
+    Uint64 population;
+} PaletteBox;
+
+static int palette_cell(Uint32 color) {
+    int r = (color >> 24) & 0xFF;
+    int g = (color >> 16) & 0xFF;
+    int b = (color >> 8) & 0xFF;
+    return ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+}
+
+// Composante (0 = r, 1 = g, 2 = b) d'une cellule, sur 5 bits
+static int palette_cell_channel(int cell, int channel) {
+    return (cell >> (10 - channel * 5)) & 0x1F;
+}
+
+static int palette_sort_channel;
+
+static int palette_compare_cells(const void* a, const void* b) {
+    int ca = palette_cell_channel(*(const Uint16*)a, palette_sort_channel);
+    int cb = palette_cell_channel(*(const Uint16*)b, palette_sort_channel);
+    return ca - cb;
+}
+
+// Plus grande étendue d'une boîte, renvoie le canal concerné
+static int palette_box_range(const PaletteBox* box, const Uint16* cells, int* out_channel) {
+    int best = -1;
+    for (int channel = 0; channel < 3; channel++) {
+        int lo = 31, hi = 0;
+        for (int i = box->start; i < box->end; i++) {
+            int v = palette_cell_channel(cells[i], channel);
+            if (v < lo) lo = v;
+            if (v > hi) hi = v;
+        }
+        if (hi - lo > best) {
+            best = hi - lo;
+            *out_channel = channel;
+        }
+    }
+    return best;
+}
+
+// Coupe médiane: découper la boîte la plus peuplée et la plus étendue jusqu'à 'target' boîtes
+static int palette_median_cut(const PaletteHistogram* hist, Uint16* cells, int cell_count,
+                              PaletteBox* boxes, int target) {
+    int box_count = 1;
+    boxes[0].start = 0;
+    boxes[0].end = cell_count;
+    boxes[0].population = 0;
+    for (int i = 0; i < cell_count; i++) {
+        boxes[0].population += hist->count[cells[i]];
+    }
+    
+    while (box_count < target) {
+        int split = -1, channel = 0;
+        double best_score = 0.0;
+        for (int i = 0; i < box_count; i++) {
+            if (boxes[i].end - boxes[i].start < 2) continue;
+            int box_channel;
+            int range = palette_box_range(&boxes[i], cells, &box_channel);
+            double score = (double)range * (double)boxes[i].population;
+            if (range > 0 && score > best_score) {
+                best_score = score;
+                split = i;
+                channel = box_channel;
+            }
+        }
+        if (split < 0) break;
+        
+        PaletteBox* box = &boxes[split];
+        palette_sort_channel = channel;
+        qsort(cells + box->start, box->end - box->start, sizeof(Uint16), palette_compare_cells);
+        
+        // Couper à la médiane pondérée par le nombre de pixels
+        Uint64 half = box->population / 2, acc = 0;
+        int mid = box->start + 1;
+        for (int i = box->start; i < box->end - 1; i++) {
+            acc += hist->count[cells[i]];
+            mid = i + 1;
+            if (acc >= half) break;
+        }
+        
+        PaletteBox* upper = &boxes[box_count++];
+        upper->start = mid;
+        upper->end = box->end;
+        upper->population = box->population - acc;
+        box->end = mid;
+        box->population = acc;
+    }
+    return box_count;
+}
+
+static void palette_build_inverse(Palette* pal) {
+    for (int cell = 0; cell < PALETTE_CELLS; cell++) {
+        int r = (palette_cell_channel(cell, 0) << 3) | 4;
+        int g = (palette_cell_channel(cell, 1) << 3) | 4;
+        int b = (palette_cell_channel(cell, 2) << 3) | 4;
+        int best = 0, best_dist = 1 << 30;
+        for (int i = 0; i < PALETTE_COLORS; i++) {
+            int dr = r - (int)((pal->colors[i] >> 24) & 0xFF);
+            int dg = g - (int)((pal->colors[i] >> 16) & 0xFF);
+            int db = b - (int)((pal->colors[i] >> 8) & 0xFF);
+            int dist = dr * dr * 3 + dg * dg * 4 + db * db * 2;
+            if (dist < best_dist) {
+                best_dist = dist;
+                best = i;
+            }
+        }
+        pal->inverse[cell] = (Uint8)best;
+    }
+}
+
+static const float palette_tint_values[PALETTE_TINT_STEPS] = { 0.4f, 0.7f, 1.0f };
+
+// Tables d'éclairage: chaque couleur multipliée par la teinte et par niveau / PALETTE_LIGHT_UNIT
+static void palette_build_colormaps(Palette* pal) {
+    for (int tint = 0; tint < PALETTE_TINTS; tint++) {
+        float tint_r = palette_tint_values[tint / (PALETTE_TINT_STEPS * PALETTE_TINT_STEPS)];
+        float tint_g = palette_tint_values[(tint / PALETTE_TINT_STEPS) % PALETTE_TINT_STEPS];
+        float tint_b = palette_tint_values[tint % PALETTE_TINT_STEPS];
+        
+        for (int level = 0; level < PALETTE_LIGHT_LEVELS; level++) {
+            float factor = (float)level / PALETTE_LIGHT_UNIT;
+            for (int i = 0; i < PALETTE_COLORS; i++) {
+                if (tint == PALETTE_TINT_NEUTRAL && level == PALETTE_LIGHT_UNIT) {
+                    pal->colormap[tint][level][i] = (Uint8)i;
+                    continue;
+                }
+                Uint32 c = pal->colors[i];
+                int r = (int)(((c >> 24) & 0xFF) * factor * tint_r + 0.5f);
+                int g = (int)(((c >> 16) & 0xFF) * factor * tint_g + 0.5f);
+                int b = (int)(((c >> 8) & 0xFF) * factor * tint_b + 0.5f);
+                if (r > 255) r = 255;
+                if (g > 255) g = 255;
+                if (b > 255) b = 255;
+                pal->colormap[tint][level][i] = palette_nearest(pal, ((Uint32)r << 24) | ((Uint32)g << 16) | ((Uint32)b << 8) | 0xFF);
+            }
+        }
+    }
+}
+
+// Ajouter au histogramme les couleurs éclairées (teintes et niveaux représentatifs),
+// avec un poids réduit, pour que les tons assombris ou colorés aient une entrée proche
+static void palette_add_lit_variants(PaletteHistogram* hist) {
+    static const float levels[] = { 0.3f, 0.6f, 1.0f };
+    Uint32* base = malloc(PALETTE_CELLS * sizeof(Uint32));
+    if (!base) return;
+    memcpy(base, hist->count, PALETTE_CELLS * sizeof(Uint32));
+    
+    for (int cell = 0; cell < PALETTE_CELLS; cell++) {
+        Uint32 n = base[cell];
+        if (!n) continue;
+        float r = (float)hist->sum[cell * 3 + 0] / n;
+        float g = (float)hist->sum[cell * 3 + 1] / n;
+        float b = (float)hist->sum[cell * 3 + 2] / n;
+        Uint32 weight = n / 8 ? n / 8 : 1;
+        
+        for (int tint = 0; tint < PALETTE_TINTS - 1; tint++) {
+            float tint_r = palette_tint_values[tint / (PALETTE_TINT_STEPS * PALETTE_TINT_STEPS)];
+            float tint_g = palette_tint_values[(tint / PALETTE_TINT_STEPS) % PALETTE_TINT_STEPS];
+            float tint_b = palette_tint_values[tint % PALETTE_TINT_STEPS];
+            for (int l = 0; l < 3; l++) {
+                Uint32 lr = (Uint32)(r * tint_r * levels[l]);
+                Uint32 lg = (Uint32)(g * tint_g * levels[l]);
+                Uint32 lb = (Uint32)(b * tint_b * levels[l]);
+                int target = palette_cell((lr << 24) | (lg << 16) | (lb << 8));
+                hist->count[target] += weight;
+                hist->sum[target * 3 + 0] += (Uint64)lr * weight;
+                hist->sum[target * 3 + 1] += (Uint64)lg * weight;
+                hist->sum[target * 3 + 2] += (Uint64)lb * weight;
+            }
+        }
+    }
+    free(base);
+}
+
+static int palette_tint_step(float ratio) {
+    if (ratio < 0.55f) return 0;
+    if (ratio < 0.85f) return 1;
+    return 2;
+}
+
+// Table d'éclairage pour une lumière RGB: niveau = canal le plus fort, teinte = rapports des canaux
+const Uint8* palette_light_table(const Palette* pal, float r, float g, float b) {
+    float m = r > g ? r : g;
+    if (b > m) m = b;
+    if (m <= 0.0f) return pal->colormap[PALETTE_TINT_NEUTRAL][0];
+    
+    int level = (int)(m * PALETTE_LIGHT_UNIT + 0.5f);
+    if (level >= PALETTE_LIGHT_LEVELS) level = PALETTE_LIGHT_LEVELS - 1;
+    
+    float inv = 1.0f / m;
+    int tint = palette_tint_step(r * inv) * PALETTE_TINT_STEPS * PALETTE_TINT_STEPS +
+               palette_tint_step(g * inv) * PALETTE_TINT_STEPS +
+               palette_tint_step(b * inv);
+    return pal->colormap[tint][level];
+}
+
+Uint8 palette_nearest(const Palette* pal, Uint32 color) {
+    return pal->inverse[palette_cell(color)];
+}
+
+int palette_index_textures(Palette* pal, const TextureManager* tm) {
+    if (tm->arena_used > pal->texel_capacity) {
+        Uint8* texels = realloc(pal->texels, tm->arena_capacity);
+        if (!texels) {
+            printf("Erreur allocation texels indexés\n");
+            return 0;
+        }
+        pal->texels = texels;
+        pal->texel_capacity = tm->arena_capacity;
+    }
+    for (Uint32 i = 0; i < tm->arena_used; i++) {
+        pal->texels[i] = pal->inverse[palette_cell(tm->pixels[i])];
+    }
+    return 1;
+}
+
+Palette* palette_create(const TextureManager* tm) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    Palette* pal = calloc(1, sizeof(Palette));
+    if (!pal) {
+        printf("Erreur allocation palette\n");
+        return NULL;
+    }
+    
+    PaletteHistogram hist;
+    hist.count = calloc(PALETTE_CELLS, sizeof(Uint32));
+    hist.sum = calloc(PALETTE_CELLS * 3, sizeof(Uint64));
+    Uint16* cells = malloc(PALETTE_CELLS * sizeof(Uint16));
+    PaletteBox* boxes = malloc(PALETTE_COLORS * sizeof(PaletteBox));
+    if (!hist.count || !hist.sum || !cells || !boxes) {
+        printf("Erreur allocation palette\n");
+        free(hist.count);
+        free(hist.sum);
+        free(cells);
+        free(boxes);
+        free(pal);
+        return NULL;
+    }
+    
+    for (Uint32 i = 0; i < tm->arena_used; i++) {
+        Uint32 c = tm->pixels[i];
+        int cell = palette_cell(c);
+        hist.count[cell]++;
+        hist.sum[cell * 3 + 0] += (c >> 24) & 0xFF;
+        hist.sum[cell * 3 + 1] += (c >> 16) & 0xFF;
+        hist.sum[cell * 3 + 2] += (c >> 8) & 0xFF;
+    }
+    palette_add_lit_variants(&hist);
+    
+    int cell_count = 0;
+    for (int cell = 0; cell < PALETTE_CELLS; cell++) {
+        if (hist.count[cell]) cells[cell_count++] = (Uint16)cell;
+    }
+    
+    // Index 0 réservé au noir (niveau de lumière nul), le reste par coupe médiane
+    pal->colors[0] = 0x000000FF;
+    int box_count = cell_count > 0 ? palette_median_cut(&hist, cells, cell_count, boxes, PALETTE_COLORS - 1) : 0;
+    for (int i = 0; i < box_count; i++) {
+        Uint64 n = 0, r = 0, g = 0, b = 0;
+        for (int j = boxes[i].start; j < boxes[i].end; j++) {
+            int cell = cells[j];
+            n += hist.count[cell];
+            r += hist.sum[cell * 3 + 0];
+            g += hist.sum[cell * 3 + 1];
+            b += hist.sum[cell * 3 + 2];
+        }
+        if (n == 0) continue;
+        pal->colors[i + 1] = ((Uint32)(r / n) << 24) | ((Uint32)(g / n) << 16) | ((Uint32)(b / n) << 8) | 0xFF;
+    }
+    // Entrées inutilisées: rampe de gris pour les tons assombris
+    for (int i = box_count + 1; i < PALETTE_COLORS; i++) {
+        Uint32 v = (Uint32)((i - box_count) * 255 / (PALETTE_COLORS - box_count));
+        pal->colors[i] = (v << 24) | (v << 16) | (v << 8) | 0xFF;
+    }
+    
+    free(hist.count);
+    free(hist.sum);
+    free(cells);
+    free(boxes);
+    
+    palette_build_inverse(pal);
+    palette_build_colormaps(pal);
+    if (!palette_index_textures(pal, tm)) {
+        palette_destroy(pal);
+        return NULL;
+    }
+    
+    double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    printf("Palette 8 bits: %d couleurs, %d teintes x %d niveaux de lumière (%.1f ms)\n",
+           box_count + 1, PALETTE_TINTS, PALETTE_LIGHT_LEVELS, ms);
+    return pal;
+}
+
+void palette_destroy(Palette* pal) {
+    if (!pal) return;
+    free(pal->texels);
+    free(pal);
+}
@@ -0,0 +1,33 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <SDL2/SDL.h>
+#include "textures.h"
+
+#define PALETTE_COLORS 256
+#define PALETTE_LIGHT_LEVELS 64     // Tables d'éclairage (colormaps)
+#define PALETTE_LIGHT_UNIT 32       // Niveau d'un facteur de lumière de 1.0 (sature à ~2.0)
+#define PALETTE_TINT_STEPS 3        // Teinte de lumière: 3 niveaux par canal (0.4, 0.7, 1.0)
+#define PALETTE_TINTS (PALETTE_TINT_STEPS * PALETTE_TINT_STEPS * PALETTE_TINT_STEPS)
+#define PALETTE_TINT_NEUTRAL (PALETTE_TINTS - 1)
+#define PALETTE_INVERSE_BITS 5      // Table RGB 5:5:5 -> index le plus proche
+
+// Palette partagée par toutes les textures pour le mode 8 bits.
+// Les texels indexés suivent exactement la disposition de l'arène de textures:
+// un même TextureEntry sert à échantillonner les deux.
+typedef struct {
+    Uint32 colors[PALETTE_COLORS];                          // RGBA8888
+    // Index éclairé par teinte et niveau de lumière (colormaps à la Doom, teintées)
+    Uint8 colormap[PALETTE_TINTS][PALETTE_LIGHT_LEVELS][PALETTE_COLORS];
+    Uint8 inverse[1 << (3 * PALETTE_INVERSE_BITS)];
+    Uint8* texels;                                          // 1 octet par texel
+    Uint32 texel_capacity;
+} Palette;
+
+Palette* palette_create(const TextureManager* tm);
+int palette_index_textures(Palette* pal, const TextureManager* tm);
+void palette_destroy(Palette* pal);
+Uint8 palette_nearest(const Palette* pal, Uint32 color);
+const Uint8* palette_light_table(const Palette* pal, float r, float g, float b);
+
+#endif
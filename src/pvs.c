@@ -0,0 +1,636 @@
+#include "pvs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PVS_SPAN (2 * PVS_MAX_RADIUS + 1)   // Côté du carré de travail
+
+static inline int pvs_solid(const Map* map, int x, int y) {
+    return MAP_TILE(map, LAYER_WALL, x, y).type == TILE_SOLID;
+}
+
+static inline PvsBlock* pvs_block(const Pvs* pvs, int x, int y) {
+    return pvs->blocks[(y / PVS_BLOCK) * pvs->blocks_x + x / PVS_BLOCK];
+}
+
+// Cellule d'une tile de la map, NULL si son bloc n'est pas encore alloué
+static inline PvsCell* pvs_cell(const Pvs* pvs, int x, int y) {
+    PvsBlock* block = pvs_block(pvs, x, y);
+    return block ? &block->cells[(y % PVS_BLOCK) * PVS_BLOCK + x % PVS_BLOCK] : NULL;
+}
+
+// Pseudo-angle dans [0, 4] (losange): croît avec l'angle réel, sans atan2
+static inline float pvs_angle(float dx, float dy) {
+    if (dy >= 0) {
+        return dx >= 0 ? dy / (dx + dy) : 1.0f - dx / (dy - dx);
+    }
+    return dx < 0 ? 2.0f - dy / (-dx - dy) : 3.0f + dx / (dx - dy);
+}
+
+// Étendue angulaire de points (coins d'une forme convexe ne contenant pas l'origine,
+// donc vue sous moins d'un demi-tour). Une étendue qui passe par la direction 0
+// donne deux morceaux [lo, 4] et [0, hi]: renvoie 1 dans ce cas
+static int pvs_extent(const float* dx, const float* dy, int n, float* lo, float* hi) {
+    float a[4];
+    float min = 4.0f, max = 0.0f;
+    for (int i = 0; i < n; i++) {
+        a[i] = pvs_angle(dx[i], dy[i]);
+        if (a[i] < min) min = a[i];
+        if (a[i] > max) max = a[i];
+    }
+    if (max - min <= 2.0f) {
+        *lo = min;
+        *hi = max;
+        return 0;
+    }
+    *lo = 4.0f;
+    *hi = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (a[i] >= 2.0f && a[i] < *lo) *lo = a[i];
+        if (a[i] < 2.0f && a[i] > *hi) *hi = a[i];
+    }
+    return 1;
+}
+
+// Intervalles masqués (paires lo, hi triées et disjointes): [lo, hi] est-il entièrement caché?
+static int pvs_shadowed(const float* shadows, int count, float lo, float hi) {
+    int a = 0, b = count - 1, found = -1;
+    while (a <= b) {
+        int m = (a + b) / 2;
+        if (shadows[2 * m] <= lo) {
+            found = m;
+            a = m + 1;
+        } else {
+            b = m - 1;
+        }
+    }
+    return found >= 0 && hi <= shadows[2 * found + 1];
+}
+
+// Ajouter [lo, hi] en fusionnant les intervalles qu'il touche (deux murs voisins
+// partagent un coin: mêmes valeurs exactes, pas de fente entre eux)
+static int pvs_shadow_add(Pvs* pvs, int count, float lo, float hi) {
+    if (count + 1 > pvs->shadow_capacity) {
+        int capacity = pvs->shadow_capacity * 2;
+        float* shadows = realloc(pvs->shadows, capacity * 2 * sizeof(float));
+        if (!shadows) return count;   // Rien de caché en plus: reste prudent
+        pvs->shadows = shadows;
+        pvs->shadow_capacity = capacity;
+    }
+
+    float* s = pvs->shadows;
+    int i = 0;
+    while (i < count && s[2 * i + 1] < lo) i++;
+    int j = i;
+    while (j < count && s[2 * j] <= hi) j++;
+    if (i < j) {
+        if (s[2 * i] < lo) lo = s[2 * i];
+        if (s[2 * (j - 1) + 1] > hi) hi = s[2 * (j - 1) + 1];
+    }
+    memmove(&s[2 * (i + 1)], &s[2 * j], (count - j) * 2 * sizeof(float));
+    s[2 * i] = lo;
+    s[2 * i + 1] = hi;
+    return count - (j - i) + 1;
+}
+
+// Tiles marquées rangées en (y << 16) | x: pas de division pour les relire.
+// Les marques couvrent le carré de travail de la tile en cours (origin_x, origin_y)
+static inline int pvs_mark_index(const Pvs* pvs, int x, int y) {
+    return (y - pvs->origin_y) * PVS_SPAN + (x - pvs->origin_x);
+}
+
+static inline void pvs_mark(Pvs* pvs, int x, int y, int* touched_count) {
+    int index = pvs_mark_index(pvs, x, y);
+    if (!pvs->marks[index]) {
+        pvs->marks[index] = 1;
+        pvs->touched[(*touched_count)++] = (y << 16) | x;
+    }
+}
+
+static int pvs_hidden(const Pvs* pvs, int count, const float* dx, const float* dy, int n) {
+    float lo, hi;
+    if (pvs_extent(dx, dy, n, &lo, &hi)) {
+        return pvs_shadowed(pvs->shadows, count, lo, 4.0f) && pvs_shadowed(pvs->shadows, count, 0.0f, hi);
+    }
+    return pvs_shadowed(pvs->shadows, count, lo, hi);
+}
+
+static int pvs_add_segment(Pvs* pvs, int count, float ax, float ay, float bx, float by) {
+    float dx[2] = {ax, bx};
+    float dy[2] = {ay, by};
+    float lo, hi;
+    if (pvs_extent(dx, dy, 2, &lo, &hi)) {
+        count = pvs_shadow_add(pvs, count, lo, 4.0f);
+        return pvs_shadow_add(pvs, count, 0.0f, hi);
+    }
+    return pvs_shadow_add(pvs, count, lo, hi);
+}
+
+// Position sur le périmètre de l'anneau r (ordre du balayage: du coin haut-gauche,
+// sens croissant du pseudo-angle) de la tile que touche la direction a
+static int pvs_ring_position(float a, int r) {
+    float dx, dy;
+    if (a < 1.0f) {
+        dx = 1.0f - a; dy = a;
+    } else if (a < 2.0f) {
+        dx = 1.0f - a; dy = 2.0f - a;
+    } else if (a < 3.0f) {
+        dx = a - 3.0f; dy = 2.0f - a;
+    } else {
+        dx = a - 3.0f; dy = a - 4.0f;
+    }
+    float m = fabsf(dx) > fabsf(dy) ? fabsf(dx) : fabsf(dy);
+    int i = (int)floorf(dx / m * r + 0.5f);
+    int j = (int)floorf(dy / m * r + 0.5f);
+    if (i < -r) i = -r;
+    if (i > r) i = r;
+    if (j < -r) j = -r;
+    if (j > r) j = r;
+    if (j == -r && i < r) return i + r;
+    if (i == r && j < r) return 3 * r + j;
+    if (j == r && i > -r) return 5 * r - i;
+    return 7 * r - j;
+}
+
+// Marquer les positions de l'anneau dont la cible élargie peut couper une direction
+// libre (les ombres sont triées: les trous sont entre elles)
+static void pvs_ring_candidates(Pvs* pvs, int count, int r) {
+    int size = 8 * r;
+    float start = 0.0f;
+    for (int k = 0; k <= count; k++) {
+        float end = k < count ? pvs->shadows[2 * k] : 4.0f;
+        if (end > start) {
+            if (end - start >= 2.0f) {
+                memset(pvs->candidates, 1, size);
+                return;
+            }
+            int p0 = pvs_ring_position(start, r);
+            int p1 = pvs_ring_position(end, r);
+            int span = ((p1 - p0) % size + size) % size + 5;
+            if (span > size) span = size;
+            for (int i = 0; i < span; i++) {
+                pvs->candidates[((p0 - 2 + i) % size + size) % size] = 1;
+            }
+        }
+        if (k < count && pvs->shadows[2 * k + 1] > start) start = pvs->shadows[2 * k + 1];
+    }
+}
+
+// Tiles potentiellement visibles depuis un point quelconque de la tile (tx, ty).
+// Un point s = c + d de la tile (c son centre, |d| < 0.5 sur chaque axe) voit t si et
+// seulement si c voit t - d avec les murs décalés de -d, qui contiennent toujours les
+// murs érodés d'une demi-tile: les segments entre centres de murs voisins. On balaie
+// donc depuis le centre, contre ces segments, des cibles élargies d'une demi-tile:
+// le résultat contient tout ce qui est visible depuis la tile.
+// Balayage par anneaux de tiles de plus en plus éloignés: un segment n'est ajouté
+// qu'une fois ses deux murs passés, donc toujours devant les cibles testées ensuite.
+// Seules les tiles de l'anneau face aux trous entre les ombres sont examinées.
+// Renvoie 1 si le balayage s'est arrêté à PVS_MAX_RADIUS avant le bord de la map
+// sans tout masquer: les tiles au-delà restent alors visibles
+static int pvs_sweep(Pvs* pvs, Map* map, int tx, int ty, int* touched_count) {
+    int w = map->width;
+    int h = map->height;
+    int max_ring = tx;
+    if (w - 1 - tx > max_ring) max_ring = w - 1 - tx;
+    if (ty > max_ring) max_ring = ty;
+    if (h - 1 - ty > max_ring) max_ring = h - 1 - ty;
+    int bounded = max_ring > PVS_MAX_RADIUS;
+    if (bounded) max_ring = PVS_MAX_RADIUS;
+
+    int count = 0;
+    for (int r = 1; r <= max_ring; r++) {
+        int walls = 0;
+        if (r == 1) {
+            memset(pvs->candidates, 1, 8);
+        } else {
+            pvs_ring_candidates(pvs, count, r);
+        }
+        for (int side = 0; side < 4; side++) {
+            // Côté de l'anneau limité à la map: x ou y fixe, l'autre suit i
+            int fixed = side == 0 ? ty - r : side == 1 ? tx + r : side == 2 ? ty + r : tx - r;
+            if (fixed < 0 || fixed >= ((side & 1) ? w : h)) continue;
+            int origin = side == 0 ? tx - r : side == 1 ? ty - r : side == 2 ? tx + r : ty + r;
+            int dir = side < 2 ? 1 : -1;
+            int limit = (side & 1) ? h : w;
+            int i0 = dir > 0 ? -origin : origin - (limit - 1);
+            int i1 = dir > 0 ? limit - origin : origin + 1;
+            if (i0 < 0) i0 = 0;
+            if (i1 > 2 * r) i1 = 2 * r;
+            const Uint8* candidates = pvs->candidates + side * 2 * r;
+            for (int i = i0; i < i1; i++) {
+                if (!candidates[i]) continue;
+                int x = (side & 1) ? fixed : origin + dir * i;
+                int y = (side & 1) ? origin + dir * i : fixed;
+                if (pvs_solid(map, x, y)) pvs->ring[walls++] = (y << 16) | x;
+
+                // Cible élargie: [x - 0.5, x + 1.5] relativement au centre (tx + 0.5)
+                float dx0 = (float)(x - tx) - 1.0f, dx1 = (float)(x - tx) + 1.0f;
+                float dy0 = (float)(y - ty) - 1.0f, dy1 = (float)(y - ty) + 1.0f;
+                float dx[4] = {dx0, dx1, dx0, dx1};
+                float dy[4] = {dy0, dy0, dy1, dy1};
+                if (r == 1 || count == 0 || !pvs_hidden(pvs, count, dx, dy, 4)) {
+                    pvs_mark(pvs, x, y, touched_count);
+                }
+            }
+        }
+        memset(pvs->candidates, 0, 8 * r);
+
+        // Segments vers les murs voisins déjà passés (anneau inférieur ou le même;
+        // un segment ajouté deux fois se fond dans son ombre)
+        for (int k = 0; k < walls; k++) {
+            int x = pvs->ring[k] & 0xFFFF;
+            int y = pvs->ring[k] >> 16;
+            static const int neighbors[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+            for (int n = 0; n < 4; n++) {
+                int nx = x + neighbors[n][0];
+                int ny = y + neighbors[n][1];
+                if (nx < 0 || nx >= w || ny < 0 || ny >= h || !pvs_solid(map, nx, ny)) continue;
+                int nr = abs(nx - tx) > abs(ny - ty) ? abs(nx - tx) : abs(ny - ty);
+                if (nr > r) continue;
+                count = pvs_add_segment(pvs, count, (float)(x - tx), (float)(y - ty),
+                                        (float)(nx - tx), (float)(ny - ty));
+            }
+        }
+        if (count == 1 && pvs->shadows[0] <= 0.0f && pvs->shadows[1] >= 4.0f) return 0;
+    }
+    return bounded;
+}
+
+// Recopier les ensembles vivants du bloc dans une arène neuve à leur taille exacte
+static void pvs_compact(Pvs* pvs, PvsBlock* block) {
+    Uint32 live = block->bits_used - block->bits_garbage;
+    Uint32* bits = malloc((live ? live : 1) * sizeof(Uint32));
+    if (!bits) return;
+
+    Uint32 used = 0;
+    for (int i = 0; i < PVS_BLOCK * PVS_BLOCK; i++) {
+        PvsCell* cell = &block->cells[i];
+        if (cell->w == 0) {
+            cell->words = 0;
+            continue;
+        }
+        Uint32 words = ((Uint32)cell->w * cell->h + 31) / 32;
+        memcpy(bits + used, block->bits + cell->offset, words * sizeof(Uint32));
+        cell->offset = used;
+        cell->words = words;
+        used += words;
+    }
+    free(block->bits);
+    block->bits = bits;
+    pvs->bits_used -= block->bits_used - used;
+    pvs->bits_garbage -= block->bits_garbage;
+    block->bits_used = used;
+    block->bits_capacity = live ? live : 1;
+    block->bits_garbage = 0;
+}
+
+// Réserver des mots dans l'arène du bloc, 0 en cas d'échec. Avant de l'agrandir,
+// elle est compactée si les ensembles remplacés en occupent plus de la moitié
+static int pvs_reserve(Pvs* pvs, PvsBlock* block, Uint32 words) {
+    if (block->bits_used + words <= block->bits_capacity) return 1;
+    if (block->bits_garbage > block->bits_used / 2) {
+        pvs_compact(pvs, block);
+        if (block->bits_used + words <= block->bits_capacity) return 1;
+    }
+    Uint32 capacity = block->bits_capacity ? block->bits_capacity : 1024;
+    while (block->bits_used + words > capacity) capacity *= 2;
+    Uint32* bits = realloc(block->bits, capacity * sizeof(Uint32));
+    if (!bits) return 0;
+    block->bits = bits;
+    block->bits_capacity = capacity;
+    return 1;
+}
+
+// Bloc d'une tile, alloué au besoin (NULL en cas d'échec)
+static PvsBlock* pvs_block_alloc(Pvs* pvs, int x, int y) {
+    PvsBlock** block = &pvs->blocks[(y / PVS_BLOCK) * pvs->blocks_x + x / PVS_BLOCK];
+    if (!*block) {
+        *block = calloc(1, sizeof(PvsBlock));
+        if (!*block) {
+            printf("Erreur allocation PVS du bloc (%d, %d)\n", x / PVS_BLOCK, y / PVS_BLOCK);
+            return NULL;
+        }
+    }
+    return *block;
+}
+
+static void pvs_block_free(Pvs* pvs, PvsBlock* block) {
+    for (int i = 0; i < PVS_BLOCK * PVS_BLOCK; i++) {
+        pvs->cells_ready -= block->cells[i].ready;
+    }
+    pvs->bits_used -= block->bits_used;
+    pvs->bits_garbage -= block->bits_garbage;
+    free(block->bits);
+    free(block);
+}
+
+// Ensemble d'une tile, rangé dans son rectangle englobant
+static void pvs_compute_cell(Pvs* pvs, Map* map, int tx, int ty) {
+    PvsBlock* block = pvs_block_alloc(pvs, tx, ty);
+    if (!block) return;
+    PvsCell* cell = pvs_cell(pvs, tx, ty);
+    if (!cell->ready) {
+        cell->ready = 1;
+        pvs->cells_ready++;
+    }
+    cell->bounded = 0;
+    if (pvs_solid(map, tx, ty)) {
+        cell->w = cell->h = 0;
+        return;
+    }
+
+    int touched = 0;
+    pvs->origin_x = tx - PVS_MAX_RADIUS;
+    pvs->origin_y = ty - PVS_MAX_RADIUS;
+    pvs_mark(pvs, tx, ty, &touched);
+    cell->bounded = pvs_sweep(pvs, map, tx, ty, &touched);
+
+    // Rectangle englobant puis bits
+    int x0 = tx, y0 = ty, x1 = tx, y1 = ty;
+    for (int k = 0; k < touched; k++) {
+        int x = pvs->touched[k] & 0xFFFF;
+        int y = pvs->touched[k] >> 16;
+        if (x < x0) x0 = x;
+        if (x > x1) x1 = x;
+        if (y < y0) y0 = y;
+        if (y > y1) y1 = y;
+    }
+    int cw = x1 - x0 + 1;
+    int ch = y1 - y0 + 1;
+    Uint32 words = ((Uint32)cw * ch + 31) / 32;
+    if (words > cell->words) {
+        if (!pvs_reserve(pvs, block, words)) {
+            // Sans place: tout est visible depuis cette tile
+            printf("Erreur allocation PVS de la tile (%d, %d)\n", tx, ty);
+            cell->w = cell->h = 0;
+            for (int k = 0; k < touched; k++) {
+                pvs->marks[pvs_mark_index(pvs, pvs->touched[k] & 0xFFFF, pvs->touched[k] >> 16)] = 0;
+            }
+            return;
+        }
+        block->bits_garbage += cell->words;
+        pvs->bits_garbage += cell->words;
+        cell->offset = block->bits_used;
+        cell->words = words;
+        block->bits_used += words;
+        pvs->bits_used += words;
+    }
+    cell->x0 = x0;
+    cell->y0 = y0;
+    cell->w = cw;
+    cell->h = ch;
+
+    Uint32* bits = block->bits + cell->offset;
+    memset(bits, 0, cell->words * sizeof(Uint32));
+    for (int k = 0; k < touched; k++) {
+        int x = pvs->touched[k] & 0xFFFF;
+        int y = pvs->touched[k] >> 16;
+        int bit = (y - y0) * cw + (x - x0);
+        bits[bit >> 5] |= 1u << (bit & 31);
+        pvs->marks[pvs_mark_index(pvs, x, y)] = 0;
+    }
+}
+
+Pvs* pvs_build(Map* map) {
+    Pvs* pvs = calloc(1, sizeof(Pvs));
+    if (!pvs) {
+        printf("Erreur allocation PVS\n");
+        return NULL;
+    }
+    pvs->width = map->width;
+    pvs->height = map->height;
+    pvs->blocks_x = (map->width + PVS_BLOCK - 1) / PVS_BLOCK;
+    pvs->blocks_y = (map->height + PVS_BLOCK - 1) / PVS_BLOCK;
+    pvs->blocks = calloc(pvs->blocks_x * pvs->blocks_y, sizeof(PvsBlock*));
+    pvs->evict_next = -1;
+    pvs->marks = calloc(PVS_SPAN * PVS_SPAN, 1);
+    pvs->touched = malloc(PVS_SPAN * PVS_SPAN * sizeof(int));
+    pvs->ring = malloc(8 * PVS_MAX_RADIUS * sizeof(int));
+    pvs->candidates = calloc(8 * PVS_MAX_RADIUS, 1);
+    pvs->shadow_capacity = 64;
+    pvs->shadows = malloc(pvs->shadow_capacity * 2 * sizeof(float));
+    if (!pvs->blocks || !pvs->marks || !pvs->touched || !pvs->ring || !pvs->candidates || !pvs->shadows) {
+        printf("Erreur allocation PVS %dx%d\n", map->width, map->height);
+        pvs_destroy(pvs);
+        return NULL;
+    }
+
+    // Grande map: calcul progressif autour du joueur (pvs_prepare)
+    if (map->width * map->height > PVS_EAGER_TILES) return pvs;
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            pvs_compute_cell(pvs, map, x, y);
+        }
+    }
+    return pvs;
+}
+
+void pvs_destroy(Pvs* pvs) {
+    if (!pvs) return;
+    if (pvs->blocks) {
+        for (int b = 0; b < pvs->blocks_x * pvs->blocks_y; b++) {
+            if (pvs->blocks[b]) {
+                free(pvs->blocks[b]->bits);
+                free(pvs->blocks[b]);
+            }
+        }
+    }
+    free(pvs->blocks);
+    free(pvs->marks);
+    free(pvs->touched);
+    free(pvs->ring);
+    free(pvs->candidates);
+    free(pvs->shadows);
+    free(pvs);
+}
+
+// Ensembles au-delà de PVS_MAX_WORDS: les blocs hors des 3x3 autour du joueur sont
+// libérés avec leurs ensembles (recalculés s'il y revient), sans rien recopier.
+// La libération reprend d'une frame à l'autre tant que le budget est dépassé
+static void pvs_evict(Pvs* pvs, int tx, int ty, Uint64 start, Uint64 budget) {
+    if (pvs->evict_next < 0) {
+        if (pvs->bits_used - pvs->bits_garbage <= PVS_MAX_WORDS) return;
+        pvs->evict_next = 0;
+    }
+    int bx = tx / PVS_BLOCK;
+    int by = ty / PVS_BLOCK;
+    for (; pvs->evict_next < pvs->blocks_x * pvs->blocks_y; pvs->evict_next++) {
+        int b = pvs->evict_next;
+        PvsBlock* block = pvs->blocks[b];
+        if (!block || (abs(b % pvs->blocks_x - bx) <= 1 && abs(b / pvs->blocks_x - by) <= 1)) continue;
+        if (SDL_GetPerformanceCounter() - start > budget) return;
+        pvs_block_free(pvs, block);
+        pvs->blocks[b] = NULL;
+    }
+    pvs->evict_next = -1;
+}
+
+int pvs_prepare(Pvs* pvs, Map* map, float x, float y) {
+    if (!pvs || map->width != pvs->width || map->height != pvs->height) return 0;
+    if (pvs->cells_ready == pvs->width * pvs->height) return 0;
+    int tx = (int)floorf(x);
+    int ty = (int)floorf(y);
+    if (tx < 0 || tx >= pvs->width || ty < 0 || ty >= pvs->height) return 0;
+
+    // Libération des blocs lointains puis anneaux autour du joueur, du plus proche
+    // au plus lointain, dans le même budget: sa tile est toujours calculée, les
+    // suivantes tant que le budget le permet
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = (Uint64)(PVS_PREFETCH_MS * SDL_GetPerformanceFrequency() / 1000.0);
+    pvs_evict(pvs, tx, ty, start, budget);
+    int computed = 0;
+    for (int r = 0; r <= PVS_PREFETCH_RADIUS; r++) {
+        for (int cy = ty - r; cy <= ty + r; cy++) {
+            int step = cy == ty - r || cy == ty + r ? 1 : 2 * r;
+            for (int cx = tx - r; cx <= tx + r; cx += step) {
+                if (cx < 0 || cx >= pvs->width || cy < 0 || cy >= pvs->height) continue;
+                const PvsCell* cell = pvs_cell(pvs, cx, cy);
+                if (cell && cell->ready) continue;
+                if (computed > 0 && SDL_GetPerformanceCounter() - start > budget) return computed;
+                pvs_compute_cell(pvs, map, cx, cy);
+                computed++;
+            }
+        }
+    }
+    return computed;
+}
+
+void pvs_update(Pvs* pvs, Map* map, int x0, int y0, int x1, int y1) {
+    if (!pvs || map->width != pvs->width || map->height != pvs->height) return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= pvs->width) x1 = pvs->width - 1;
+    if (y1 >= pvs->height) y1 = pvs->height - 1;
+    if (x1 < x0 || y1 < y0) return;
+
+    // Une ligne de vue qui s'ouvre ou se ferme passe par la zone: les tiles
+    // concernées voyaient déjà une tile de la zone (le mur qui s'ouvre, au moins).
+    // On relève d'abord les tiles à recalculer, leurs ensembles changeant en route.
+    // Les tiles pas encore calculées le seront sur la map à jour
+    int w = pvs->width;
+    int* pending = malloc((pvs->cells_ready ? pvs->cells_ready : 1) * sizeof(int));
+    if (!pending) {
+        printf("Erreur allocation mise à jour du PVS\n");
+        return;
+    }
+    int pending_count = 0;
+    for (int b = 0; b < pvs->blocks_x * pvs->blocks_y; b++) {
+        const PvsBlock* block = pvs->blocks[b];
+        if (!block) continue;
+        for (int i = 0; i < PVS_BLOCK * PVS_BLOCK; i++) {
+            const PvsCell* cell = &block->cells[i];
+            if (!cell->ready) continue;
+            int x = (b % pvs->blocks_x) * PVS_BLOCK + i % PVS_BLOCK;
+            int y = (b / pvs->blocks_x) * PVS_BLOCK + i / PVS_BLOCK;
+            int affected = x >= x0 && x <= x1 && y >= y0 && y <= y1;
+            if (!affected && cell->w > 0 &&
+                x1 >= cell->x0 && x0 < cell->x0 + cell->w && y1 >= cell->y0 && y0 < cell->y0 + cell->h) {
+                for (int ty = y0; ty <= y1 && !affected; ty++) {
+                    for (int tx = x0; tx <= x1 && !affected; tx++) {
+                        affected = pvs_tile_visible(pvs, x, y, tx, ty);
+                    }
+                }
+            }
+            if (affected) {
+                pending[pending_count++] = y * w + x;
+            }
+        }
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int k = 0; k < pending_count; k++) {
+        pvs_compute_cell(pvs, map, pending[k] % w, pending[k] / w);
+    }
+    free(pending);
+    for (int b = 0; b < pvs->blocks_x * pvs->blocks_y; b++) {
+        PvsBlock* block = pvs->blocks[b];
+        if (block && block->bits_garbage > block->bits_used / 2) {
+            pvs_compact(pvs, block);
+        }
+    }
+    printf("PVS: %d tiles recalculées (%.1f ms)\n", pending_count,
+           (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
+int pvs_tile_visible(const Pvs* pvs, int from_x, int from_y, int x, int y) {
+    if (!pvs || from_x < 0 || from_x >= pvs->width || from_y < 0 || from_y >= pvs->height) return 1;
+    const PvsCell* cell = pvs_cell(pvs, from_x, from_y);
+    if (!cell || !cell->ready || cell->w == 0) return 1;
+    int lx = x - cell->x0;
+    int ly = y - cell->y0;
+    if (lx < 0 || lx >= cell->w || ly < 0 || ly >= cell->h) {
+        // Hors du rectangle: cachée, sauf au-delà d'un balayage arrêté en route
+        return cell->bounded && (abs(x - from_x) > PVS_MAX_RADIUS || abs(y - from_y) > PVS_MAX_RADIUS);
+    }
+    int bit = ly * cell->w + lx;
+    return (pvs_block(pvs, from_x, from_y)->bits[cell->offset + (bit >> 5)] >> (bit & 31)) & 1;
+}
+
+// La lumière atteint-elle une tile visible depuis (tx, ty)? Zone d'effet de tile_lights
+// quand elle existe, sinon son rayon élargi comme pour le culling du champ de vue
+static int pvs_light_reaches(const Pvs* pvs, const PvsCell* cell, int tx, int ty, LightManager* lm, Light* light) {
+    int x0, y0, x1, y1;
+    Uint32 bit = 0;
+    if (lm->tile_lights && light->slot >= 0) {
+        if (light->area_x0 < 0) return 1;
+        x0 = light->area_x0;
+        y0 = light->area_y0;
+        x1 = light->area_x1;
+        y1 = light->area_y1;
+        bit = 1u << light->slot;
+    } else {
+        float reach = light->radius + LIGHT_CULL_MARGIN;
+        x0 = (int)floorf(light->x - reach);
+        y0 = (int)floorf(light->y - reach);
+        x1 = (int)floorf(light->x + reach);
+        y1 = (int)floorf(light->y + reach);
+    }
+    if (cell->bounded && (x0 < tx - PVS_MAX_RADIUS || x1 > tx + PVS_MAX_RADIUS ||
+                          y0 < ty - PVS_MAX_RADIUS || y1 > ty + PVS_MAX_RADIUS)) {
+        return 1;
+    }
+    if (x0 < cell->x0) x0 = cell->x0;
+    if (y0 < cell->y0) y0 = cell->y0;
+    if (x1 >= cell->x0 + cell->w) x1 = cell->x0 + cell->w - 1;
+    if (y1 >= cell->y0 + cell->h) y1 = cell->y0 + cell->h - 1;
+
+    const Uint32* bits = pvs_block(pvs, tx, ty)->bits + cell->offset;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int index = (y - cell->y0) * cell->w + (x - cell->x0);
+            if (!((bits[index >> 5] >> (index & 31)) & 1)) continue;
+            if (bit && !(lm->tile_lights[y * lm->grid_width + x] & bit)) continue;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Retirer des lumières de la frame (après lighting_cull_view) celles qui n'éclairent
+// aucune tile visible depuis la tile du joueur
+int pvs_cull_lights(const Pvs* pvs, LightManager* lm, float x, float y) {
+    int tx = (int)floorf(x);
+    int ty = (int)floorf(y);
+    if (!pvs || tx < 0 || tx >= pvs->width || ty < 0 || ty >= pvs->height) return lm->visible_count;
+    const PvsCell* cell = pvs_cell(pvs, tx, ty);
+    if (!cell || !cell->ready || cell->w == 0) return lm->visible_count;
+    if (lm->tile_lights && (lm->grid_width != pvs->width || lm->grid_height != pvs->height)) {
+        return lm->visible_count;
+    }
+
+    int kept = 0;
+    Uint32 slots = 0;
+    for (int i = 0; i < lm->visible_count; i++) {
+        int light_idx = lm->visible_lights[i];
+        Light* light = &lm->lights[light_idx];
+        if (!pvs_light_reaches(pvs, cell, tx, ty, lm, light)) continue;
+        lm->visible_lights[kept++] = light_idx;
+        if (light->slot >= 0) {
+            slots |= 1u << light->slot;
+        }
+    }
+    lm->visible_count = kept;
+    lm->visible_slots = slots;
+    return kept;
+}
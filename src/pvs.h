@@ -0,0 +1,73 @@
+#ifndef PVS_H
+#define PVS_H
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "../editor/lighting.h"
+
+#define PVS_EAGER_TILES (64 * 64)    // Jusque-là, tout est calculé au chargement; au-delà, autour du joueur
+#define PVS_MAX_RADIUS 64            // Anneaux balayés depuis une tile: plus loin, tout est visible
+#define PVS_BLOCK 16                 // Cellules allouées par blocs de PVS_BLOCK x PVS_BLOCK tiles
+#define PVS_PREFETCH_RADIUS 8        // Tiles calculées d'avance autour du joueur
+#define PVS_PREFETCH_MS 1.0          // Budget par frame de ce calcul d'avance
+#define PVS_MAX_WORDS (8u << 20)     // 32 Mo d'ensembles: au-delà, les blocs loin du joueur sont libérés
+
+// Tiles potentiellement visibles depuis une tile vide, en bits (ligne par ligne)
+// dans son rectangle englobant
+typedef struct {
+    int x0, y0;
+    int w, h;                     // 0 pour une tile pleine
+    Uint32 offset;                // Premier mot dans Pvs.bits
+    Uint32 words;                 // Mots réservés (réutilisés si le nouvel ensemble tient)
+    Uint8 ready;                  // 0: pas encore calculée (tout est visible depuis elle)
+    Uint8 bounded;                // Balayage arrêté à PVS_MAX_RADIUS: tout est visible au-delà
+} PvsCell;
+
+// Bloc de PVS_BLOCK x PVS_BLOCK tiles et l'arène de leurs ensembles: libérer le bloc
+// libère ses ensembles, compacter l'arène ne recopie que les siens
+typedef struct {
+    PvsCell cells[PVS_BLOCK * PVS_BLOCK];
+    Uint32* bits;                 // Arène des ensembles du bloc
+    Uint32 bits_used;
+    Uint32 bits_capacity;
+    Uint32 bits_garbage;          // Mots d'ensembles remplacés, récupérés par compactage
+} PvsBlock;
+
+typedef struct Pvs {
+    int width, height;
+    int blocks_x, blocks_y;
+    PvsBlock** blocks;            // [blocks_x * blocks_y], NULL tant qu'aucune cellule du bloc n'est calculée
+    int cells_ready;
+    Uint32 bits_used;             // Totaux des arènes des blocs
+    Uint32 bits_garbage;
+    int evict_next;               // Prochain bloc examiné par la libération en cours, -1 sinon
+
+    // Travail de la construction (réutilisé par les mises à jour), limité au carré
+    // de PVS_MAX_RADIUS autour de la tile en cours
+    int origin_x, origin_y;       // Coin du carré
+    Uint8* marks;                 // [(2 * PVS_MAX_RADIUS + 1)^2]
+    int* touched;                 // Tiles marquées pour la tile en cours
+    int* ring;                    // Murs examinés dans l'anneau en cours du balayage
+    Uint8* candidates;            // Positions de l'anneau face à une direction libre
+    float* shadows;               // Intervalles angulaires masqués (lo, hi)
+    int shadow_capacity;
+} Pvs;
+
+// Construction à partir de LAYER_WALL, NULL en cas d'erreur. Les grandes maps
+// (plus de PVS_EAGER_TILES) ne calculent rien ici: voir pvs_prepare
+Pvs* pvs_build(Map* map);
+void pvs_destroy(Pvs* pvs);
+
+// Avant les requêtes de la frame: calcule la tile du joueur si besoin, puis ses
+// voisines dans le budget PVS_PREFETCH_MS. Renvoie le nombre de tiles calculées
+int pvs_prepare(Pvs* pvs, Map* map, float x, float y);
+
+// Tiles modifiées (rectangle inclusif): seules les tiles qui voyaient la zone,
+// et celles de la zone, sont recalculées
+void pvs_update(Pvs* pvs, Map* map, int x0, int y0, int x1, int y1);
+
+// Requêtes (prudentes: 1 sans PVS ou depuis une tile pleine/hors map)
+int pvs_tile_visible(const Pvs* pvs, int from_x, int from_y, int x, int y);
+int pvs_cull_lights(const Pvs* pvs, LightManager* lm, float x, float y);
+
+#endif
@@ -1,362 +1,2301 @@
-#include "raycaster.h"
-#include <stdio.h>
-#include <math.h>
-#include <stdlib.h>
-
-int raycaster_init(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height) {
-    rc->renderer = renderer;
-    rc->screen_width = width;
-    rc->screen_height = height;
-    rc->light_manager = NULL;
-    
-    // Créer la texture pour le buffer d'écran
-    rc->screen_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, 
-                                         SDL_TEXTUREACCESS_STREAMING, width, height);
-    if (!rc->screen_texture) {
-        printf("Erreur création texture écran: %s\n", SDL_GetError());
-        return 0;
-    }
-    
-    // Allouer le buffer d'écran
-    rc->screen_buffer = malloc(width * height * sizeof(Uint32));
-    if (!rc->screen_buffer) {
-        printf("Erreur allocation buffer écran\n");
-        SDL_DestroyTexture(rc->screen_texture);
-        return 0;
-    }
-    
-    return 1;
-}
-
-void raycaster_set_lighting(RaycastRenderer* rc, LightManager* lm) {
-    rc->light_manager = lm;
-}
-
-void raycaster_destroy(RaycastRenderer* rc) {
-    if (rc->screen_buffer) {
-        free(rc->screen_buffer);
-        rc->screen_buffer = NULL;
-    }
-    if (rc->screen_texture) {
-        SDL_DestroyTexture(rc->screen_texture);
-        rc->screen_texture = NULL;
-    }
-}
-
-void raycaster_clear_screen(RaycastRenderer* rc, Uint32 color) {
-    for (int i = 0; i < rc->screen_width * rc->screen_height; i++) {
-        rc->screen_buffer[i] = color;
-    }
-}
-
-Uint32 raycaster_get_pixel_from_texture(Uint32* texture_pixels, int tex_x, int tex_y) {
-    if (!texture_pixels) return 0x808080FF; // Gris par défaut
-    
-    // S'assurer que les coordonnées sont dans les limites
-    tex_x = tex_x % TEXTURE_SIZE;
-    tex_y = tex_y % TEXTURE_SIZE;
-    if (tex_x < 0) tex_x += TEXTURE_SIZE;
-    if (tex_y < 0) tex_y += TEXTURE_SIZE;
-    
-    return texture_pixels[tex_y * TEXTURE_SIZE + tex_x];
-}
-
-Uint32 raycaster_darken_color(Uint32 color, float factor) {
-    Uint8 r = (color >> 24) & 0xFF;
-    Uint8 g = (color >> 16) & 0xFF;
-    Uint8 b = (color >> 8) & 0xFF;
-    Uint8 a = color & 0xFF;
-    
-    r = (Uint8)(r * factor);
-    g = (Uint8)(g * factor);
-    b = (Uint8)(b * factor);
-    
-    return (r << 24) | (g << 16) | (b << 8) | a;
-}
-
-void raycaster_render(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
-    int w = rc->screen_width;
-    int h = rc->screen_height;
-    
-    // Rendu du sol et du plafond avec textures (échantillonnage optimisé)
-    int sample_step = 2; // Échantillonner 1 pixel sur 2 pour l'éclairage
-    
-    for (int y = 0; y < h; y += sample_step) {
-        // Calculer la distance au sol/plafond pour cette ligne
-        float ray_dir_x0 = player->dir_x - player->plane_x;
-        float ray_dir_y0 = player->dir_y - player->plane_y;
-        float ray_dir_x1 = player->dir_x + player->plane_x;
-        float ray_dir_y1 = player->dir_y + player->plane_y;
-        
-        int p = y - h / 2;
-        if (p == 0) {
-            // Ligne de l'horizon - remplir avec une couleur neutre
-            for (int x = 0; x < w; x++) {
-                for (int sy = 0; sy < sample_step && y + sy < h; sy++) {
-                    rc->screen_buffer[(y + sy) * w + x] = 0x808080FF;
-                }
-            }
-            continue;
-        }
-        
-        float pos_z = 0.5 * h;
-        float row_distance = pos_z / abs(p);
-        
-        float floor_step_x = row_distance * (ray_dir_x1 - ray_dir_x0) / w;
-        float floor_step_y = row_distance * (ray_dir_y1 - ray_dir_y0) / w;
-        
-        float floor_x = player->x + row_distance * ray_dir_x0;
-        float floor_y = player->y + row_distance * ray_dir_y0;
-        
-        for (int x = 0; x < w; x += sample_step) {
-            int cell_x = (int)floor_x;
-            int cell_y = (int)floor_y;
-            
-            int tex_x = (int)(TEXTURE_SIZE * (floor_x - cell_x)) & (TEXTURE_SIZE - 1);
-            int tex_y = (int)(TEXTURE_SIZE * (floor_y - cell_y)) & (TEXTURE_SIZE - 1);
-            
-            Uint32 ceiling_color, floor_color;
-            
-            if (y < h / 2) {
-                // Rendu du plafond
-                int ceiling_tex = map_get_ceiling_texture(map, cell_x, cell_y);
-                Uint32* ceiling_pixels = textures_get_pixels(tm, ceiling_tex);
-                ceiling_color = raycaster_get_pixel_from_texture(ceiling_pixels, tex_x, tex_y);
-                
-                // Appliquer l'éclairage optimisé si disponible
-                if (rc->light_manager) {
-                    lighting_calculate_pixel_color_fast(rc->light_manager, floor_x, floor_y, ceiling_color, &ceiling_color);
-                }
-                
-                // Assombrir légèrement le plafond
-                ceiling_color = raycaster_darken_color(ceiling_color, 0.8f);
-            } else {
-                // Rendu du sol
-                int floor_tex = map_get_floor_texture(map, cell_x, cell_y);
-                Uint32* floor_pixels = textures_get_pixels(tm, floor_tex);
-                floor_color = raycaster_get_pixel_from_texture(floor_pixels, tex_x, tex_y);
-                
-                // Appliquer l'éclairage optimisé si disponible
-                if (rc->light_manager) {
-                    lighting_calculate_pixel_color_fast(rc->light_manager, floor_x, floor_y, floor_color, &floor_color);
-                }
-            }
-            
-            // Répliquer le pixel échantillonné sur la zone sample_step x sample_step
-            for (int sx = 0; sx < sample_step && x + sx < w; sx++) {
-                for (int sy = 0; sy < sample_step && y + sy < h; sy++) {
-                    if (y < h / 2) {
-                        rc->screen_buffer[(y + sy) * w + (x + sx)] = ceiling_color;
-                    } else {
-                        rc->screen_buffer[(y + sy) * w + (x + sx)] = floor_color;
-                    }
-                }
-            }
-            
-            floor_x += floor_step_x * sample_step;
-            floor_y += floor_step_y * sample_step;
-        }
-    }
-    
-    // Raycasting pour chaque colonne d'écran (rendu des murs)
-    for (int x = 0; x < w; x++) {
-        // Calculer la direction du rayon
-        float camera_x = 2 * x / (float)w - 1; // Coordonnée x dans l'espace caméra (-1 à 1)
-        float ray_dir_x = player->dir_x + player->plane_x * camera_x;
-        float ray_dir_y = player->dir_y + player->plane_y * camera_x;
-        
-        // Position actuelle dans la grille
-        int map_x = (int)player->x;
-        int map_y = (int)player->y;
-        
-        // Distance du rayon au prochain côté x ou y
-        float delta_dist_x = (ray_dir_x == 0) ? 1e30 : fabs(1 / ray_dir_x);
-        float delta_dist_y = (ray_dir_y == 0) ? 1e30 : fabs(1 / ray_dir_y);
-        
-        // Calcul du pas et de la distance initiale
-        float side_dist_x, side_dist_y;
-        int step_x, step_y;
-        
-        if (ray_dir_x < 0) {
-            step_x = -1;
-            side_dist_x = (player->x - map_x) * delta_dist_x;
-        } else {
-            step_x = 1;
-            side_dist_x = (map_x + 1.0 - player->x) * delta_dist_x;
-        }
-        
-        if (ray_dir_y < 0) {
-            step_y = -1;
-            side_dist_y = (player->y - map_y) * delta_dist_y;
-        } else {
-            step_y = 1;
-            side_dist_y = (map_y + 1.0 - player->y) * delta_dist_y;
-        }
-        
-        // DDA (Digital Differential Analyzer)
-        int hit = 0;
-        int side; // 0 pour côté NS, 1 pour côté EW
-        
-        while (hit == 0) {
-            if (side_dist_x < side_dist_y) {
-                side_dist_x += delta_dist_x;
-                map_x += step_x;
-                side = 0;
-            } else {
-                side_dist_y += delta_dist_y;
-                map_y += step_y;
-                side = 1;
-            }
-            
-            if (map_is_wall(map, map_x, map_y)) {
-                hit = 1;
-            }
-        }
-        
-        // Calcul de la distance
-        float perp_wall_dist;
-        if (side == 0) {
-            perp_wall_dist = (map_x - player->x + (1 - step_x) / 2) / ray_dir_x;
-        } else {
-            perp_wall_dist = (map_y - player->y + (1 - step_y) / 2) / ray_dir_y;
-        }
-        
-        // Calcul de la hauteur du mur à dessiner
-        int line_height = (int)(h / perp_wall_dist);
-        
-        // Calcul des pixels de début et fin
-        int draw_start = -line_height / 2 + h / 2;
-        if (draw_start < 0) draw_start = 0;
-        int draw_end = line_height / 2 + h / 2;
-        if (draw_end >= h) draw_end = h - 1;
-        
-        // Récupérer la texture du mur
-        int texture_id = map_get_wall_texture(map, map_x, map_y);
-        Uint32* texture_pixels = textures_get_pixels(tm, texture_id);
-        
-        // Calcul de la coordonnée x sur la texture
-        float wall_x;
-        if (side == 0) {
-            wall_x = player->y + perp_wall_dist * ray_dir_y;
-        } else {
-            wall_x = player->x + perp_wall_dist * ray_dir_x;
-        }
-        wall_x -= floor(wall_x);
-        
-        int tex_x = (int)(wall_x * TEXTURE_SIZE);
-        if ((side == 0 && ray_dir_x > 0) || (side == 1 && ray_dir_y < 0)) {
-            tex_x = TEXTURE_SIZE - tex_x - 1;
-        }
-        
-        // Dessiner la colonne du mur (optimisé pour l'éclairage)
-        float step = 1.0 * TEXTURE_SIZE / line_height;
-        float tex_pos = (draw_start - h / 2 + line_height / 2) * step;
-        
-        // Calculer la position mondiale du mur une seule fois
-        float wall_world_x, wall_world_y;
-        if (side == 0) {
-            wall_world_x = (float)map_x + (step_x > 0 ? 1.0f : 0.0f);
-            wall_world_y = player->y + perp_wall_dist * ray_dir_y;
-        } else {
-            wall_world_x = player->x + perp_wall_dist * ray_dir_x;
-            wall_world_y = (float)map_y + (step_y > 0 ? 1.0f : 0.0f);
-        }
-        
-        // Calculer l'éclairage une seule fois pour toute la colonne
-        float light_factor_r = 1.0f, light_factor_g = 1.0f, light_factor_b = 1.0f;
-        
-        if (rc->light_manager) {
-            // Calculer les facteurs d'éclairage une seule fois
-            float total_r = rc->light_manager->ambient_r * rc->light_manager->ambient_intensity;
-            float total_g = rc->light_manager->ambient_g * rc->light_manager->ambient_intensity;
-            float total_b = rc->light_manager->ambient_b * rc->light_manager->ambient_intensity;
-            
-            // Traiter seulement les lumières actives proches
-            for (int i = 0; i < rc->light_manager->active_count; i++) {
-                int light_idx = rc->light_manager->active_lights[i];
-                Light* light = &rc->light_manager->lights[light_idx];
-                
-                float dx = wall_world_x - light->x;
-                float dy = wall_world_y - light->y;
-                float distance_squared = dx * dx + dy * dy;
-                
-                if (distance_squared > light->radius_squared) continue;
-                
-                float attenuation = lighting_calculate_distance_attenuation_fast(distance_squared, light->radius_squared);
-                if (attenuation < MIN_LIGHT_CONTRIBUTION) continue;
-                
-                float contribution = light->intensity * attenuation;
-                total_r += light->r * contribution;
-                total_g += light->g * contribution;
-                total_b += light->b * contribution;
-            }
-            
-            light_factor_r = total_r;
-            light_factor_g = total_g;
-            light_factor_b = total_b;
-        }
-        
-        // Assombrir les côtés EW pour un effet 3D
-        if (side == 1) {
-            light_factor_r *= 0.7f;
-            light_factor_g *= 0.7f;
-            light_factor_b *= 0.7f;
-        }
-        
-        for (int y = draw_start; y < draw_end; y++) {
-            int tex_y = (int)tex_pos & (TEXTURE_SIZE - 1);
-            tex_pos += step;
-            
-            // Récupérer la couleur de texture pour cette ligne
-            Uint32 color = raycaster_get_pixel_from_texture(texture_pixels, tex_x, tex_y);
-            
-            // Appliquer l'éclairage précalculé rapidement
-            if (rc->light_manager) {
-                Uint8 r = (color >> 24) & 0xFF;
-                Uint8 g = (color >> 16) & 0xFF;
-                Uint8 b = (color >> 8) & 0xFF;
-                Uint8 a = color & 0xFF;
-                
-                int fr = (int)(r * light_factor_r);
-                int fg = (int)(g * light_factor_g);
-                int fb = (int)(b * light_factor_b);
-                
-                if (fr > 255) fr = 255;
-                if (fg > 255) fg = 255;
-                if (fb > 255) fb = 255;
-                
-                color = ((Uint8)fr << 24) | ((Uint8)fg << 16) | ((Uint8)fb << 8) | a;
-            }
-            
-            rc->screen_buffer[y * w + x] = color;
-        }
-    }
-}
-
-void raycaster_present(RaycastRenderer* rc) {
-    // Mettre à jour la texture avec le buffer
-    SDL_UpdateTexture(rc->screen_texture, NULL, rc->screen_buffer, 
-                     rc->screen_width * sizeof(Uint32));
-    
-    // Copier la texture vers le renderer
-    SDL_RenderCopy(rc->renderer, rc->screen_texture, NULL, NULL);
-    SDL_RenderPresent(rc->renderer);
-}
-
-void raycaster_list_maps(void) {
-    printf("Maps disponibles:\n");
-    printf("(Listez vos fichiers .txt dans le dossier maps/)\n");
-}
-
-int raycaster_resize(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height) {
-    // Libérer les anciennes ressources
-    if (rc->screen_buffer) {
-        free(rc->screen_buffer);
-    }
-    if (rc->screen_texture) {
-        SDL_DestroyTexture(rc->screen_texture);
-    }
-    
-    // Réinitialiser avec la nouvelle taille
-    return raycaster_init(rc, renderer, width, height);
+#include "raycaster.h"
+#include "kernels.h"
+#include "entities.h"
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef KERNELS_X86
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static void raycaster_build_shading(RaycastRenderer* rc);
+
+int raycaster_init(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height) {
+    rc->renderer = renderer;
+    rc->screen_width = width;
+    rc->screen_height = height;
+    rc->light_manager = NULL;
+    rc->palette = NULL;
+    rc->expanded = 0;
+    rc->fog_distance = 0.0f;
+    rc->fog_start = 0.0f;
+    rc->fog_color = 0x000000FF;
+    rc->wall_light_version = 0;
+    rc->checker = 0;
+    rc->checker_parity = 0;
+    rc->history = NULL;
+    rc->columns = NULL;
+    rc->history_columns = NULL;
+    rc->row_depth = NULL;
+    rc->history_valid = 0;
+    rc->checker_reprojected = 0;
+    rc->checker_interpolated = 0;
+    rc->adaptive_step = 0;
+    rc->adaptive_traced = 0;
+    rc->deferred = 0;
+    memset(&rc->gbuffer, 0, sizeof(GBuffer));
+    
+    // Créer la texture pour le buffer d'écran (sans renderer, ex: benchmarks, on ne
+    // fait que rendre dans le buffer)
+    rc->screen_texture = NULL;
+    if (renderer) {
+        rc->screen_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, 
+                                             SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!rc->screen_texture) {
+            printf("Erreur création texture écran: %s\n", SDL_GetError());
+            return 0;
+        }
+    }
+    
+    // Allouer le buffer d'écran (32 bits) et sa version indexée (mode 8 bits),
+    // le buffer des murs par colonnes et l'étendue des murs de chaque colonne
+    rc->screen_buffer = malloc(width * height * sizeof(Uint32));
+    rc->screen_buffer8 = malloc(width * height);
+    rc->column_buffer = malloc(width * height * sizeof(Uint32));
+    rc->columns = calloc(width, sizeof(ColumnDepth));
+    rc->hits = malloc(width * sizeof(RayHit));
+    rc->shade = malloc(SHADE_SURFACES * SHADE_BUCKETS * sizeof(ShadeTable));
+    rc->wall_light = calloc(WALL_LIGHT_CACHE_SIZE, sizeof(WallLightEntry));
+    rc->column_far = malloc((width + RAYCASTER_TILE - 1) / RAYCASTER_TILE * sizeof(float));
+    rc->sprite_tex_x = malloc(width * sizeof(int));
+    rc->sprite_runs = malloc((width + 1) * sizeof(int));
+    rc->sprite_row = malloc(width * sizeof(Uint32));
+    rc->sprites_visible = 0;
+    rc->sprites_drawn = 0;
+    if (!rc->screen_buffer || !rc->screen_buffer8 || !rc->column_buffer || !rc->columns ||
+        !rc->hits || !rc->shade || !rc->wall_light || !rc->column_far || !rc->sprite_tex_x ||
+        !rc->sprite_runs || !rc->sprite_row) {
+        printf("Erreur allocation buffer écran\n");
+        free(rc->screen_buffer);
+        free(rc->screen_buffer8);
+        free(rc->column_buffer);
+        free(rc->columns);
+        free(rc->hits);
+        free(rc->shade);
+        free(rc->wall_light);
+        free(rc->column_far);
+        free(rc->sprite_tex_x);
+        free(rc->sprite_runs);
+        free(rc->sprite_row);
+        rc->screen_buffer = NULL;
+        rc->screen_buffer8 = NULL;
+        rc->column_buffer = NULL;
+        rc->columns = NULL;
+        rc->hits = NULL;
+        rc->shade = NULL;
+        rc->wall_light = NULL;
+        rc->column_far = NULL;
+        rc->sprite_tex_x = NULL;
+        rc->sprite_runs = NULL;
+        rc->sprite_row = NULL;
+        if (rc->screen_texture) {
+            SDL_DestroyTexture(rc->screen_texture);
+        }
+        return 0;
+    }
+    raycaster_build_shading(rc);
+    
+    return 1;
+}
+
+void raycaster_set_lighting(RaycastRenderer* rc, LightManager* lm) {
+    rc->light_manager = lm;
+    rc->history_valid = 0;
+}
+
+void raycaster_set_palette(RaycastRenderer* rc, Palette* palette) {
+    rc->palette = palette;
+    rc->history_valid = 0;
+}
+
+static void raycaster_free_checker(RaycastRenderer* rc) {
+    free(rc->history);
+    free(rc->history_columns);
+    free(rc->row_depth);
+    rc->history = NULL;
+    rc->history_columns = NULL;
+    rc->row_depth = NULL;
+    rc->checker = 0;
+    rc->history_valid = 0;
+}
+
+int raycaster_set_checker(RaycastRenderer* rc, int enabled) {
+    if (!enabled) {
+        raycaster_free_checker(rc);
+        return 1;
+    }
+    if (rc->checker) return 1;
+    
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    rc->history = malloc(w * h * sizeof(Uint32));
+    rc->history_columns = malloc(w * sizeof(ColumnDepth));
+    rc->row_depth = malloc(h * sizeof(float));
+    if (!rc->history || !rc->history_columns || !rc->row_depth) {
+        printf("Erreur allocation historique du rendu en damier\n");
+        raycaster_free_checker(rc);
+        return 0;
+    }
+    rc->checker = 1;
+    rc->checker_parity = 0;
+    rc->history_valid = 0;
+    return 1;
+}
+
+static void raycaster_free_deferred(RaycastRenderer* rc) {
+    free(rc->gbuffer.floor_x);
+    free(rc->gbuffer.floor_y);
+    free(rc->gbuffer.rows);
+    free(rc->gbuffer.wall_u);
+    memset(&rc->gbuffer, 0, sizeof(GBuffer));
+    rc->deferred = 0;
+}
+
+int raycaster_set_deferred(RaycastRenderer* rc, int enabled) {
+    if (!enabled) {
+        raycaster_free_deferred(rc);
+        return 1;
+    }
+    if (rc->deferred) return 1;
+    
+    GBuffer* g = &rc->gbuffer;
+    g->blocks_x = (rc->screen_width + RAYCASTER_FLOOR_STEP - 1) / RAYCASTER_FLOOR_STEP;
+    g->blocks_y = (rc->screen_height + RAYCASTER_FLOOR_STEP - 1) / RAYCASTER_FLOOR_STEP;
+    g->tiles_x = (g->blocks_x + RAYCASTER_LIGHT_TILE - 1) / RAYCASTER_LIGHT_TILE;
+    g->tiles_y = (g->blocks_y + RAYCASTER_LIGHT_TILE - 1) / RAYCASTER_LIGHT_TILE;
+    g->floor_x = malloc(g->blocks_x * g->blocks_y * sizeof(float));
+    g->floor_y = malloc(g->blocks_x * g->blocks_y * sizeof(float));
+    g->rows = calloc(g->blocks_y, sizeof(GBufferRow));
+    g->wall_u = malloc(rc->screen_width * sizeof(float));
+    if (!g->floor_x || !g->floor_y || !g->rows || !g->wall_u) {
+        printf("Erreur allocation G-buffer du rendu différé\n");
+        raycaster_free_deferred(rc);
+        return 0;
+    }
+    rc->deferred = 1;
+    return 1;
+}
+
+void raycaster_set_adaptive(RaycastRenderer* rc, int step) {
+    rc->adaptive_step = step > 1 ? step : 0;
+}
+
+void raycaster_reset_history(RaycastRenderer* rc) {
+    rc->history_valid = 0;
+}
+
+void raycaster_destroy(RaycastRenderer* rc) {
+    raycaster_free_checker(rc);
+    raycaster_free_deferred(rc);
+    if (rc->screen_buffer) {
+        free(rc->screen_buffer);
+        rc->screen_buffer = NULL;
+    }
+    free(rc->screen_buffer8);
+    rc->screen_buffer8 = NULL;
+    free(rc->column_buffer);
+    rc->column_buffer = NULL;
+    free(rc->columns);
+    rc->columns = NULL;
+    free(rc->hits);
+    rc->hits = NULL;
+    free(rc->shade);
+    rc->shade = NULL;
+    free(rc->wall_light);
+    rc->wall_light = NULL;
+    free(rc->column_far);
+    rc->column_far = NULL;
+    free(rc->sprite_tex_x);
+    rc->sprite_tex_x = NULL;
+    free(rc->sprite_runs);
+    rc->sprite_runs = NULL;
+    free(rc->sprite_row);
+    rc->sprite_row = NULL;
+    if (rc->screen_texture) {
+        SDL_DestroyTexture(rc->screen_texture);
+        rc->screen_texture = NULL;
+    }
+}
+
+void raycaster_clear_screen(RaycastRenderer* rc, Uint32 color) {
+    for (int i = 0; i < rc->screen_width * rc->screen_height; i++) {
+        rc->screen_buffer[i] = color;
+    }
+}
+
+Uint32 raycaster_get_pixel_from_texture(const Uint32* pixels, const TextureEntry* tex, int tex_x, int tex_y) {
+    // Les dimensions sont des puissances de deux: le masque remplace le modulo
+    tex_x &= tex->width_mask;
+    tex_y &= tex->height_mask;
+    
+    return pixels[tex->offset + ((Uint32)tex_y << tex->width_shift) + tex_x];
+}
+
+Uint32 raycaster_darken_color(Uint32 color, float factor) {
+    Uint8 r = (color >> 24) & 0xFF;
+    Uint8 g = (color >> 16) & 0xFF;
+    Uint8 b = (color >> 8) & 0xFF;
+    Uint8 a = color & 0xFF;
+    
+    r = (Uint8)(r * factor);
+    g = (Uint8)(g * factor);
+    b = (Uint8)(b * factor);
+    
+    return (r << 24) | (g << 16) | (b << 8) | a;
+}
+
+// Poids du brouillard à une distance: nul avant fog_start, total à fog_distance
+static float raycaster_fog_weight(RaycastRenderer* rc, float distance) {
+    if (rc->fog_distance <= 0.0f || distance <= rc->fog_start) return 0.0f;
+    if (distance >= rc->fog_distance) return 1.0f;
+    return (distance - rc->fog_start) / (rc->fog_distance - rc->fog_start);
+}
+
+// Précalculer les tables d'ombrage: assombrissement constant de chaque surface
+// et brouillard, par case de distance
+static void raycaster_build_shading(RaycastRenderer* rc) {
+    static const float surface_factor[SHADE_SURFACES] = { 1.0f, 0.8f, 1.0f };
+    float fog_r = (float)((rc->fog_color >> 24) & 0xFF);
+    float fog_g = (float)((rc->fog_color >> 16) & 0xFF);
+    float fog_b = (float)((rc->fog_color >> 8) & 0xFF);
+    
+    rc->shade_scale = rc->fog_distance > 0.0f ? SHADE_BUCKETS / rc->fog_distance : 0.0f;
+    for (int surface = 0; surface < SHADE_SURFACES; surface++) {
+        for (int bucket = 0; bucket < SHADE_BUCKETS; bucket++) {
+            float t = rc->shade_scale > 0.0f ? raycaster_fog_weight(rc, (bucket + 0.5f) / rc->shade_scale) : 0.0f;
+            float keep = surface_factor[surface] * (1.0f - t);
+            ShadeTable* table = &rc->shade[surface * SHADE_BUCKETS + bucket];
+            for (int v = 0; v < 256; v++) {
+                table->r[v] = (Uint8)(v * keep + fog_r * t);
+                table->g[v] = (Uint8)(v * keep + fog_g * t);
+                table->b[v] = (Uint8)(v * keep + fog_b * t);
+            }
+            rc->shade_factor[surface][bucket] = keep;
+        }
+    }
+}
+
+static int raycaster_shade_bucket(RaycastRenderer* rc, float distance) {
+    int bucket = (int)(distance * rc->shade_scale);
+    return bucket < SHADE_BUCKETS ? bucket : SHADE_BUCKETS - 1;
+}
+
+static const ShadeTable* raycaster_shade_table(RaycastRenderer* rc, int surface, float distance) {
+    return &rc->shade[surface * SHADE_BUCKETS + raycaster_shade_bucket(rc, distance)];
+}
+
+static float raycaster_shade_factor(RaycastRenderer* rc, int surface, float distance) {
+    return rc->shade_factor[surface][raycaster_shade_bucket(rc, distance)];
+}
+
+// Appliquer une table d'ombrage à une couleur RGBA8888 (trois lectures, aucun calcul flottant)
+static inline Uint32 raycaster_shade(const ShadeTable* table, Uint32 color) {
+    return ((Uint32)table->r[(color >> 24) & 0xFF] << 24) |
+           ((Uint32)table->g[(color >> 16) & 0xFF] << 16) |
+           ((Uint32)table->b[(color >> 8) & 0xFF] << 8) |
+           (color & 0xFF);
+}
+
+void raycaster_set_fog(RaycastRenderer* rc, float max_distance, Uint32 color) {
+    rc->fog_distance = max_distance > 0.0f ? max_distance : 0.0f;
+    rc->fog_start = rc->fog_distance * RAYCASTER_FOG_START;
+    rc->fog_color = color;
+    rc->history_valid = 0;
+    raycaster_build_shading(rc);
+}
+
+// État du DDA d'un rayon en cours de traversée
+typedef struct {
+    float side_dist_x, side_dist_y;   // Distance du rayon au prochain côté x ou y
+    float delta_dist_x, delta_dist_y;
+    int map_x, map_y;                 // Tile courante
+    int step_x, step_y;
+    int side;                         // 0 pour côté NS, 1 pour côté EW
+} RayState;
+
+// Test de solidité partagé par le DDA scalaire et les paquets (bordures = murs)
+static inline int raycaster_tile_solid(const Map* map, int x, int y) {
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height) {
+        return 1;
+    }
+    return MAP_TILE(map, LAYER_WALL, x, y).type == TILE_SOLID;
+}
+
+// Direction du rayon de la colonne x et état initial du DDA
+static void raycaster_ray_begin(Player* player, int x, int w, RayState* ray, RayHit* hit) {
+    // Calculer la direction du rayon
+    float camera_x = 2 * x / (float)w - 1; // Coordonnée x dans l'espace caméra (-1 à 1)
+    float ray_dir_x = player->dir_x + player->plane_x * camera_x;
+    float ray_dir_y = player->dir_y + player->plane_y * camera_x;
+    
+    // Position actuelle dans la grille
+    int map_x = (int)player->x;
+    int map_y = (int)player->y;
+    
+    // Distance du rayon au prochain côté x ou y (en float: mêmes opérations que
+    // l'initialisation des paquets SSE)
+    float delta_dist_x = (ray_dir_x == 0) ? 1e30f : fabsf(1 / ray_dir_x);
+    float delta_dist_y = (ray_dir_y == 0) ? 1e30f : fabsf(1 / ray_dir_y);
+    
+    // Calcul du pas et de la distance initiale
+    if (ray_dir_x < 0) {
+        ray->step_x = -1;
+        ray->side_dist_x = (player->x - map_x) * delta_dist_x;
+    } else {
+        ray->step_x = 1;
+        ray->side_dist_x = (map_x + 1.0f - player->x) * delta_dist_x;
+    }
+    
+    if (ray_dir_y < 0) {
+        ray->step_y = -1;
+        ray->side_dist_y = (player->y - map_y) * delta_dist_y;
+    } else {
+        ray->step_y = 1;
+        ray->side_dist_y = (map_y + 1.0f - player->y) * delta_dist_y;
+    }
+    
+    ray->delta_dist_x = delta_dist_x;
+    ray->delta_dist_y = delta_dist_y;
+    ray->map_x = map_x;
+    ray->map_y = map_y;
+    ray->side = 0;
+    hit->ray_dir_x = ray_dir_x;
+    hit->ray_dir_y = ray_dir_y;
+}
+
+// DDA (Digital Differential Analyzer), arrêté à la distance de vue maximale
+static int raycaster_ray_traverse(const Map* map, float max_distance, RayState* ray) {
+    for (;;) {
+        if ((ray->side_dist_x < ray->side_dist_y ? ray->side_dist_x : ray->side_dist_y) > max_distance) {
+            return 0;
+        }
+        if (ray->side_dist_x < ray->side_dist_y) {
+            ray->side_dist_x += ray->delta_dist_x;
+            ray->map_x += ray->step_x;
+            ray->side = 0;
+        } else {
+            ray->side_dist_y += ray->delta_dist_y;
+            ray->map_y += ray->step_y;
+            ray->side = 1;
+        }
+        
+        if (raycaster_tile_solid(map, ray->map_x, ray->map_y)) {
+            return 1;
+        }
+    }
+}
+
+// Distance perpendiculaire et tile touchée
+static void raycaster_ray_end(Player* player, const RayState* ray, int found, RayHit* hit) {
+    float perp_wall_dist;
+    if (ray->side == 0) {
+        perp_wall_dist = (ray->map_x - player->x + (1 - ray->step_x) / 2) / hit->ray_dir_x;
+    } else {
+        perp_wall_dist = (ray->map_y - player->y + (1 - ray->step_y) / 2) / hit->ray_dir_y;
+    }
+    
+    hit->hit = found;
+    hit->map_x = ray->map_x;
+    hit->map_y = ray->map_y;
+    hit->step_x = ray->step_x;
+    hit->step_y = ray->step_y;
+    hit->side = ray->side;
+    hit->perp_wall_dist = perp_wall_dist;
+}
+
+// Lancer le rayon de la colonne x (DDA) jusqu'au premier mur
+void raycaster_cast_column(Player* player, Map* map, int x, int w, float max_distance, RayHit* hit) {
+    RayState ray;
+    raycaster_ray_begin(player, x, w, &ray, hit);
+    if (max_distance <= 0.0f) max_distance = 1e30f;
+    int found = raycaster_ray_traverse(map, max_distance, &ray);
+    raycaster_ray_end(player, &ray, found, hit);
+}
+
+#ifdef KERNELS_X86
+// Fin d'un paquet de rayons en colonnes (une entrée par voie), rangée par les
+// variantes SIMD: résultat des voies arrêtées et état courant des voies encore
+// actives, qui finissent le DDA en scalaire
+typedef struct {
+    float side_dist_x[RAYCASTER_PACKET_MAX], side_dist_y[RAYCASTER_PACKET_MAX];
+    float delta_dist_x[RAYCASTER_PACKET_MAX], delta_dist_y[RAYCASTER_PACKET_MAX];
+    int map_x[RAYCASTER_PACKET_MAX], map_y[RAYCASTER_PACKET_MAX];
+    int step_x[RAYCASTER_PACKET_MAX], step_y[RAYCASTER_PACKET_MAX];
+    int side[RAYCASTER_PACKET_MAX];
+    int hit_x[RAYCASTER_PACKET_MAX], hit_y[RAYCASTER_PACKET_MAX];    // Tile et côté à l'arrêt
+    int hit_side[RAYCASTER_PACKET_MAX];
+    float ray_dir_x[RAYCASTER_PACKET_MAX], ray_dir_y[RAYCASTER_PACKET_MAX];
+    float perp_wall_dist[RAYCASTER_PACKET_MAX];
+} RayPacket;
+
+static void raycaster_packet_hits(Player* player, Map* map, float max_distance, int lanes,
+                                  const RayPacket* packet, int active, int found, RayHit* hits) {
+    for (int lane = 0; lane < lanes; lane++) {
+        RayHit* hit = &hits[lane];
+        hit->ray_dir_x = packet->ray_dir_x[lane];
+        hit->ray_dir_y = packet->ray_dir_y[lane];
+        if ((active >> lane) & 1) {
+            RayState ray;
+            ray.side_dist_x = packet->side_dist_x[lane];
+            ray.side_dist_y = packet->side_dist_y[lane];
+            ray.delta_dist_x = packet->delta_dist_x[lane];
+            ray.delta_dist_y = packet->delta_dist_y[lane];
+            ray.map_x = packet->map_x[lane];
+            ray.map_y = packet->map_y[lane];
+            ray.step_x = packet->step_x[lane];
+            ray.step_y = packet->step_y[lane];
+            ray.side = packet->side[lane];
+            raycaster_ray_end(player, &ray, raycaster_ray_traverse(map, max_distance, &ray), hit);
+            continue;
+        }
+        hit->hit = (found >> lane) & 1;
+        hit->map_x = packet->hit_x[lane];
+        hit->map_y = packet->hit_y[lane];
+        hit->step_x = packet->step_x[lane];
+        hit->step_y = packet->step_y[lane];
+        hit->side = packet->hit_side[lane];
+        hit->perp_wall_dist = packet->perp_wall_dist[lane];
+    }
+}
+
+// Masques SSE des voies (bit i -> voie i)
+static const Sint32 raycaster_lane_masks[16][4] __attribute__((aligned(16))) = {
+    { 0,  0,  0,  0}, {-1,  0,  0,  0}, { 0, -1,  0,  0}, {-1, -1,  0,  0},
+    { 0,  0, -1,  0}, {-1,  0, -1,  0}, { 0, -1, -1,  0}, {-1, -1, -1,  0},
+    { 0,  0,  0, -1}, {-1,  0,  0, -1}, { 0, -1,  0, -1}, {-1, -1,  0, -1},
+    { 0,  0, -1, -1}, {-1,  0, -1, -1}, { 0, -1, -1, -1}, {-1, -1, -1, -1}
+};
+
+// Paquet de RAYCASTER_PACKET colonnes voisines: les rayons avancent ensemble
+// dans les voies SSE, mêmes opérations flottantes que le DDA scalaire (résultats
+// identiques). Tout reste en registres: initialisation des rayons et distance
+// finale sont calculées dans les voies, et chaque voie tient l'index de sa tile
+// dans le layer des murs, avancé avec elle (pas de multiplication par pas).
+// La solidité est lue par 4 chargements sans branche, une voie hors map lisant
+// la tile 0 et comptant comme mur.
+// Une voie arrêtée (mur ou distance de vue) continue d'avancer sans effet: son
+// résultat est gardé à part, le pas suivant ne dépend donc pas des lectures de
+// tiles du pas en cours. Quand il ne reste qu'une voie, elle finit en scalaire.
+KERNEL_TARGET("sse2")
+static void raycaster_cast_packet_sse2(Player* player, Map* map, int x, int w, float max_distance, RayHit* hits) {
+    __m128i one = _mm_set1_epi32(1);
+    __m128 one_ps = _mm_set1_ps(1.0f);
+    __m128 zero_ps = _mm_setzero_ps();
+    __m128 pos_x = _mm_set1_ps(player->x);
+    __m128 pos_y = _mm_set1_ps(player->y);
+    int start_x = (int)player->x;
+    int start_y = (int)player->y;
+    __m128 start_fx = _mm_set1_ps((float)start_x);
+    __m128 start_fy = _mm_set1_ps((float)start_y);
+    
+    // Directions des rayons (comme raycaster_ray_begin)
+    __m128i column = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+    __m128 camera_x = _mm_sub_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_add_epi32(column, column)), _mm_set1_ps((float)w)),
+                                 one_ps);
+    __m128 ray_dir_x = _mm_add_ps(_mm_set1_ps(player->dir_x), _mm_mul_ps(_mm_set1_ps(player->plane_x), camera_x));
+    __m128 ray_dir_y = _mm_add_ps(_mm_set1_ps(player->dir_y), _mm_mul_ps(_mm_set1_ps(player->plane_y), camera_x));
+    
+    __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 huge = _mm_set1_ps(1e30f);
+    __m128 dir_zero_x = _mm_cmpeq_ps(ray_dir_x, zero_ps);
+    __m128 dir_zero_y = _mm_cmpeq_ps(ray_dir_y, zero_ps);
+    __m128 delta_dist_x = _mm_or_ps(_mm_and_ps(dir_zero_x, huge),
+                                    _mm_andnot_ps(dir_zero_x, _mm_and_ps(abs_mask, _mm_div_ps(one_ps, ray_dir_x))));
+    __m128 delta_dist_y = _mm_or_ps(_mm_and_ps(dir_zero_y, huge),
+                                    _mm_andnot_ps(dir_zero_y, _mm_and_ps(abs_mask, _mm_div_ps(one_ps, ray_dir_y))));
+    
+    // Pas (-1 si la direction est négative, 1 sinon) et distances initiales
+    __m128 negative_x = _mm_cmplt_ps(ray_dir_x, zero_ps);
+    __m128 negative_y = _mm_cmplt_ps(ray_dir_y, zero_ps);
+    __m128i step_x = _mm_or_si128(_mm_castps_si128(negative_x), one);
+    __m128i step_y = _mm_or_si128(_mm_castps_si128(negative_y), one);
+    __m128 side_dist_x = _mm_mul_ps(_mm_or_ps(_mm_and_ps(negative_x, _mm_sub_ps(pos_x, start_fx)),
+                                              _mm_andnot_ps(negative_x, _mm_sub_ps(_mm_add_ps(start_fx, one_ps), pos_x))),
+                                    delta_dist_x);
+    __m128 side_dist_y = _mm_mul_ps(_mm_or_ps(_mm_and_ps(negative_y, _mm_sub_ps(pos_y, start_fy)),
+                                              _mm_andnot_ps(negative_y, _mm_sub_ps(_mm_add_ps(start_fy, one_ps), pos_y))),
+                                    delta_dist_y);
+    __m128i map_x = _mm_set1_epi32(start_x);
+    __m128i map_y = _mm_set1_epi32(start_y);
+    __m128i side = _mm_setzero_si128();
+    __m128 max_dist = _mm_set1_ps(max_distance);
+    
+    // Index en int (Tile = type puis texture), pas d'une ligne = 2 * largeur.
+    // Toutes les voies partent de la tile du joueur
+    const int* tiles = (const int*)map->layers[LAYER_WALL];
+    int row = map->width * 2;
+    __m128i index = _mm_set1_epi32(start_y * row + start_x * 2);
+    __m128i index_x = _mm_add_epi32(step_x, step_x);
+    __m128i index_y = _mm_or_si128(_mm_and_si128(_mm_castps_si128(negative_y), _mm_set1_epi32(-row)),
+                                   _mm_andnot_si128(_mm_castps_si128(negative_y), _mm_set1_epi32(row)));
+    // Bornes non signées (coordonnée négative = hors map) par décalage du signe
+    __m128i sign = _mm_set1_epi32((int)0x80000000);
+    __m128i width = _mm_xor_si128(_mm_set1_epi32(map->width), sign);
+    __m128i height = _mm_xor_si128(_mm_set1_epi32(map->height), sign);
+    
+    __m128i hit_x = map_x, hit_y = map_y, hit_side = side;
+    int active = (1 << RAYCASTER_PACKET) - 1;
+    int found = 0;
+    while (active & (active - 1)) {
+        int far = _mm_movemask_ps(_mm_cmpgt_ps(_mm_min_ps(side_dist_x, side_dist_y), max_dist)) & active;
+        if (far) {
+            // Au-delà de la distance de vue: état avant le pas, sans mur
+            __m128i keep = _mm_load_si128((const __m128i*)raycaster_lane_masks[far]);
+            hit_x = _mm_or_si128(_mm_andnot_si128(keep, hit_x), _mm_and_si128(keep, map_x));
+            hit_y = _mm_or_si128(_mm_andnot_si128(keep, hit_y), _mm_and_si128(keep, map_y));
+            hit_side = _mm_or_si128(_mm_andnot_si128(keep, hit_side), _mm_and_si128(keep, side));
+            active &= ~far;
+            if (!(active & (active - 1))) break;
+        }
+        
+        __m128i move_x = _mm_castps_si128(_mm_cmplt_ps(side_dist_x, side_dist_y));
+        side_dist_x = _mm_add_ps(side_dist_x, _mm_and_ps(delta_dist_x, _mm_castsi128_ps(move_x)));
+        side_dist_y = _mm_add_ps(side_dist_y, _mm_andnot_ps(_mm_castsi128_ps(move_x), delta_dist_y));
+        map_x = _mm_add_epi32(map_x, _mm_and_si128(step_x, move_x));
+        map_y = _mm_add_epi32(map_y, _mm_andnot_si128(move_x, step_y));
+        index = _mm_add_epi32(index, _mm_or_si128(_mm_and_si128(index_x, move_x), _mm_andnot_si128(move_x, index_y)));
+        side = _mm_andnot_si128(move_x, one);
+        
+        __m128i inside = _mm_and_si128(_mm_cmpgt_epi32(width, _mm_xor_si128(map_x, sign)),
+                                       _mm_cmpgt_epi32(height, _mm_xor_si128(map_y, sign)));
+        int lane_index[RAYCASTER_PACKET];
+        _mm_storeu_si128((__m128i*)lane_index, _mm_and_si128(index, inside));
+        int solid = (tiles[lane_index[0]] == TILE_SOLID) | (tiles[lane_index[1]] == TILE_SOLID) << 1 |
+                    (tiles[lane_index[2]] == TILE_SOLID) << 2 | (tiles[lane_index[3]] == TILE_SOLID) << 3;
+        solid = (solid | (~_mm_movemask_ps(_mm_castsi128_ps(inside)) & 15)) & active;
+        if (solid) {
+            __m128i keep = _mm_load_si128((const __m128i*)raycaster_lane_masks[solid]);
+            hit_x = _mm_or_si128(_mm_andnot_si128(keep, hit_x), _mm_and_si128(keep, map_x));
+            hit_y = _mm_or_si128(_mm_andnot_si128(keep, hit_y), _mm_and_si128(keep, map_y));
+            hit_side = _mm_or_si128(_mm_andnot_si128(keep, hit_side), _mm_and_si128(keep, side));
+            found |= solid;
+            active &= ~solid;
+        }
+    }
+    
+    // Distance perpendiculaire (comme raycaster_ray_end): (1 - pas) / 2 vaut 1
+    // pour un pas négatif
+    __m128 perp_x = _mm_div_ps(_mm_add_ps(_mm_sub_ps(_mm_cvtepi32_ps(hit_x), pos_x), _mm_and_ps(negative_x, one_ps)),
+                               ray_dir_x);
+    __m128 perp_y = _mm_div_ps(_mm_add_ps(_mm_sub_ps(_mm_cvtepi32_ps(hit_y), pos_y), _mm_and_ps(negative_y, one_ps)),
+                               ray_dir_y);
+    __m128 side_y = _mm_castsi128_ps(_mm_cmpeq_epi32(hit_side, one));
+    
+    RayPacket packet;
+    _mm_storeu_si128((__m128i*)packet.step_x, step_x);
+    _mm_storeu_si128((__m128i*)packet.step_y, step_y);
+    _mm_storeu_si128((__m128i*)packet.hit_x, hit_x);
+    _mm_storeu_si128((__m128i*)packet.hit_y, hit_y);
+    _mm_storeu_si128((__m128i*)packet.hit_side, hit_side);
+    _mm_storeu_ps(packet.ray_dir_x, ray_dir_x);
+    _mm_storeu_ps(packet.ray_dir_y, ray_dir_y);
+    _mm_storeu_ps(packet.perp_wall_dist, _mm_or_ps(_mm_and_ps(side_y, perp_y), _mm_andnot_ps(side_y, perp_x)));
+    if (active) {
+        _mm_storeu_ps(packet.side_dist_x, side_dist_x);
+        _mm_storeu_ps(packet.side_dist_y, side_dist_y);
+        _mm_storeu_ps(packet.delta_dist_x, delta_dist_x);
+        _mm_storeu_ps(packet.delta_dist_y, delta_dist_y);
+        _mm_storeu_si128((__m128i*)packet.map_x, map_x);
+        _mm_storeu_si128((__m128i*)packet.map_y, map_y);
+        _mm_storeu_si128((__m128i*)packet.side, side);
+    }
+    raycaster_packet_hits(player, map, max_distance, RAYCASTER_PACKET, &packet, active, found, hits);
+}
+
+// Masque AVX2 des voies (bit i -> voie i)
+KERNEL_TARGET("avx2")
+static inline __m256i raycaster_lane_mask_avx2(int lanes) {
+    __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(lanes), bits), bits);
+}
+
+// Même paquet sur 8 voies AVX2. Les tiles sont lues une à une: un gather est
+// plus lent que 8 chargements sur bien des CPU
+KERNEL_TARGET("avx2")
+static void raycaster_cast_packet_avx2(Player* player, Map* map, int x, int w, float max_distance, RayHit* hits) {
+    __m256i one = _mm256_set1_epi32(1);
+    __m256 one_ps = _mm256_set1_ps(1.0f);
+    __m256 zero_ps = _mm256_setzero_ps();
+    __m256 pos_x = _mm256_set1_ps(player->x);
+    __m256 pos_y = _mm256_set1_ps(player->y);
+    int start_x = (int)player->x;
+    int start_y = (int)player->y;
+    __m256 start_fx = _mm256_set1_ps((float)start_x);
+    __m256 start_fy = _mm256_set1_ps((float)start_y);
+    
+    __m256i column = _mm256_add_epi32(_mm256_set1_epi32(x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 camera_x = _mm256_sub_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(column, column)),
+                                                  _mm256_set1_ps((float)w)), one_ps);
+    __m256 ray_dir_x = _mm256_add_ps(_mm256_set1_ps(player->dir_x), _mm256_mul_ps(_mm256_set1_ps(player->plane_x), camera_x));
+    __m256 ray_dir_y = _mm256_add_ps(_mm256_set1_ps(player->dir_y), _mm256_mul_ps(_mm256_set1_ps(player->plane_y), camera_x));
+    
+    __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 huge = _mm256_set1_ps(1e30f);
+    __m256 dir_zero_x = _mm256_cmp_ps(ray_dir_x, zero_ps, _CMP_EQ_OQ);
+    __m256 dir_zero_y = _mm256_cmp_ps(ray_dir_y, zero_ps, _CMP_EQ_OQ);
+    __m256 delta_dist_x = _mm256_blendv_ps(_mm256_and_ps(abs_mask, _mm256_div_ps(one_ps, ray_dir_x)), huge, dir_zero_x);
+    __m256 delta_dist_y = _mm256_blendv_ps(_mm256_and_ps(abs_mask, _mm256_div_ps(one_ps, ray_dir_y)), huge, dir_zero_y);
+    
+    __m256 negative_x = _mm256_cmp_ps(ray_dir_x, zero_ps, _CMP_LT_OQ);
+    __m256 negative_y = _mm256_cmp_ps(ray_dir_y, zero_ps, _CMP_LT_OQ);
+    __m256i step_x = _mm256_or_si256(_mm256_castps_si256(negative_x), one);
+    __m256i step_y = _mm256_or_si256(_mm256_castps_si256(negative_y), one);
+    __m256 side_dist_x = _mm256_mul_ps(_mm256_blendv_ps(_mm256_sub_ps(_mm256_add_ps(start_fx, one_ps), pos_x),
+                                                        _mm256_sub_ps(pos_x, start_fx), negative_x), delta_dist_x);
+    __m256 side_dist_y = _mm256_mul_ps(_mm256_blendv_ps(_mm256_sub_ps(_mm256_add_ps(start_fy, one_ps), pos_y),
+                                                        _mm256_sub_ps(pos_y, start_fy), negative_y), delta_dist_y);
+    __m256i map_x = _mm256_set1_epi32(start_x);
+    __m256i map_y = _mm256_set1_epi32(start_y);
+    __m256i side = _mm256_setzero_si256();
+    __m256 max_dist = _mm256_set1_ps(max_distance);
+    
+    const int* tiles = (const int*)map->layers[LAYER_WALL];
+    int row = map->width * 2;
+    __m256i index = _mm256_set1_epi32(start_y * row + start_x * 2);
+    __m256i index_x = _mm256_add_epi32(step_x, step_x);
+    __m256i index_y = _mm256_mullo_epi32(step_y, _mm256_set1_epi32(row));
+    __m256i sign = _mm256_set1_epi32((int)0x80000000);
+    __m256i width = _mm256_xor_si256(_mm256_set1_epi32(map->width), sign);
+    __m256i height = _mm256_xor_si256(_mm256_set1_epi32(map->height), sign);
+    
+    __m256i hit_x = map_x, hit_y = map_y, hit_side = side;
+    int active = 0xFF;
+    int found = 0;
+    while (active & (active - 1)) {
+        int far = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_min_ps(side_dist_x, side_dist_y), max_dist, _CMP_GT_OQ))
+                  & active;
+        if (far) {
+            __m256i keep = raycaster_lane_mask_avx2(far);
+            hit_x = _mm256_blendv_epi8(hit_x, map_x, keep);
+            hit_y = _mm256_blendv_epi8(hit_y, map_y, keep);
+            hit_side = _mm256_blendv_epi8(hit_side, side, keep);
+            active &= ~far;
+            if (!(active & (active - 1))) break;
+        }
+        
+        __m256i move_x = _mm256_castps_si256(_mm256_cmp_ps(side_dist_x, side_dist_y, _CMP_LT_OQ));
+        side_dist_x = _mm256_add_ps(side_dist_x, _mm256_and_ps(delta_dist_x, _mm256_castsi256_ps(move_x)));
+        side_dist_y = _mm256_add_ps(side_dist_y, _mm256_andnot_ps(_mm256_castsi256_ps(move_x), delta_dist_y));
+        map_x = _mm256_add_epi32(map_x, _mm256_and_si256(step_x, move_x));
+        map_y = _mm256_add_epi32(map_y, _mm256_andnot_si256(move_x, step_y));
+        index = _mm256_add_epi32(index, _mm256_blendv_epi8(index_y, index_x, move_x));
+        side = _mm256_andnot_si256(move_x, one);
+        
+        __m256i inside = _mm256_and_si256(_mm256_cmpgt_epi32(width, _mm256_xor_si256(map_x, sign)),
+                                          _mm256_cmpgt_epi32(height, _mm256_xor_si256(map_y, sign)));
+        int lane_index[8];
+        _mm256_storeu_si256((__m256i*)lane_index, _mm256_and_si256(index, inside));
+        int solid = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            solid |= (tiles[lane_index[lane]] == TILE_SOLID) << lane;
+        }
+        solid = (solid | (~_mm256_movemask_ps(_mm256_castsi256_ps(inside)) & 0xFF)) & active;
+        if (solid) {
+            __m256i keep = raycaster_lane_mask_avx2(solid);
+            hit_x = _mm256_blendv_epi8(hit_x, map_x, keep);
+            hit_y = _mm256_blendv_epi8(hit_y, map_y, keep);
+            hit_side = _mm256_blendv_epi8(hit_side, side, keep);
+            found |= solid;
+            active &= ~solid;
+        }
+    }
+    
+    __m256 perp_x = _mm256_div_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(hit_x), pos_x),
+                                                _mm256_and_ps(negative_x, one_ps)), ray_dir_x);
+    __m256 perp_y = _mm256_div_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(hit_y), pos_y),
+                                                _mm256_and_ps(negative_y, one_ps)), ray_dir_y);
+    __m256 side_y = _mm256_castsi256_ps(_mm256_cmpeq_epi32(hit_side, one));
+    
+    RayPacket packet;
+    _mm256_storeu_si256((__m256i*)packet.step_x, step_x);
+    _mm256_storeu_si256((__m256i*)packet.step_y, step_y);
+    _mm256_storeu_si256((__m256i*)packet.hit_x, hit_x);
+    _mm256_storeu_si256((__m256i*)packet.hit_y, hit_y);
+    _mm256_storeu_si256((__m256i*)packet.hit_side, hit_side);
+    _mm256_storeu_ps(packet.ray_dir_x, ray_dir_x);
+    _mm256_storeu_ps(packet.ray_dir_y, ray_dir_y);
+    _mm256_storeu_ps(packet.perp_wall_dist, _mm256_blendv_ps(perp_x, perp_y, side_y));
+    if (active) {
+        _mm256_storeu_ps(packet.side_dist_x, side_dist_x);
+        _mm256_storeu_ps(packet.side_dist_y, side_dist_y);
+        _mm256_storeu_ps(packet.delta_dist_x, delta_dist_x);
+        _mm256_storeu_ps(packet.delta_dist_y, delta_dist_y);
+        _mm256_storeu_si256((__m256i*)packet.map_x, map_x);
+        _mm256_storeu_si256((__m256i*)packet.map_y, map_y);
+        _mm256_storeu_si256((__m256i*)packet.side, side);
+    }
+    raycaster_packet_hits(player, map, max_distance, 8, &packet, active, found, hits);
+}
+
+// 16 voies AVX-512: les masques de voies sont des registres k, comparaison
+// non signée des bornes
+KERNEL_TARGET("avx512f")
+static void raycaster_cast_packet_avx512(Player* player, Map* map, int x, int w, float max_distance, RayHit* hits) {
+    __m512i one = _mm512_set1_epi32(1);
+    __m512 one_ps = _mm512_set1_ps(1.0f);
+    __m512 zero_ps = _mm512_setzero_ps();
+    __m512 pos_x = _mm512_set1_ps(player->x);
+    __m512 pos_y = _mm512_set1_ps(player->y);
+    int start_x = (int)player->x;
+    int start_y = (int)player->y;
+    __m512 start_fx = _mm512_set1_ps((float)start_x);
+    __m512 start_fy = _mm512_set1_ps((float)start_y);
+    
+    __m512i column = _mm512_add_epi32(_mm512_set1_epi32(x),
+                                      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    __m512 camera_x = _mm512_sub_ps(_mm512_div_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(column, column)),
+                                                  _mm512_set1_ps((float)w)), one_ps);
+    // Produit arrondi à part (pas de FMA): mêmes directions que le scalaire
+    __m512 ray_dir_x = _mm512_add_ps(_mm512_set1_ps(player->dir_x),
+                                     _mm512_mul_round_ps(_mm512_set1_ps(player->plane_x), camera_x,
+                                                         _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    __m512 ray_dir_y = _mm512_add_ps(_mm512_set1_ps(player->dir_y),
+                                     _mm512_mul_round_ps(_mm512_set1_ps(player->plane_y), camera_x,
+                                                         _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    
+    __m512 huge = _mm512_set1_ps(1e30f);
+    __mmask16 dir_zero_x = _mm512_cmp_ps_mask(ray_dir_x, zero_ps, _CMP_EQ_OQ);
+    __mmask16 dir_zero_y = _mm512_cmp_ps_mask(ray_dir_y, zero_ps, _CMP_EQ_OQ);
+    __m512 delta_dist_x = _mm512_mask_mov_ps(_mm512_abs_ps(_mm512_div_ps(one_ps, ray_dir_x)), dir_zero_x, huge);
+    __m512 delta_dist_y = _mm512_mask_mov_ps(_mm512_abs_ps(_mm512_div_ps(one_ps, ray_dir_y)), dir_zero_y, huge);
+    
+    __mmask16 negative_x = _mm512_cmp_ps_mask(ray_dir_x, zero_ps, _CMP_LT_OQ);
+    __mmask16 negative_y = _mm512_cmp_ps_mask(ray_dir_y, zero_ps, _CMP_LT_OQ);
+    __m512i step_x = _mm512_mask_mov_epi32(one, negative_x, _mm512_set1_epi32(-1));
+    __m512i step_y = _mm512_mask_mov_epi32(one, negative_y, _mm512_set1_epi32(-1));
+    __m512 side_dist_x = _mm512_mul_ps(_mm512_mask_mov_ps(_mm512_sub_ps(_mm512_add_ps(start_fx, one_ps), pos_x),
+                                                          negative_x, _mm512_sub_ps(pos_x, start_fx)), delta_dist_x);
+    __m512 side_dist_y = _mm512_mul_ps(_mm512_mask_mov_ps(_mm512_sub_ps(_mm512_add_ps(start_fy, one_ps), pos_y),
+                                                          negative_y, _mm512_sub_ps(pos_y, start_fy)), delta_dist_y);
+    __m512i map_x = _mm512_set1_epi32(start_x);
+    __m512i map_y = _mm512_set1_epi32(start_y);
+    __m512i side = _mm512_setzero_si512();
+    __m512 max_dist = _mm512_set1_ps(max_distance);
+    
+    const int* tiles = (const int*)map->layers[LAYER_WALL];
+    int row = map->width * 2;
+    __m512i index = _mm512_set1_epi32(start_y * row + start_x * 2);
+    __m512i index_x = _mm512_add_epi32(step_x, step_x);
+    __m512i index_y = _mm512_mullo_epi32(step_y, _mm512_set1_epi32(row));
+    __m512i width = _mm512_set1_epi32(map->width);
+    __m512i height = _mm512_set1_epi32(map->height);
+    
+    __m512i hit_x = map_x, hit_y = map_y, hit_side = side;
+    int active = 0xFFFF;
+    int found = 0;
+    while (active & (active - 1)) {
+        __mmask16 far = _mm512_cmp_ps_mask(_mm512_min_ps(side_dist_x, side_dist_y), max_dist, _CMP_GT_OQ) & active;
+        if (far) {
+            hit_x = _mm512_mask_mov_epi32(hit_x, far, map_x);
+            hit_y = _mm512_mask_mov_epi32(hit_y, far, map_y);
+            hit_side = _mm512_mask_mov_epi32(hit_side, far, side);
+            active &= ~far;
+            if (!(active & (active - 1))) break;
+        }
+        
+        __mmask16 move_x = _mm512_cmp_ps_mask(side_dist_x, side_dist_y, _CMP_LT_OQ);
+        __mmask16 move_y = ~move_x;
+        side_dist_x = _mm512_mask_add_ps(side_dist_x, move_x, side_dist_x, delta_dist_x);
+        side_dist_y = _mm512_mask_add_ps(side_dist_y, move_y, side_dist_y, delta_dist_y);
+        map_x = _mm512_mask_add_epi32(map_x, move_x, map_x, step_x);
+        map_y = _mm512_mask_add_epi32(map_y, move_y, map_y, step_y);
+        index = _mm512_add_epi32(index, _mm512_mask_mov_epi32(index_y, move_x, index_x));
+        side = _mm512_maskz_mov_epi32(move_y, one);
+        
+        __mmask16 inside = _mm512_cmplt_epu32_mask(map_x, width) & _mm512_cmplt_epu32_mask(map_y, height);
+        int lane_index[16];
+        _mm512_storeu_si512(lane_index, _mm512_maskz_mov_epi32(inside, index));
+        int solid = 0;
+        for (int lane = 0; lane < 16; lane++) {
+            solid |= (tiles[lane_index[lane]] == TILE_SOLID) << lane;
+        }
+        solid = (solid | (~inside & 0xFFFF)) & active;
+        if (solid) {
+            hit_x = _mm512_mask_mov_epi32(hit_x, solid, map_x);
+            hit_y = _mm512_mask_mov_epi32(hit_y, solid, map_y);
+            hit_side = _mm512_mask_mov_epi32(hit_side, solid, side);
+            found |= solid;
+            active &= ~solid;
+        }
+    }
+    
+    __m512 perp_x = _mm512_div_ps(_mm512_add_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(hit_x), pos_x),
+                                                _mm512_maskz_mov_ps(negative_x, one_ps)), ray_dir_x);
+    __m512 perp_y = _mm512_div_ps(_mm512_add_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(hit_y), pos_y),
+                                                _mm512_maskz_mov_ps(negative_y, one_ps)), ray_dir_y);
+    
+    RayPacket packet;
+    _mm512_storeu_si512(packet.step_x, step_x);
+    _mm512_storeu_si512(packet.step_y, step_y);
+    _mm512_storeu_si512(packet.hit_x, hit_x);
+    _mm512_storeu_si512(packet.hit_y, hit_y);
+    _mm512_storeu_si512(packet.hit_side, hit_side);
+    _mm512_storeu_ps(packet.ray_dir_x, ray_dir_x);
+    _mm512_storeu_ps(packet.ray_dir_y, ray_dir_y);
+    _mm512_storeu_ps(packet.perp_wall_dist,
+                     _mm512_mask_mov_ps(perp_x, _mm512_cmpeq_epi32_mask(hit_side, one), perp_y));
+    if (active) {
+        _mm512_storeu_ps(packet.side_dist_x, side_dist_x);
+        _mm512_storeu_ps(packet.side_dist_y, side_dist_y);
+        _mm512_storeu_ps(packet.delta_dist_x, delta_dist_x);
+        _mm512_storeu_ps(packet.delta_dist_y, delta_dist_y);
+        _mm512_storeu_si512(packet.map_x, map_x);
+        _mm512_storeu_si512(packet.map_y, map_y);
+        _mm512_storeu_si512(packet.side, side);
+    }
+    raycaster_packet_hits(player, map, max_distance, 16, &packet, active, found, hits);
+}
+
+// Variantes du registre (kernels.c): paquets les plus larges d'abord, puis
+// les plus étroits sur le reste
+KERNEL_TARGET("sse2")
+int raycaster_cast_packets_sse2(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits) {
+    if (max_distance <= 0.0f) max_distance = 1e30f;
+    int i = 0;
+    for (; i + RAYCASTER_PACKET <= count; i += RAYCASTER_PACKET) {
+        raycaster_cast_packet_sse2(player, map, x + i, w, max_distance, hits + i);
+    }
+    return i;
+}
+
+KERNEL_TARGET("avx2")
+int raycaster_cast_packets_avx2(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits) {
+    float distance = max_distance <= 0.0f ? 1e30f : max_distance;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        raycaster_cast_packet_avx2(player, map, x + i, w, distance, hits + i);
+    }
+    return i + raycaster_cast_packets_sse2(player, map, x + i, count - i, w, max_distance, hits + i);
+}
+
+KERNEL_TARGET("avx512f")
+int raycaster_cast_packets_avx512(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits) {
+    float distance = max_distance <= 0.0f ? 1e30f : max_distance;
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        raycaster_cast_packet_avx512(player, map, x + i, w, distance, hits + i);
+    }
+    return i + raycaster_cast_packets_avx2(player, map, x + i, count - i, w, max_distance, hits + i);
+}
+#endif
+
+// Rayons des colonnes x .. x + count - 1, par paquets avec les noyaux en service
+void raycaster_cast_columns(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits) {
+    int i = kernels->cast_packets ? kernels->cast_packets(player, map, x, count, w, max_distance, hits) : 0;
+    for (; i < count; i++) {
+        raycaster_cast_column(player, map, x + i, w, max_distance, hits + i);
+    }
+}
+
+// Colonne x sur la face touchée par ses deux voisines: seule la fin du DDA
+// (distance perpendiculaire depuis la tile et le côté) est calculée
+static void raycaster_ray_on_face(Player* player, int x, int w, const RayHit* face, RayHit* hit) {
+    RayState ray;
+    raycaster_ray_begin(player, x, w, &ray, hit);
+    ray.map_x = face->map_x;
+    ray.map_y = face->map_y;
+    ray.side = face->side;
+    raycaster_ray_end(player, &ray, 1, hit);
+}
+
+static inline int raycaster_same_face(const RayHit* a, const RayHit* b) {
+    return a->hit && b->hit && a->map_x == b->map_x && a->map_y == b->map_y &&
+           a->side == b->side && a->step_x == b->step_x && a->step_y == b->step_y;
+}
+
+// Colonnes strictement entre x0 et x1, dont les rayons sont déjà tracés. Si les
+// deux touchent la même face, tous les rayons intermédiaires la touchent aussi
+// (une tile ne tient pas entre eux sans couper l'un des deux): ils sont calculés
+// directement sur la face. Sinon le rayon du milieu est tracé et chaque moitié
+// est traitée de la même façon, ce qui garde les bords des murs exacts
+static int raycaster_adaptive_span(RaycastRenderer* rc, Player* player, Map* map, int x0, int x1) {
+    if (x1 - x0 < 2) return 0;
+    int w = rc->screen_width;
+    RayHit* hits = rc->hits;
+    if (raycaster_same_face(&hits[x0], &hits[x1])) {
+        for (int x = x0 + 1; x < x1; x++) {
+            raycaster_ray_on_face(player, x, w, &hits[x0], &hits[x]);
+        }
+        return 0;
+    }
+    int mid = (x0 + x1) / 2;
+    raycaster_cast_column(player, map, mid, w, rc->fog_distance, &hits[mid]);
+    return 1 + raycaster_adaptive_span(rc, player, map, x0, mid) +
+               raycaster_adaptive_span(rc, player, map, mid, x1);
+}
+
+// Rayons de toutes les colonnes de l'écran dans rc->hits
+static void raycaster_cast_screen(RaycastRenderer* rc, Player* player, Map* map) {
+    int w = rc->screen_width;
+    int step = rc->adaptive_step;
+    if (step < 2 || w < 2) {
+        raycaster_cast_columns(player, map, 0, w, w, rc->fog_distance, rc->hits);
+        rc->adaptive_traced = w;
+        return;
+    }
+    
+    // Un rayon toutes les step colonnes et sur la dernière, puis les intervalles
+    int traced = 0;
+    for (int x = 0; x < w; x += step) {
+        raycaster_cast_column(player, map, x, w, rc->fog_distance, &rc->hits[x]);
+        traced++;
+    }
+    if ((w - 1) % step != 0) {
+        raycaster_cast_column(player, map, w - 1, w, rc->fog_distance, &rc->hits[w - 1]);
+        traced++;
+    }
+    for (int x = 0; x < w - 1; x += step) {
+        int x1 = x + step < w - 1 ? x + step : w - 1;
+        traced += raycaster_adaptive_span(rc, player, map, x, x1);
+    }
+    rc->adaptive_traced = traced;
+}
+
+// Éclairage d'une face de mur à une position quantifiée, mis en cache à la première demande
+static void raycaster_wall_light(RaycastRenderer* rc, Map* map, const RayHit* hit, float wall_x, WallColumn* col) {
+    int step = (int)(wall_x * WALL_LIGHT_STEPS);
+    if (step >= WALL_LIGHT_STEPS) step = WALL_LIGHT_STEPS - 1;
+    float along = (step + 0.5f) / WALL_LIGHT_STEPS;
+    
+    // Position mondiale du mur et tile vide devant la face visible (ombres)
+    float wall_world_x, wall_world_y;
+    int face;
+    if (hit->side == 0) {
+        wall_world_x = (float)hit->map_x + (hit->step_x > 0 ? 1.0f : 0.0f);
+        wall_world_y = (float)hit->map_y + along;
+        face = hit->step_x > 0 ? 0 : 1;
+    } else {
+        wall_world_x = (float)hit->map_x + along;
+        wall_world_y = (float)hit->map_y + (hit->step_y > 0 ? 1.0f : 0.0f);
+        face = hit->step_y > 0 ? 2 : 3;
+    }
+    int face_x = hit->side == 0 ? hit->map_x - hit->step_x : hit->map_x;
+    int face_y = hit->side == 1 ? hit->map_y - hit->step_y : hit->map_y;
+    
+    // Murs hors de la map (bordure implicite): pas de clé, calcul direct
+    if (hit->map_x < 0 || hit->map_x >= map->width || hit->map_y < 0 || hit->map_y >= map->height) {
+        lighting_calculate_light_tile(rc->light_manager, wall_world_x, wall_world_y, face_x, face_y,
+                                      &col->light_r, &col->light_g, &col->light_b);
+        return;
+    }
+    
+    // Toute modification des lumières invalide le cache
+    if (rc->wall_light_version != rc->light_manager->version) {
+        memset(rc->wall_light, 0, WALL_LIGHT_CACHE_SIZE * sizeof(WallLightEntry));
+        rc->wall_light_version = rc->light_manager->version;
+    }
+    
+    // Le cache ne garde que les lumières statiques: les lumières animées sont ajoutées
+    // à chaque lecture sans vider le cache
+    Uint32 tile = (Uint32)(hit->map_y * map->width + hit->map_x);
+    Uint32 key = (tile * 4 + face) * WALL_LIGHT_STEPS + step + 1;
+    WallLightEntry* entry = &rc->wall_light[(key * 2654435761u) >> 20 & (WALL_LIGHT_CACHE_SIZE - 1)];
+    if (entry->key != key) {
+        lighting_calculate_static_tile(rc->light_manager, wall_world_x, wall_world_y, face_x, face_y,
+                                       &entry->r, &entry->g, &entry->b);
+        entry->key = key;
+    }
+    col->light_r = entry->r;
+    col->light_g = entry->g;
+    col->light_b = entry->b;
+    lighting_add_animated(rc->light_manager, wall_world_x, wall_world_y, face_x, face_y,
+                          &col->light_r, &col->light_g, &col->light_b);
+}
+
+// Géométrie de la colonne: étendue, texture et position sur la face, sans éclairage
+static void raycaster_wall_geometry(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                                    const RayHit* hit, WallColumn* col) {
+    int h = rc->screen_height;
+    float perp_wall_dist = hit->perp_wall_dist;
+    
+    // Calcul de la hauteur du mur à dessiner
+    int line_height = (int)(h / perp_wall_dist);
+    
+    // Calcul des pixels de début et fin
+    col->draw_start = -line_height / 2 + h / 2;
+    if (col->draw_start < 0) col->draw_start = 0;
+    col->draw_end = line_height / 2 + h / 2;
+    if (col->draw_end >= h) col->draw_end = h - 1;
+    
+    // Récupérer la texture du mur
+    const TextureEntry* wall_tex = textures_get_entry(tm, map_get_wall_texture(map, hit->map_x, hit->map_y));
+    col->tex = wall_tex;
+    
+    // Calcul de la coordonnée x sur la texture
+    float wall_x;
+    if (hit->side == 0) {
+        wall_x = player->y + perp_wall_dist * hit->ray_dir_y;
+    } else {
+        wall_x = player->x + perp_wall_dist * hit->ray_dir_x;
+    }
+    wall_x -= floor(wall_x);
+    
+    int tex_x = (int)(wall_x * wall_tex->width);
+    if ((hit->side == 0 && hit->ray_dir_x > 0) || (hit->side == 1 && hit->ray_dir_y < 0)) {
+        tex_x = wall_tex->width - tex_x - 1;
+    }
+    col->tex_x = tex_x & wall_tex->width_mask;
+    
+    col->step = 1.0 * wall_tex->height / line_height;
+    col->tex_pos = (col->draw_start - h / 2 + line_height / 2) * col->step;
+    col->wall_x = wall_x;
+}
+
+// Éclairage de la colonne: lu dans le cache des faces de murs
+static void raycaster_wall_column_light(RaycastRenderer* rc, Map* map, const RayHit* hit, WallColumn* col) {
+    col->light_r = 1.0f;
+    col->light_g = 1.0f;
+    col->light_b = 1.0f;
+    if (rc->light_manager) {
+        raycaster_wall_light(rc, map, hit, col->wall_x, col);
+    }
+    
+    // Assombrir les côtés EW pour un effet 3D
+    if (hit->side == 1) {
+        col->light_r *= 0.7f;
+        col->light_g *= 0.7f;
+        col->light_b *= 0.7f;
+    }
+}
+
+// Étendue à l'écran, coordonnées de texture et éclairage d'une colonne de mur
+void raycaster_setup_wall(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                          const RayHit* hit, WallColumn* col) {
+    raycaster_wall_geometry(rc, player, map, tm, hit, col);
+    raycaster_wall_column_light(rc, map, hit, col);
+}
+
+// Bloc du damier laissé à la reconstruction pour une parité donnée
+static inline int raycaster_checker_skip(int x, int y, int parity) {
+    return (x / RAYCASTER_CHECKER_BLOCK + y / RAYCASTER_CHECKER_BLOCK + parity) & 1;
+}
+
+// Bloc de sol/plafond entièrement recouvert par les murs de ses colonnes
+static inline int raycaster_block_hidden(RaycastRenderer* rc, int x, int y, int sample_step) {
+    int x1 = x + sample_step < rc->screen_width ? x + sample_step : rc->screen_width;
+    int y1 = y + sample_step < rc->screen_height ? y + sample_step : rc->screen_height;
+    for (int cx = x; cx < x1; cx++) {
+        if (rc->columns[cx].draw_start > y || rc->columns[cx].draw_end < y1) return 0;
+    }
+    return 1;
+}
+
+// Bande de lignes de sol/plafond en cours (constantes de la ligne)
+typedef struct {
+    int y;
+    int y_end;                      // Fin de la bande, coupée par le bas de l'écran
+    int step;                       // Échantillonnage
+    int parity;                     // Damier, -1 pour tous les blocs
+    const Tile* layer;              // LAYER_FLOOR ou LAYER_CEILING
+    int map_width, map_height;
+    float floor_x, floor_y;         // Point du sol de la colonne courante
+    float step_x, step_y;           // Avance par colonne
+    const ShadeTable* shade;        // 32 bits: NULL sans ombrage
+    float darken;                   // 8 bits: ombrage de la ligne
+    const Uint8* unlit;             // 8 bits: table sans éclairage
+    float* world_x;                 // Rendu différé: ligne du G-buffer, NULL sinon
+    float* world_y;
+} FloorRow;
+
+typedef void (*FloorSpan)(RaycastRenderer* rc, const TextureManager* tm, FloorRow* row, int x0, int x1);
+
+// Variantes générées par raycaster_floor.h: les tests par pixel de l'éclairage,
+// de l'ombrage, du damier et des bords disparaissent des variantes spécialisées
+#if RAYCASTER_FLOOR_STEP != 2 || RAYCASTER_CHECKER_BLOCK != 2
+#error "Les variantes spécialisées du sol écrivent des blocs 2x2"
+#endif
+
+#define FLOOR_NAME raycaster_floor_span_plain
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_checker
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 1
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_shaded
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 1
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_shaded_checker
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 1
+#define FLOOR_CHECKER 1
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_lit
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 1
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_lit_checker
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 1
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 1
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_lit_shaded
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 1
+#define FLOOR_SHADED 1
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_lit_shaded_checker
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 1
+#define FLOOR_SHADED 1
+#define FLOOR_CHECKER 1
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+// Bords de l'écran et échantillonnage quelconque (bench_floor)
+#define FLOOR_NAME raycaster_floor_span_edge
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT (rc->light_manager != NULL)
+#define FLOOR_SHADED (row->shade != NULL)
+#define FLOOR_CHECKER (row->parity >= 0)
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 1
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_indexed
+#define FLOOR_INDEXED 1
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_indexed_lit
+#define FLOOR_INDEXED 1
+#define FLOOR_LIT 1
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_indexed_edge
+#define FLOOR_INDEXED 1
+#define FLOOR_LIT (rc->light_manager != NULL)
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 0
+#define FLOOR_EDGE 1
+#include "raycaster_floor.h"
+
+// Passe de géométrie du rendu différé
+#define FLOOR_NAME raycaster_floor_span_gbuffer
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 1
+#define FLOOR_EDGE 0
+#include "raycaster_floor.h"
+
+#define FLOOR_NAME raycaster_floor_span_gbuffer_edge
+#define FLOOR_INDEXED 0
+#define FLOOR_LIT 0
+#define FLOOR_SHADED 0
+#define FLOOR_CHECKER 0
+#define FLOOR_GBUFFER 1
+#define FLOOR_EDGE 1
+#include "raycaster_floor.h"
+
+// [éclairé][ombré][damier]
+static const FloorSpan raycaster_floor_spans[2][2][2] = {
+    { { raycaster_floor_span_plain, raycaster_floor_span_checker },
+      { raycaster_floor_span_shaded, raycaster_floor_span_shaded_checker } },
+    { { raycaster_floor_span_lit, raycaster_floor_span_lit_checker },
+      { raycaster_floor_span_lit_shaded, raycaster_floor_span_lit_shaded_checker } }
+};
+
+// Constantes du sol/plafond pour une frame: directions des rayons extrêmes et
+// variantes choisies une fois (éclairage, brouillard, damier, échantillonnage)
+typedef struct {
+    float ray_dir_x0, ray_dir_y0;
+    float ray_dir_dx, ray_dir_dy;   // Rayon de droite - rayon de gauche
+    int step;
+    int parity;
+    int fog;
+    FloorSpan floor_span;
+    FloorSpan ceiling_span;
+    FloorSpan edge_span;            // Bloc incomplet du bord droit
+    GBuffer* gbuffer;               // Rendu différé, NULL sinon
+} FloorFrame;
+
+static void raycaster_floor_frame(RaycastRenderer* rc, Player* player, int sample_step, int parity,
+                                  FloorFrame* frame) {
+    float ray_dir_x1 = player->dir_x + player->plane_x;
+    float ray_dir_y1 = player->dir_y + player->plane_y;
+    frame->ray_dir_x0 = player->dir_x - player->plane_x;
+    frame->ray_dir_y0 = player->dir_y - player->plane_y;
+    frame->ray_dir_dx = ray_dir_x1 - frame->ray_dir_x0;
+    frame->ray_dir_dy = ray_dir_y1 - frame->ray_dir_y0;
+    frame->step = sample_step;
+    frame->parity = parity;
+    frame->fog = rc->fog_distance > 0.0f;
+    frame->gbuffer = NULL;
+    
+    if (rc->palette) {
+        frame->floor_span = rc->light_manager ? raycaster_floor_span_indexed_lit : raycaster_floor_span_indexed;
+        frame->ceiling_span = frame->floor_span;
+        frame->edge_span = raycaster_floor_span_indexed_edge;
+    } else {
+        int lit = rc->light_manager != NULL;
+        int checker = parity >= 0;
+        // Le plafond est toujours ombré (0.8), le sol seulement dans le brouillard
+        frame->floor_span = raycaster_floor_spans[lit][frame->fog][checker];
+        frame->ceiling_span = raycaster_floor_spans[lit][1][checker];
+        frame->edge_span = raycaster_floor_span_edge;
+    }
+    if (sample_step != RAYCASTER_FLOOR_STEP) {
+        frame->floor_span = frame->edge_span;
+        frame->ceiling_span = frame->edge_span;
+    }
+}
+
+// Géométrie seule: le sol/plafond remplit le G-buffer (échantillonnage standard)
+static void raycaster_floor_frame_deferred(RaycastRenderer* rc, Player* player, FloorFrame* frame) {
+    raycaster_floor_frame(rc, player, RAYCASTER_FLOOR_STEP, -1, frame);
+    frame->gbuffer = &rc->gbuffer;
+    frame->floor_span = raycaster_floor_span_gbuffer;
+    frame->ceiling_span = raycaster_floor_span_gbuffer;
+    frame->edge_span = raycaster_floor_span_gbuffer_edge;
+}
+
+// Point de départ et avance d'une ligne, 0 pour l'horizon et au-delà du brouillard
+static int raycaster_floor_row_setup(RaycastRenderer* rc, Player* player, Map* map,
+                                     const FloorFrame* frame, int y, FloorRow* row, float* row_distance) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    int p = y - h / 2;
+    float pos_z = 0.5 * h;
+    float distance = p != 0 ? pos_z / abs(p) : 0.0f;
+    *row_distance = distance;
+    if (p == 0 || (frame->fog && distance > rc->fog_distance)) return 0;
+    
+    row->y = y;
+    row->y_end = y + frame->step < h ? y + frame->step : h;
+    row->step = frame->step;
+    row->parity = frame->parity;
+    row->layer = map->layers[p < 0 ? LAYER_CEILING : LAYER_FLOOR];
+    row->map_width = map->width;
+    row->map_height = map->height;
+    row->step_x = distance * frame->ray_dir_dx / w;
+    row->step_y = distance * frame->ray_dir_dy / w;
+    row->floor_x = player->x + distance * frame->ray_dir_x0;
+    row->floor_y = player->y + distance * frame->ray_dir_y0;
+    return 1;
+}
+
+// Colonnes d'une ligne: blocs entiers par la variante choisie, le reste par la générique
+static void raycaster_floor_spans_run(RaycastRenderer* rc, TextureManager* tm, const FloorFrame* frame,
+                                      FloorRow* row, int is_ceiling) {
+    int w = rc->screen_width;
+    int full = w - w % frame->step;
+    (is_ceiling ? frame->ceiling_span : frame->floor_span)(rc, tm, row, 0, full);
+    if (full < w) {
+        frame->edge_span(rc, tm, row, full, w);
+    }
+}
+
+// Une bande de frame->step lignes de sol/plafond (rendu 32 bits)
+static void raycaster_floor_row(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                                const FloorFrame* frame, int y) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    FloorRow row;
+    float row_distance;
+    GBufferRow* gbuffer_row = frame->gbuffer ? &frame->gbuffer->rows[y / frame->step] : NULL;
+    
+    if (!raycaster_floor_row_setup(rc, player, map, frame, y, &row, &row_distance)) {
+        if (gbuffer_row) gbuffer_row->lit = 0;
+        // Ligne de l'horizon ou au-delà de la distance de vue: couleur unie
+        Uint32 fill = frame->fog ? rc->fog_color : 0x808080FF;
+        for (int sy = 0; sy < frame->step && y + sy < h; sy++) {
+            Uint32* line = rc->screen_buffer + (y + sy) * w;
+            for (int x = 0; x < w; x++) {
+                line[x] = fill;
+            }
+        }
+        return;
+    }
+    
+    // Ombrage constant de la ligne (plafond 0.8, brouillard) pris dans les tables
+    int is_ceiling = y < h / 2;
+    row.shade = NULL;
+    if (is_ceiling || frame->fog) {
+        row.shade = raycaster_shade_table(rc, is_ceiling ? SHADE_CEILING : SHADE_FLOOR, row_distance);
+    }
+    row.darken = 1.0f;
+    row.unlit = NULL;
+    row.world_x = NULL;
+    row.world_y = NULL;
+    if (gbuffer_row) {
+        // Ombrage appliqué après l'éclairage, par la passe d'éclairage
+        gbuffer_row->lit = 1;
+        gbuffer_row->shade = row.shade;
+        row.world_x = frame->gbuffer->floor_x + (y / frame->step) * frame->gbuffer->blocks_x;
+        row.world_y = frame->gbuffer->floor_y + (y / frame->step) * frame->gbuffer->blocks_x;
+    }
+    raycaster_floor_spans_run(rc, tm, frame, &row, is_ceiling);
+}
+
+void raycaster_draw_floor_row(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                              int y, int sample_step) {
+    FloorFrame frame;
+    raycaster_floor_frame(rc, player, sample_step, -1, &frame);
+    raycaster_floor_row(rc, player, map, tm, &frame, y);
+}
+
+// Rendu 8 bits: texels indexés et tables d'éclairage de la palette
+static void raycaster_render_indexed(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    Palette* pal = rc->palette;
+    const Uint8* texels = pal->texels;
+    Uint8* screen = rc->screen_buffer8;
+    
+    // Sol et plafond: même échantillonnage que le rendu 32 bits
+    FloorFrame frame;
+    raycaster_floor_frame(rc, player, RAYCASTER_FLOOR_STEP, -1, &frame);
+    // Le brouillard du mode 8 bits tend vers le noir (pas de mélange de couleurs par table)
+    Uint8 horizon = frame.fog ? 0 : palette_nearest(pal, 0x808080FF);
+    
+    for (int y = 0; y < h; y += frame.step) {
+        FloorRow row;
+        float row_distance;
+        if (!raycaster_floor_row_setup(rc, player, map, &frame, y, &row, &row_distance)) {
+            for (int sy = y; sy < y + frame.step && sy < h; sy++) {
+                memset(screen + sy * w, horizon, w);
+            }
+            continue;
+        }
+        
+        // Plafond 0.8 et brouillard pris dans le facteur d'ombrage de la ligne
+        int is_ceiling = y < h / 2;
+        row.shade = NULL;
+        row.darken = raycaster_shade_factor(rc, is_ceiling ? SHADE_CEILING : SHADE_FLOOR, row_distance);
+        row.unlit = palette_light_table(pal, row.darken, row.darken, row.darken);
+        row.world_x = NULL;
+        row.world_y = NULL;
+        raycaster_floor_spans_run(rc, tm, &frame, &row, is_ceiling);
+    }
+    
+    // Murs: une table d'éclairage par colonne
+    raycaster_cast_screen(rc, player, map);
+    for (int x = 0; x < w; x++) {
+        RayHit hit = rc->hits[x];
+        WallColumn col;
+        ColumnDepth* depth = &rc->columns[x];
+        if (!hit.hit) {
+            depth->depth = 0.0f;
+            depth->draw_start = 0;
+            depth->draw_end = 0;
+            continue;
+        }
+        raycaster_setup_wall(rc, player, map, tm, &hit, &col);
+        depth->depth = hit.perp_wall_dist;   // Profondeurs des sprites
+        depth->draw_start = col.draw_start;
+        depth->draw_end = col.draw_end;
+        
+        // Sans éclairage, le rendu 32 bits n'assombrit pas non plus les côtés EW
+        float shade = raycaster_shade_factor(rc, SHADE_WALL, hit.perp_wall_dist);
+        const Uint8* colormap = palette_light_table(pal, shade, shade, shade);
+        if (rc->light_manager) {
+            colormap = palette_light_table(pal, col.light_r * shade, col.light_g * shade, col.light_b * shade);
+        }
+        const Uint8* column = texels + col.tex->offset + col.tex_x;
+        int shift = col.tex->width_shift;
+        int mask = col.tex->height_mask;
+        float tex_pos = col.tex_pos;
+        
+        for (int y = col.draw_start; y < col.draw_end; y++) {
+            int tex_y = (int)tex_pos & mask;
+            tex_pos += col.step;
+            screen[y * w + x] = colormap[column[(Uint32)tex_y << shift]];
+        }
+    }
+}
+
+// Texels de la colonne de mur copiés dans le tampon de colonnes, sans éclairage (albédo)
+static void raycaster_wall_texels(RaycastRenderer* rc, TextureManager* tm, int x, const WallColumn* col) {
+    Uint32* column = rc->column_buffer + x * rc->screen_height;
+    const Uint32* texture_pixels = tm->pixels + col->tex->offset;
+    const TextureEntry* wall_tex = col->tex;
+    int tex_x = col->tex_x;
+    float step = col->step;
+    float tex_pos = col->tex_pos;
+    
+    for (int y = col->draw_start; y < col->draw_end; y++) {
+        int tex_y = (int)tex_pos & wall_tex->height_mask;
+        tex_pos += step;
+        column[y] = texture_pixels[((Uint32)tex_y << wall_tex->width_shift) + tex_x];
+    }
+}
+
+// Éclairage précalculé de la colonne, puis brouillard
+static void raycaster_wall_shade_column(RaycastRenderer* rc, int x, const RayHit* hit, const WallColumn* col) {
+    Uint32* column = rc->column_buffer + x * rc->screen_height;
+    const ShadeTable* shade = rc->fog_distance > 0.0f ? raycaster_shade_table(rc, SHADE_WALL, hit->perp_wall_dist) : NULL;
+    
+    if (rc->light_manager) {
+        kernels->light_span(column + col->draw_start, col->draw_end - col->draw_start,
+                            col->light_r, col->light_g, col->light_b);
+    }
+    if (shade) {
+        for (int y = col->draw_start; y < col->draw_end; y++) {
+            column[y] = raycaster_shade(shade, column[y]);
+        }
+    }
+}
+
+// Une colonne de mur texturée et éclairée (rendu 32 bits)
+void raycaster_draw_wall_column(RaycastRenderer* rc, TextureManager* tm, int x,
+                                const RayHit* hit, const WallColumn* col) {
+    raycaster_wall_texels(rc, tm, x, col);
+    raycaster_wall_shade_column(rc, x, hit, col);
+}
+
+// Transposer 4 colonnes de 4 pixels (buffer par colonnes) en 4 lignes de l'écran
+static inline void raycaster_transpose4(const Uint32* src, int src_stride, Uint32* dst, int dst_stride) {
+#ifdef __SSE2__
+    __m128i c0 = _mm_loadu_si128((const __m128i*)(src));
+    __m128i c1 = _mm_loadu_si128((const __m128i*)(src + src_stride));
+    __m128i c2 = _mm_loadu_si128((const __m128i*)(src + 2 * src_stride));
+    __m128i c3 = _mm_loadu_si128((const __m128i*)(src + 3 * src_stride));
+    __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+    __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+    __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+    __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+    _mm_storeu_si128((__m128i*)(dst), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dst + dst_stride), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dst + 2 * dst_stride), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)(dst + 3 * dst_stride), _mm_unpackhi_epi64(t2, t3));
+#else
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            dst[y * dst_stride + x] = src[x * src_stride + y];
+        }
+    }
+#endif
+}
+
+// Recopier les pixels de murs des lignes [y0, y1) du buffer par colonnes vers
+// l'écran, par tuiles de RAYCASTER_TILE x RAYCASTER_TILE: les lectures restent
+// contiguës dans chaque colonne et les lignes écrites restent en cache
+void raycaster_transpose_walls(RaycastRenderer* rc, int y0, int y1) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    const ColumnDepth* columns = rc->columns;
+    
+    for (int ty = y0; ty < y1; ty += RAYCASTER_TILE) {
+        int ty1 = ty + RAYCASTER_TILE < y1 ? ty + RAYCASTER_TILE : y1;
+        for (int tx = 0; tx < w; tx += RAYCASTER_TILE) {
+            int tx1 = tx + RAYCASTER_TILE < w ? tx + RAYCASTER_TILE : w;
+            
+            // Tuile entièrement couverte par les murs: transposition par blocs 4x4
+            int full = tx1 - tx == RAYCASTER_TILE && ty1 - ty == RAYCASTER_TILE;
+            for (int x = tx; x < tx1 && full; x++) {
+                if (columns[x].draw_start > ty || columns[x].draw_end < ty1) full = 0;
+            }
+            if (full) {
+                for (int by = ty; by < ty1; by += 4) {
+                    for (int bx = tx; bx < tx1; bx += 4) {
+                        raycaster_transpose4(rc->column_buffer + bx * h + by, h,
+                                             rc->screen_buffer + by * w + bx, w);
+                    }
+                }
+                continue;
+            }
+            
+            // Bords des murs: seulement la portée de chaque colonne
+            for (int x = tx; x < tx1; x++) {
+                int start = columns[x].draw_start > ty ? columns[x].draw_start : ty;
+                int end = columns[x].draw_end < ty1 ? columns[x].draw_end : ty1;
+                const Uint32* src = rc->column_buffer + x * h;
+                for (int y = start; y < end; y++) {
+                    rc->screen_buffer[y * w + x] = src[y];
+                }
+            }
+        }
+    }
+}
+
+// Profondeur d'un pixel: mur de sa colonne ou ligne de sol/plafond (0 = ligne unie)
+static inline float raycaster_pixel_depth(const ColumnDepth* columns, const float* row_depth, int x, int y) {
+    const ColumnDepth* column = &columns[x];
+    if (y >= column->draw_start && y < column->draw_end) return column->depth;
+    return row_depth[y];
+}
+
+// Reconstruction spatiale: moyenne des voisins ombrés de la même surface
+// (profondeur proche), sinon le voisin de profondeur la plus proche
+static Uint32 raycaster_checker_interpolate(RaycastRenderer* rc, int x, int y, float depth) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    int block_x = x - x % RAYCASTER_CHECKER_BLOCK;
+    int block_y = y - y % RAYCASTER_CHECKER_BLOCK;
+    int neighbors[4][2] = {
+        { block_x - 1, y }, { block_x + RAYCASTER_CHECKER_BLOCK, y },
+        { x, block_y - 1 }, { x, block_y + RAYCASTER_CHECKER_BLOCK }
+    };
+    
+    Uint32 sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+    int count = 0;
+    Uint32 nearest = rc->screen_buffer[y * w + x];
+    float nearest_diff = 1e30f;
+    for (int i = 0; i < 4; i++) {
+        int nx = neighbors[i][0];
+        int ny = neighbors[i][1];
+        if (nx < 0 || nx >= w || ny < 0 || ny >= h) continue;
+        
+        Uint32 color = rc->screen_buffer[ny * w + nx];
+        float diff = fabsf(raycaster_pixel_depth(rc->columns, rc->row_depth, nx, ny) - depth);
+        if (diff <= depth * RAYCASTER_CHECKER_TOLERANCE) {
+            sum_r += (color >> 24) & 0xFF;
+            sum_g += (color >> 16) & 0xFF;
+            sum_b += (color >> 8) & 0xFF;
+            sum_a += color & 0xFF;
+            count++;
+        } else if (diff < nearest_diff) {
+            nearest_diff = diff;
+            nearest = color;
+        }
+    }
+    if (count == 0) return nearest;
+    return ((sum_r / count) << 24) | ((sum_g / count) << 16) | ((sum_b / count) << 8) | (sum_a / count);
+}
+
+// Reprojection d'un pixel: le point qu'il voit (connu exactement grâce aux rayons
+// de toutes les colonnes) est projeté dans la caméra de la frame précédente, dont
+// la couleur est reprise si la profondeur y correspond
+static int raycaster_checker_reproject(RaycastRenderer* rc, Player* player, float inv_det,
+                                       int x, int y, float depth, Uint32* out) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    const Player* prev = &rc->history_player;
+    
+    // Point du monde vu par ce pixel
+    float camera_x = 2 * x / (float)w - 1;
+    float world_x = player->x + (player->dir_x + player->plane_x * camera_x) * depth;
+    float world_y = player->y + (player->dir_y + player->plane_y * camera_x) * depth;
+    float world_z = (float)(h / 2 - y) / h * depth;
+    
+    // Projection dans la caméra précédente
+    float dx = world_x - prev->x;
+    float dy = world_y - prev->y;
+    float prev_depth = inv_det * (-prev->plane_y * dx + prev->plane_x * dy);
+    if (prev_depth <= 0.01f) return 0;
+    
+    float prev_camera_x = inv_det * (prev->dir_y * dx - prev->dir_x * dy) / prev_depth;
+    float sx = (prev_camera_x + 1.0f) * 0.5f * w + 0.5f;
+    float sy = h / 2 - world_z * h / prev_depth + 0.5f;
+    if (sx < 0.0f || sx >= w || sy < 0.0f || sy >= h) return 0;
+    
+    int px = (int)sx;
+    int py = (int)sy;
+    float seen = raycaster_pixel_depth(rc->history_columns, rc->row_depth, px, py);
+    if (fabsf(seen - prev_depth) > prev_depth * RAYCASTER_CHECKER_TOLERANCE) return 0;
+    
+    *out = rc->history[py * w + px];
+    return 1;
+}
+
+// Compléter les blocs de sol/plafond non ombrés. Un bloc n'a qu'un échantillon
+// dans le rendu complet: il est reprojeté en une fois depuis son point
+// d'échantillonnage; les blocs entamés par un mur le sont pixel par pixel
+static void raycaster_checker_reconstruct(RaycastRenderer* rc, Player* player, int parity) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    const Player* prev = &rc->history_player;
+    float inv_det = 1.0f / (prev->plane_x * prev->dir_y - prev->dir_x * prev->plane_y);
+    int reprojected = 0;
+    int interpolated = 0;
+    
+    for (int y0 = 0; y0 < h; y0 += RAYCASTER_CHECKER_BLOCK) {
+        int y1 = y0 + RAYCASTER_CHECKER_BLOCK < h ? y0 + RAYCASTER_CHECKER_BLOCK : h;
+        
+        // Premier bloc non ombré de la bande, puis un bloc sur deux
+        int first = raycaster_checker_skip(0, y0, parity) ? 0 : RAYCASTER_CHECKER_BLOCK;
+        for (int x0 = first; x0 < w; x0 += 2 * RAYCASTER_CHECKER_BLOCK) {
+            int x1 = x0 + RAYCASTER_CHECKER_BLOCK < w ? x0 + RAYCASTER_CHECKER_BLOCK : w;
+            
+            int has_wall = 0;
+            for (int x = x0; x < x1; x++) {
+                if (rc->columns[x].draw_start < y1 && rc->columns[x].draw_end > y0) has_wall = 1;
+            }
+            
+            if (!has_wall) {
+                float depth = rc->row_depth[y0];
+                if (depth <= 0.0f) continue;  // Bande unie (horizon, brouillard): déjà remplie
+                
+                Uint32 color;
+                if (raycaster_checker_reproject(rc, player, inv_det, x0, y0, depth, &color)) {
+                    reprojected += (x1 - x0) * (y1 - y0);
+                } else {
+                    color = raycaster_checker_interpolate(rc, x0, y0, depth);
+                    interpolated += (x1 - x0) * (y1 - y0);
+                }
+                for (int y = y0; y < y1; y++) {
+                    for (int x = x0; x < x1; x++) {
+                        rc->screen_buffer[y * w + x] = color;
+                    }
+                }
+                continue;
+            }
+            
+            for (int y = y0; y < y1; y++) {
+                for (int x = x0; x < x1; x++) {
+                    const ColumnDepth* column = &rc->columns[x];
+                    float depth = rc->row_depth[y];
+                    if (depth <= 0.0f || (y >= column->draw_start && y < column->draw_end)) continue;
+                    
+                    Uint32* pixel = &rc->screen_buffer[y * w + x];
+                    if (raycaster_checker_reproject(rc, player, inv_det, x, y, depth, pixel)) {
+                        reprojected++;
+                    } else {
+                        // Désocclusion ou sortie de l'écran précédent
+                        *pixel = raycaster_checker_interpolate(rc, x, y, depth);
+                        interpolated++;
+                    }
+                }
+            }
+        }
+    }
+    rc->checker_reprojected = reprojected;
+    rc->checker_interpolated = interpolated;
+}
+
+// Murs de toutes les colonnes, rendus dans le buffer par colonnes
+// Rendu différé: texels bruts et position sur la face (G-buffer), l'éclairage
+// vient de raycaster_light_walls
+static void raycaster_wall_pass(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm, int deferred) {
+    int w = rc->screen_width;
+    raycaster_cast_screen(rc, player, map);
+    for (int x = 0; x < w; x++) {
+        const RayHit* hit = &rc->hits[x];
+        WallColumn col;
+        ColumnDepth* column = &rc->columns[x];
+        if (!hit->hit) {
+            // Rien avant la distance de vue: le brouillard est déjà là
+            column->depth = 0.0f;
+            column->draw_start = 0;
+            column->draw_end = 0;
+            continue;
+        }
+        if (deferred) {
+            raycaster_wall_geometry(rc, player, map, tm, hit, &col);
+            rc->gbuffer.wall_u[x] = col.wall_x;
+        } else {
+            raycaster_setup_wall(rc, player, map, tm, hit, &col);
+        }
+        column->depth = hit->perp_wall_dist;
+        column->draw_start = col.draw_start;
+        column->draw_end = col.draw_end;
+        if (deferred) {
+            raycaster_wall_texels(rc, tm, x, &col);
+        } else {
+            raycaster_draw_wall_column(rc, tm, x, hit, &col);
+        }
+    }
+}
+
+// Passe d'éclairage des murs: une valeur par colonne (cache des faces), appliquée
+// à la colonne contiguë avant la transposition
+static void raycaster_light_walls(RaycastRenderer* rc, Map* map) {
+    for (int x = 0; x < rc->screen_width; x++) {
+        const RayHit* hit = &rc->hits[x];
+        if (!hit->hit) continue;
+        WallColumn col;
+        col.draw_start = rc->columns[x].draw_start;
+        col.draw_end = rc->columns[x].draw_end;
+        col.wall_x = rc->gbuffer.wall_u[x];
+        raycaster_wall_column_light(rc, map, hit, &col);
+        raycaster_wall_shade_column(rc, x, hit, &col);
+    }
+}
+
+// Échantillons d'une tuile en colonnes (x, y, visibilité...) pour le noyau
+// light_samples. Une tuile est éclairée en deux groupes: échantillons dans la
+// grille des lumières et hors de la grille, chacun avec sa liste de lumières
+typedef struct {
+    int count;
+    int index[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];     // Bloc du G-buffer
+    int tile_x[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    int tile_y[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float x[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float y[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float visible[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float r[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float g[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+    float b[RAYCASTER_LIGHT_TILE * RAYCASTER_LIGHT_TILE];
+} LightSamples;
+
+static void raycaster_samples_add(LightSamples* s, int index, float x, float y) {
+    int i = s->count++;
+    s->index[i] = index;
+    s->x[i] = x;
+    s->y[i] = y;
+    s->tile_x[i] = (int)x;
+    s->tile_y[i] = (int)y;
+}
+
+// Une lumière sur tout un groupe: facteur d'ombre lu par tile (0 hors de sa zone,
+// comme lighting_accumulate), puis le noyau sur les échantillons
+static void raycaster_samples_light(LightSamples* s, const Light* light) {
+    if (light->visibility) {
+        for (int i = 0; i < s->count; i++) {
+            int vx = s->tile_x[i] - light->vis_x;
+            int vy = s->tile_y[i] - light->vis_y;
+            int visible = 0;
+            if (vx >= 0 && vx < light->vis_w && vy >= 0 && vy < light->vis_h) {
+                visible = light->visibility[vy * light->vis_w + vx];
+            }
+            s->visible[i] = visible == 255 ? 1.0f : visible * (1.0f / 255.0f);
+        }
+    } else {
+        for (int i = 0; i < s->count; i++) s->visible[i] = 1.0f;
+    }
+    KernelLight source = {light->x, light->y, light->radius_squared, light->intensity * light->anim_scale,
+                          light->r, light->g, light->b};
+    kernels->light_samples(&source, s->x, s->y, s->visible, s->count, s->r, s->g, s->b);
+}
+
+// Éclairage d'un groupe, renvoie le nombre de lumières évaluées. Dans la grille:
+// lumières visibles des bits de tile_lights des tiles du groupe, les animées lues
+// dans lm->animated. Hors de la grille: lumières visibles dont le cercle touche le
+// rectangle englobant (sans ombres). Une lumière absente de la tile d'un
+// échantillon ne l'atteint pas: ajoutée quand même, elle n'ajoute que des zéros.
+// Les lumières suivent l'ordre du rendu direct: mêmes sommes, au bit près
+static int raycaster_samples_shade(LightSamples* s, LightManager* lm, int in_grid) {
+    float ambient_r = lm->ambient_r * lm->ambient_intensity;
+    float ambient_g = lm->ambient_g * lm->ambient_intensity;
+    float ambient_b = lm->ambient_b * lm->ambient_intensity;
+    for (int i = 0; i < s->count; i++) {
+        s->r[i] = ambient_r;
+        s->g[i] = ambient_g;
+        s->b[i] = ambient_b;
+    }
+    
+    int evaluated = 0;
+    if (in_grid) {
+        Uint32 slots = 0;
+        for (int i = 0; i < s->count; i++) {
+            slots |= lm->tile_lights[s->tile_y[i] * lm->grid_width + s->tile_x[i]];
+        }
+        Uint32 mask = slots & lm->visible_slots & ~lm->animated_slots;
+        for (int slot = 0; mask; slot++, mask >>= 1) {
+            if (mask & 1) {
+                raycaster_samples_light(s, &lm->lights[lm->slot_light[slot]]);
+                evaluated++;
+            }
+        }
+        if (slots & lm->animated_slots) {
+            for (int i = 0; i < s->count; i++) {
+                lighting_add_animated(lm, s->x[i], s->y[i], s->tile_x[i], s->tile_y[i],
+                                      &s->r[i], &s->g[i], &s->b[i]);
+            }
+            evaluated++;
+        }
+        return evaluated;
+    }
+    
+    float min_x = s->x[0], max_x = min_x;
+    float min_y = s->y[0], max_y = min_y;
+    for (int i = 1; i < s->count; i++) {
+        if (s->x[i] < min_x) min_x = s->x[i];
+        if (s->x[i] > max_x) max_x = s->x[i];
+        if (s->y[i] < min_y) min_y = s->y[i];
+        if (s->y[i] > max_y) max_y = s->y[i];
+    }
+    for (int i = 0; i < lm->visible_count; i++) {
+        const Light* light = &lm->lights[lm->visible_lights[i]];
+        float dx = light->x < min_x ? min_x - light->x : (light->x > max_x ? light->x - max_x : 0.0f);
+        float dy = light->y < min_y ? min_y - light->y : (light->y > max_y ? light->y - max_y : 0.0f);
+        if (dx * dx + dy * dy > light->radius_squared) continue;
+        raycaster_samples_light(s, light);
+        evaluated++;
+    }
+    return evaluated;
+}
+
+// Couleurs éclairées d'un groupe: le bloc porte le même texel partout, un calcul
+// recopié. Même ordre que le rendu direct (éclairage puis ombrage)
+static void raycaster_samples_write(RaycastRenderer* rc, const LightSamples* s) {
+    GBuffer* g = &rc->gbuffer;
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    const int step = RAYCASTER_FLOOR_STEP;
+    for (int i = 0; i < s->count; i++) {
+        int bx = s->index[i] % g->blocks_x;
+        int by = s->index[i] / g->blocks_x;
+        int x = bx * step;
+        int y = by * step;
+        Uint32* out = rc->screen_buffer + y * w + x;
+        Uint32 color = lighting_apply_light_to_color_fast(out[0], s->r[i], s->g[i], s->b[i], 1.0f);
+        if (g->rows[by].shade) {
+            color = raycaster_shade(g->rows[by].shade, color);
+        }
+        for (int sy = 0; sy < step && y + sy < h; sy++) {
+            for (int sx = 0; sx < step && x + sx < w; sx++) {
+                out[sy * w + sx] = color;
+            }
+        }
+    }
+}
+
+// Passe d'éclairage du sol/plafond sur les tuiles [first, last), numérotées ligne
+// par ligne. Chaque lumière de la liste d'une tuile est évaluée sur tous ses
+// échantillons d'un coup (noyau light_samples); une tuile qu'aucune lumière
+// n'atteint ne reçoit que l'ambiante. Les tuiles ne partagent aucun pixel: elles
+// peuvent être réparties entre plusieurs threads
+static void raycaster_light_tiles(RaycastRenderer* rc, int first, int last) {
+    LightManager* lm = rc->light_manager;
+    GBuffer* g = &rc->gbuffer;
+    LightSamples groups[2];     // Dans la grille des lumières, hors de la grille
+    
+    for (int tile = first; tile < last; tile++) {
+        int bx0 = (tile % g->tiles_x) * RAYCASTER_LIGHT_TILE;
+        int by0 = (tile / g->tiles_x) * RAYCASTER_LIGHT_TILE;
+        int bx1 = bx0 + RAYCASTER_LIGHT_TILE < g->blocks_x ? bx0 + RAYCASTER_LIGHT_TILE : g->blocks_x;
+        int by1 = by0 + RAYCASTER_LIGHT_TILE < g->blocks_y ? by0 + RAYCASTER_LIGHT_TILE : g->blocks_y;
+        
+        // Échantillons visibles de la tuile
+        groups[0].count = 0;
+        groups[1].count = 0;
+        for (int by = by0; by < by1; by++) {
+            if (!g->rows[by].lit) continue;
+            for (int bx = bx0; bx < bx1; bx++) {
+                int index = by * g->blocks_x + bx;
+                float x = g->floor_x[index];
+                float y = g->floor_y[index];
+                if (isnan(x)) continue;
+                int in_grid = lm->tile_lights && (int)x >= 0 && (int)x < lm->grid_width &&
+                              (int)y >= 0 && (int)y < lm->grid_height;
+                raycaster_samples_add(&groups[in_grid ? 0 : 1], index, x, y);
+            }
+        }
+        if (groups[0].count + groups[1].count == 0) continue;
+        
+        int evaluated = 0;
+        for (int group = 0; group < 2; group++) {
+            if (groups[group].count == 0) continue;
+            evaluated += raycaster_samples_shade(&groups[group], lm, group == 0);
+            raycaster_samples_write(rc, &groups[group]);
+        }
+        if (evaluated > 0) {
+            g->tiles_lit++;
+        } else {
+            g->tiles_ambient++;
+        }
+    }
+}
+
+// Sprite projeté à l'écran, découpé aux bords
+typedef struct {
+    int x0, x1, y0, y1;
+    float top;                    // Haut du sprite avant découpe
+    float tex_step_y;             // Texels par pixel
+    const TextureEntry* tex;
+    int runs;                     // Portées visibles dans rc->sprite_runs
+} SpriteRect;
+
+// Mur le plus lointain de chaque groupe de RAYCASTER_TILE colonnes (colonne sans mur:
+// infini), renvoie le plus lointain de l'écran. Une cellule d'entités ou un sprite plus
+// profond que tous les groupes qu'il couvre est caché sans tester ses colonnes
+static float raycaster_column_far(RaycastRenderer* rc) {
+    int w = rc->screen_width;
+    float far_all = 0.0f;
+    for (int x0 = 0; x0 < w; x0 += RAYCASTER_TILE) {
+        int x1 = x0 + RAYCASTER_TILE < w ? x0 + RAYCASTER_TILE : w;
+        float far = 0.0f;
+        for (int x = x0; x < x1; x++) {
+            float depth = rc->columns[x].depth > 0.0f ? rc->columns[x].depth : INFINITY;
+            if (depth > far) far = depth;
+        }
+        rc->column_far[x0 / RAYCASTER_TILE] = far;
+        if (far > far_all) far_all = far;
+    }
+    return far_all;
+}
+
+// Rectangle écran d'une entité visible et portées de colonnes devant les murs,
+// 0 si le sprite est hors de l'écran, dans le brouillard ou caché
+static int raycaster_sprite_setup(RaycastRenderer* rc, const TextureManager* tm, const Entities* e, int i,
+                                  SpriteRect* s) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    float depth = e->depth[i];
+    if (rc->fog_distance > 0.0f && depth >= rc->fog_distance) return 0;
+    
+    // Posé sur le sol, hauteur relative à celle d'un mur à cette profondeur; la
+    // largeur suit l'échelle horizontale des murs (texture étirée au carré au sol)
+    const TextureEntry* tex = textures_get_entry(tm, e->texture_id[i]);
+    float wall = h / depth;
+    float height = wall * e->size[i];
+    float width = w * e->view_half[i];
+    float left = 0.5f * w * (1.0f + e->view_x[i]) - 0.5f * width;
+    float bottom = 0.5f * (h + wall);
+    float tex_step_x = tex->width / width;
+    s->top = bottom - height;
+    s->tex = tex;
+    s->tex_step_y = tex->height / height;
+    
+    // Pixels dont le centre est dans le sprite
+    s->x0 = (int)ceilf(left - 0.5f);
+    s->x1 = (int)ceilf(left + width - 0.5f);
+    s->y0 = (int)ceilf(s->top - 0.5f);
+    s->y1 = (int)ceilf(bottom - 0.5f);
+    if (s->x0 < 0) s->x0 = 0;
+    if (s->x1 > w) s->x1 = w;
+    if (s->y0 < 0) s->y0 = 0;
+    if (s->y1 > h) s->y1 = h;
+    if (s->x0 >= s->x1 || s->y0 >= s->y1) return 0;
+    
+    // Colonnes devant les murs (les groupes entièrement cachés sont déjà écartés)
+    const ColumnDepth* columns = rc->columns;
+    int* runs = rc->sprite_runs;
+    int count = 0;
+    int open = 0;
+    for (int x = s->x0; x < s->x1; x++) {
+        int visible = columns[x].depth == 0.0f || depth < columns[x].depth;
+        if (visible != open) {
+            runs[count++] = x;
+            open = visible;
+        }
+        rc->sprite_tex_x[x] = (int)((x + 0.5f - left) * tex_step_x) & tex->width_mask;
+    }
+    if (open) runs[count++] = s->x1;
+    s->runs = count / 2;
+    return s->runs > 0;
+}
+
+// Portée d'une ligne de sprite (rendu 32 bits): texels lus (alpha mis à 0 pour les
+// transparents), éclairés et embrumés, puis mélangés à l'écran sans branchement
+static void raycaster_sprite_span(Uint32* out, const Uint32* src, const int* tex_x, int count, Uint32* row,
+                                  const float* light, const ShadeTable* shade) {
+    for (int k = 0; k < count; k++) {
+        Uint32 texel = src[tex_x[k]];
+        row[k] = (texel >> 8) == RAYCASTER_SPRITE_KEY || (texel & 0xFF) == 0 ? 0 : texel;
+    }
+    if (light) {
+        kernels->light_span(row, count, light[0], light[1], light[2]);
+    }
+    if (shade) {
+        for (int k = 0; k < count; k++) {
+            row[k] = raycaster_shade(shade, row[k]);
+        }
+    }
+    
+    int k = 0;
+#ifdef __SSE2__
+    const __m128i alpha = _mm_set1_epi32(0xFF);
+    for (; k + 4 <= count; k += 4) {
+        __m128i color = _mm_loadu_si128((const __m128i*)(row + k));
+        __m128i screen = _mm_loadu_si128((const __m128i*)(out + k));
+        __m128i hidden = _mm_cmpeq_epi32(_mm_and_si128(color, alpha), _mm_setzero_si128());
+        _mm_storeu_si128((__m128i*)(out + k),
+                         _mm_or_si128(_mm_and_si128(hidden, screen), _mm_andnot_si128(hidden, color)));
+    }
+#endif
+    for (; k < count; k++) {
+        if (row[k] & 0xFF) out[k] = row[k];
+    }
+}
+
+static void raycaster_sprite_draw(RaycastRenderer* rc, const TextureManager* tm, const Entities* e, int i,
+                                  const SpriteRect* s) {
+    int w = rc->screen_width;
+    const TextureEntry* tex = s->tex;
+    const Uint32* pixels = tm->pixels + tex->offset;
+    const ShadeTable* shade = rc->fog_distance > 0.0f ? raycaster_shade_table(rc, SHADE_WALL, e->depth[i]) : NULL;
+    
+    // Éclairage uniforme: celui du sol au pied du sprite
+    float light[3];
+    if (rc->light_manager) {
+        lighting_calculate_light_fast(rc->light_manager, e->x[i], e->y[i], &light[0], &light[1], &light[2]);
+    }
+    
+    for (int y = s->y0; y < s->y1; y++) {
+        int tex_y = (int)((y + 0.5f - s->top) * s->tex_step_y) & tex->height_mask;
+        const Uint32* src = pixels + ((Uint32)tex_y << tex->width_shift);
+        Uint32* out = rc->screen_buffer + y * w;
+        for (int r = 0; r < s->runs; r++) {
+            int x0 = rc->sprite_runs[2 * r];
+            int x1 = rc->sprite_runs[2 * r + 1];
+            raycaster_sprite_span(out + x0, src, rc->sprite_tex_x + x0, x1 - x0, rc->sprite_row,
+                                  rc->light_manager ? light : NULL, shade);
+        }
+    }
+}
+
+// Mode 8 bits: une table d'éclairage par sprite, la transparence lue sur les texels 32 bits
+static void raycaster_sprite_draw_indexed(RaycastRenderer* rc, const TextureManager* tm, const Entities* e, int i,
+                                          const SpriteRect* s) {
+    int w = rc->screen_width;
+    const TextureEntry* tex = s->tex;
+    const Uint32* pixels = tm->pixels + tex->offset;
+    const Uint8* texels = rc->palette->texels + tex->offset;
+    
+    float shade = raycaster_shade_factor(rc, SHADE_WALL, e->depth[i]);
+    const Uint8* colormap = palette_light_table(rc->palette, shade, shade, shade);
+    if (rc->light_manager) {
+        float r, g, b;
+        lighting_calculate_light_fast(rc->light_manager, e->x[i], e->y[i], &r, &g, &b);
+        colormap = palette_light_table(rc->palette, r * shade, g * shade, b * shade);
+    }
+    
+    for (int y = s->y0; y < s->y1; y++) {
+        int tex_y = (int)((y + 0.5f - s->top) * s->tex_step_y) & tex->height_mask;
+        Uint32 row = (Uint32)tex_y << tex->width_shift;
+        Uint8* out = rc->screen_buffer8 + y * w;
+        for (int r = 0; r < s->runs; r++) {
+            for (int x = rc->sprite_runs[2 * r]; x < rc->sprite_runs[2 * r + 1]; x++) {
+                Uint32 texel = row + rc->sprite_tex_x[x];
+                if ((pixels[texel] >> 8) != RAYCASTER_SPRITE_KEY && (pixels[texel] & 0xFF) != 0) {
+                    out[x] = colormap[texels[texel]];
+                }
+            }
+        }
+    }
+}
+
+// Sprites: entités du champ de vue (hachage spatial, PVS), triées en partant de
+// l'ordre de la frame précédente, puis dessinées du plus loin au plus proche.
+// Le coût suit le nombre de sprites à l'écran, pas le nombre d'entités de la map
+void raycaster_draw_sprites(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
+    Entities* e = map->entities;
+    rc->sprites_visible = 0;
+    rc->sprites_drawn = 0;
+    if (!e || e->count == 0) return;
+    
+    // Rien ne se voit au-delà du mur le plus lointain ni du brouillard
+    float far = raycaster_column_far(rc);
+    float max_distance = rc->fog_distance > 0.0f && rc->fog_distance < far ? rc->fog_distance : far;
+    float map_extent = (float)(map->width + map->height);
+    if (!(max_distance < map_extent)) max_distance = map_extent;
+    
+    EntitiesOcclusion occlusion = { rc->column_far, RAYCASTER_TILE, rc->screen_width };
+    rc->sprites_visible = entities_cull_view(e, map, player, max_distance, &occlusion);
+    entities_sort_view(e);
+    for (int k = 0; k < e->order_count; k++) {
+        int i = e->order[k];
+        SpriteRect s;
+        if (!raycaster_sprite_setup(rc, tm, e, i, &s)) continue;
+        if (rc->palette) {
+            raycaster_sprite_draw_indexed(rc, tm, e, i, &s);
+        } else {
+            raycaster_sprite_draw(rc, tm, e, i, &s);
+        }
+        rc->sprites_drawn++;
+    }
+}
+
+// Rendu différé: géométrie complète (murs, sol, plafond) puis éclairage, chaque
+// passe pouvant être mesurée et optimisée séparément
+static void raycaster_render_deferred(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
+    GBuffer* g = &rc->gbuffer;
+    int h = rc->screen_height;
+    
+    raycaster_wall_pass(rc, player, map, tm, 1);
+    FloorFrame frame;
+    raycaster_floor_frame_deferred(rc, player, &frame);
+    for (int y = 0; y < h; y += frame.step) {
+        raycaster_floor_row(rc, player, map, tm, &frame, y);
+    }
+    
+    raycaster_light_walls(rc, map);
+    g->tiles_lit = 0;
+    g->tiles_ambient = 0;
+    raycaster_light_tiles(rc, 0, g->tiles_x * g->tiles_y);
+    raycaster_transpose_walls(rc, 0, h);
+    raycaster_draw_sprites(rc, player, map, tm);
+}
+
+// Rendu en damier: seule la moitié des blocs de sol/plafond (l'éclairage par
+// échantillon, le plus coûteux) est ombrée, le reste vient de la frame précédente.
+// Les murs, éclairés par colonne, sont dessinés en entier et donnent la
+// géométrie exacte de chaque pixel pour la reprojection
+static void raycaster_render_checker(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
+    int w = rc->screen_width;
+    int h = rc->screen_height;
+    int fog = rc->fog_distance > 0.0f;
+    int parity = rc->history_valid ? rc->checker_parity : -1;  // -1: image complète
+    
+    // Profondeur de chaque ligne de sol/plafond, 0 pour les bandes unies
+    for (int y = 0; y < h; y += RAYCASTER_CHECKER_BLOCK) {
+        int p = y - h / 2;
+        int solid = p == 0 || (fog && 0.5f * h / abs(p) > rc->fog_distance);
+        for (int sy = y; sy < y + RAYCASTER_CHECKER_BLOCK && sy < h; sy++) {
+            int ps = sy - h / 2;
+            rc->row_depth[sy] = solid ? 0.0f : 0.5f * h / abs(ps != 0 ? ps : p);
+        }
+    }
+    
+    raycaster_wall_pass(rc, player, map, tm, 0);
+    FloorFrame frame;
+    raycaster_floor_frame(rc, player, RAYCASTER_CHECKER_BLOCK, parity, &frame);
+    for (int y = 0; y < h; y += RAYCASTER_CHECKER_BLOCK) {
+        raycaster_floor_row(rc, player, map, tm, &frame, y);
+    }
+    raycaster_transpose_walls(rc, 0, h);
+    
+    if (parity >= 0) {
+        raycaster_checker_reconstruct(rc, player, parity);
+        rc->checker_parity ^= 1;
+    } else {
+        rc->checker_reprojected = 0;
+        rc->checker_interpolated = 0;
+    }
+    
+    // Historique pour la frame suivante (avant les sprites, qui bougent, et l'interface)
+    memcpy(rc->history, rc->screen_buffer, w * h * sizeof(Uint32));
+    raycaster_draw_sprites(rc, player, map, tm);
+    ColumnDepth* swap = rc->history_columns;
+    rc->history_columns = rc->columns;
+    rc->columns = swap;
+    rc->history_player = *player;
+    rc->history_valid = 1;
+}
+
+void raycaster_render(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm) {
+    rc->expanded = 0;
+    if (rc->palette) {
+        raycaster_render_indexed(rc, player, map, tm);
+        raycaster_draw_sprites(rc, player, map, tm);
+        return;
+    }
+    if (rc->checker) {
+        raycaster_render_checker(rc, player, map, tm);
+        return;
+    }
+    if (rc->deferred && rc->light_manager) {
+        raycaster_render_deferred(rc, player, map, tm);
+        return;
+    }
+    
+    int h = rc->screen_height;
+    
+    // Murs d'abord: leur étendue permet de sauter le sol/plafond caché
+    raycaster_wall_pass(rc, player, map, tm, 0);
+    
+    // Sol et plafond avec textures (échantillonnage optimisé), par bandes de
+    // RAYCASTER_TILE lignes suivies de la transposition des murs de la bande,
+    // pendant que ses lignes sont encore en cache. Variantes choisies une fois par frame
+    FloorFrame frame;
+    raycaster_floor_frame(rc, player, RAYCASTER_FLOOR_STEP, -1, &frame);
+    
+    for (int y0 = 0; y0 < h; y0 += RAYCASTER_TILE) {
+        int y1 = y0 + RAYCASTER_TILE < h ? y0 + RAYCASTER_TILE : h;
+        for (int y = y0; y < y1; y += frame.step) {
+            raycaster_floor_row(rc, player, map, tm, &frame, y);
+        }
+        raycaster_transpose_walls(rc, y0, y1);
+    }
+    raycaster_draw_sprites(rc, player, map, tm);
+}
+
+// Convertir le buffer 8 bits en couleurs 32 bits via la palette
+static void raycaster_expand_rows(RaycastRenderer* rc, Uint32* dst, int pitch_pixels) {
+    const Uint32* colors = rc->palette->colors;
+    for (int y = 0; y < rc->screen_height; y++) {
+        const Uint8* src = rc->screen_buffer8 + y * rc->screen_width;
+        Uint32* row = dst + y * pitch_pixels;
+        for (int x = 0; x < rc->screen_width; x++) {
+            row[x] = colors[src[x]];
+        }
+    }
+}
+
+void raycaster_expand(RaycastRenderer* rc) {
+    if (!rc->palette || rc->expanded) return;
+    raycaster_expand_rows(rc, rc->screen_buffer, rc->screen_width);
+    rc->expanded = 1;
+}
+
+void raycaster_present(RaycastRenderer* rc) {
+    if (!rc->screen_texture) return;
+    if (rc->palette && !rc->expanded) {
+        // Mode 8 bits: expansion directement dans la texture de streaming
+        void* pixels;
+        int pitch;
+        if (SDL_LockTexture(rc->screen_texture, NULL, &pixels, &pitch) == 0) {
+            raycaster_expand_rows(rc, (Uint32*)pixels, pitch / (int)sizeof(Uint32));
+            SDL_UnlockTexture(rc->screen_texture);
+        }
+    } else {
+        // Mettre à jour la texture avec le buffer
+        SDL_UpdateTexture(rc->screen_texture, NULL, rc->screen_buffer, 
+                         rc->screen_width * sizeof(Uint32));
+    }
+    
+    // Copier la texture vers le renderer
+    SDL_RenderCopy(rc->renderer, rc->screen_texture, NULL, NULL);
+    SDL_RenderPresent(rc->renderer);
+}
+
+void raycaster_list_maps(void) {
+    printf("Maps disponibles:\n");
+    printf("(Listez vos fichiers .txt dans le dossier maps/)\n");
+}
+
+int raycaster_resize(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height) {
+    // Libérer les anciennes ressources
+    if (rc->screen_buffer) {
+        free(rc->screen_buffer);
+    }
+    free(rc->screen_buffer8);
+    free(rc->column_buffer);
+    free(rc->columns);
+    free(rc->hits);
+    free(rc->shade);
+    free(rc->wall_light);
+    free(rc->column_far);
+    free(rc->sprite_tex_x);
+    free(rc->sprite_runs);
+    free(rc->sprite_row);
+    raycaster_free_checker(rc);
+    raycaster_free_deferred(rc);
+    if (rc->screen_texture) {
+        SDL_DestroyTexture(rc->screen_texture);
+    }
+    
+    // Réinitialiser avec la nouvelle taille
+    return raycaster_init(rc, renderer, width, height);
 }
\ No newline at end of file
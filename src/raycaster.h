@@ -1,36 +1,199 @@
-#ifndef RAYCASTER_H
-#define RAYCASTER_H
-
-#include <SDL2/SDL.h>
-#include "map.h"
-#include "player.h"
-#include "textures.h"
-#include "../editor/lighting.h"
-
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 600
-
-typedef struct {
-    SDL_Renderer* renderer;
-    SDL_Texture* screen_texture;
-    Uint32* screen_buffer;
-    int screen_width;
-    int screen_height;
-    LightManager* light_manager;  // Gestionnaire d'éclairage
-} RaycastRenderer;
-
-// Fonctions publiques
-int raycaster_init(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height);
-void raycaster_destroy(RaycastRenderer* rc);
-void raycaster_set_lighting(RaycastRenderer* rc, LightManager* lm);
-void raycaster_render(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm);
-void raycaster_clear_screen(RaycastRenderer* rc, Uint32 color);
-void raycaster_present(RaycastRenderer* rc);
-
-// Fonctions utilitaires
-Uint32 raycaster_get_pixel_from_texture(Uint32* texture_pixels, int tex_x, int tex_y);
-Uint32 raycaster_darken_color(Uint32 color, float factor);
-void raycaster_list_maps(void);
-int raycaster_resize(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height);
-
+#ifndef RAYCASTER_H
+#define RAYCASTER_H
+
+#include <SDL2/SDL.h>
+#include "map.h"
+#include "player.h"
+#include "textures.h"
+#include "palette.h"
+#include "../editor/lighting.h"
+
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 600
+
+#define SHADE_BUCKETS 64             // Cases de distance des tables d'ombrage
+#define RAYCASTER_FOG_START 0.4f     // Le brouillard commence à 40% de la distance de vue
+#define RAYCASTER_FOG_DEFAULT 16.0f  // Distance de vue de la touche F
+#define RAYCASTER_FOG_COLOR 0x000000FF
+
+#define WALL_LIGHT_STEPS 16          // Positions mises en cache le long d'une face de mur
+#define WALL_LIGHT_CACHE_SIZE 4096   // Entrées du cache d'éclairage des murs (puissance de 2)
+
+#define RAYCASTER_PACKET 4                 // Rayons de colonnes voisines traversés ensemble (SSE2)
+#define RAYCASTER_PACKET_MAX 16            // Paquet le plus large (AVX-512)
+#define RAYCASTER_ADAPTIVE_STEP 8          // Écart des rayons du lancer adaptatif (touche R)
+#define RAYCASTER_TILE 8                   // Tuiles de la transposition des murs (multiple de 4)
+#define RAYCASTER_FLOOR_STEP 2             // Échantillonnage du sol/plafond (1 pixel sur 2)
+#define RAYCASTER_CHECKER_BLOCK 2          // Côté des blocs du damier (= échantillonnage du sol)
+#define RAYCASTER_CHECKER_TOLERANCE 0.05f  // Écart de profondeur relatif accepté (reprojection, voisins)
+#define RAYCASTER_LIGHT_TILE 8             // Tuiles de l'éclairage différé, en blocs de sol (16x16 pixels)
+#define RAYCASTER_SPRITE_KEY 0xFF00FF      // Couleur transparente des sprites (RGB magenta, ou alpha nul)
+
+// Éclairage d'une position de face de mur, gardé d'une frame à l'autre
+typedef struct {
+    Uint32 key;                   // ((tile * 4 + face) * WALL_LIGHT_STEPS + pas) + 1, 0 = vide
+    float r, g, b;
+} WallLightEntry;
+
+// Surfaces ayant un assombrissement constant (plafond 0.8)
+enum {
+    SHADE_FLOOR = 0,
+    SHADE_CEILING = 1,
+    SHADE_WALL = 2,
+    SHADE_SURFACES = 3
+};
+
+// Table d'ombrage d'une surface à une distance: valeur de canal -> valeur assombrie/embrumée
+typedef struct {
+    Uint8 r[256];
+    Uint8 g[256];
+    Uint8 b[256];
+} ShadeTable;
+
+// Résultat du lancer de rayon d'une colonne
+typedef struct {
+    int hit;                      // 0 si aucun mur avant la distance de vue
+    float ray_dir_x, ray_dir_y;
+    int map_x, map_y;             // Tile du mur touché
+    int step_x, step_y;
+    int side;                     // 0 pour côté NS, 1 pour côté EW
+    float perp_wall_dist;
+} RayHit;
+
+// Géométrie du mur d'une colonne (transposition des murs, reprojection du damier)
+typedef struct {
+    float depth;                  // Distance perpendiculaire du mur
+    int draw_start, draw_end;     // Pixels du mur (vide si aucun mur)
+} ColumnDepth;
+
+// Ligne de blocs de sol/plafond du G-buffer
+typedef struct {
+    int lit;                      // 0: ligne unie (horizon, au-delà du brouillard)
+    const ShadeTable* shade;      // Ombrage constant de la ligne, NULL sans
+} GBufferRow;
+
+// G-buffer du rendu différé: l'albédo reste dans screen_buffer (sol/plafond) et
+// column_buffer (murs); la clé d'éclairage est la position monde d'un échantillon
+// par bloc de sol (2 octets par pixel) et la position sur la face de chaque colonne
+typedef struct {
+    int blocks_x, blocks_y;       // Blocs de RAYCASTER_FLOOR_STEP pixels
+    float* floor_x;               // [blocks_x * blocks_y], NAN: bloc caché par les murs
+    float* floor_y;
+    GBufferRow* rows;             // [blocks_y]
+    float* wall_u;                // [screen_width] position sur la face touchée (0..1)
+    int tiles_x, tiles_y;         // Tuiles de RAYCASTER_LIGHT_TILE blocs
+    int tiles_lit;                // Tuiles évaluées lumière par lumière à la dernière frame
+    int tiles_ambient;            // Tuiles qu'aucune lumière n'atteint (ambiante seule)
+} GBuffer;
+
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* screen_texture;
+    Uint32* screen_buffer;
+    int screen_width;
+    int screen_height;
+    LightManager* light_manager;  // Gestionnaire d'éclairage
+    Palette* palette;             // Mode 8 bits si non NULL
+    Uint8* screen_buffer8;        // Buffer indexé du mode 8 bits
+    int expanded;                 // screen_buffer contient déjà l'image 8 bits convertie
+    
+    // Les murs sont rendus colonne par colonne dans un buffer où chaque colonne
+    // est contiguë (index x * hauteur + y), puis transposés vers screen_buffer
+    Uint32* column_buffer;
+    ColumnDepth* columns;         // [screen_width] étendue des murs de la frame courante
+    RayHit* hits;                 // [screen_width] rayons de la frame courante
+    
+    // Lancer adaptatif: un rayon toutes les adaptive_step colonnes, subdivisé là où
+    // la face touchée change; entre deux rayons sur la même face, les colonnes
+    // sont calculées directement sur cette face
+    int adaptive_step;            // 0 = un rayon par colonne
+    int adaptive_traced;          // Rayons réellement tracés à la dernière frame
+    
+    // Brouillard et distance de vue maximale
+    float fog_distance;           // 0 = illimitée, sans brouillard
+    float fog_start;
+    Uint32 fog_color;
+    float shade_scale;            // Distance -> case de table (SHADE_BUCKETS / fog_distance)
+    ShadeTable* shade;            // [SHADE_SURFACES * SHADE_BUCKETS]
+    float shade_factor[SHADE_SURFACES][SHADE_BUCKETS];  // Mêmes facteurs pour le mode 8 bits
+    
+    // Cache de l'éclairage des faces de murs, rempli à la demande et vidé quand
+    // la version de l'éclairage change
+    WallLightEntry* wall_light;   // [WALL_LIGHT_CACHE_SIZE]
+    Uint32 wall_light_version;
+    
+    // Rendu en damier: seuls les blocs d'une parité sont ombrés à chaque frame,
+    // les autres sont reprojetés depuis la frame précédente ou interpolés
+    int checker;                  // Mode actif (ignoré en mode 8 bits)
+    int checker_parity;           // Parité des blocs ombrés à la prochaine frame
+    Uint32* history;              // Image de la frame précédente, sans l'interface
+    ColumnDepth* history_columns; // [screen_width] murs de la frame précédente
+    float* row_depth;             // [screen_height] distance du sol/plafond, 0 = ligne unie
+    Player history_player;        // Caméra de la frame précédente
+    int history_valid;            // 0: la prochaine frame est rendue en entier
+    int checker_reprojected;      // Pixels reprojetés / interpolés à la dernière frame
+    int checker_interpolated;
+    
+    // Rendu différé: passe de géométrie (texels sans éclairage + G-buffer), puis
+    // passe d'éclairage séparée, par colonne pour les murs et par tuile d'écran
+    // pour le sol/plafond
+    int deferred;                 // Mode actif (ignoré en mode 8 bits, en damier et sans éclairage)
+    GBuffer gbuffer;
+    
+    // Sprites des entités de la map, dessinés sur l'image du plus loin au plus proche:
+    // une colonne de sprite n'apparaît que devant le mur de sa colonne (columns)
+    float* column_far;            // [groupes de RAYCASTER_TILE colonnes] mur le plus lointain
+    int* sprite_tex_x;            // [screen_width] colonne de texture du sprite en cours
+    int* sprite_runs;             // [screen_width + 1] portées de colonnes visibles (début, fin)
+    Uint32* sprite_row;           // [screen_width] texels éclairés d'une portée avant le mélange
+    int sprites_visible;          // Entités dans le champ de vue à la dernière frame
+    int sprites_drawn;            // Sprites dessinés (pas entièrement cachés par les murs)
+} RaycastRenderer;
+
+// Colonne de mur prête à dessiner
+typedef struct {
+    int draw_start, draw_end;
+    const TextureEntry* tex;
+    int tex_x;
+    float step, tex_pos;
+    float wall_x;                     // Position sur la face (0..1), clé de l'éclairage
+    float light_r, light_g, light_b;  // Éclairage de la colonne (côtés EW assombris)
+} WallColumn;
+
+// Fonctions publiques
+int raycaster_init(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height);
+void raycaster_destroy(RaycastRenderer* rc);
+void raycaster_set_lighting(RaycastRenderer* rc, LightManager* lm);
+void raycaster_set_palette(RaycastRenderer* rc, Palette* palette);
+void raycaster_set_fog(RaycastRenderer* rc, float max_distance, Uint32 color);
+int raycaster_set_checker(RaycastRenderer* rc, int enabled);
+int raycaster_set_deferred(RaycastRenderer* rc, int enabled);
+void raycaster_set_adaptive(RaycastRenderer* rc, int step);
+void raycaster_reset_history(RaycastRenderer* rc);
+void raycaster_render(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm);
+void raycaster_clear_screen(RaycastRenderer* rc, Uint32 color);
+void raycaster_present(RaycastRenderer* rc);
+void raycaster_expand(RaycastRenderer* rc);
+
+// Noyaux du rendu 32 bits (utilisés par raycaster_render et les benchmarks)
+void raycaster_cast_column(Player* player, Map* map, int x, int w, float max_distance, RayHit* hit);
+void raycaster_cast_columns(Player* player, Map* map, int x, int count, int w, float max_distance, RayHit* hits);
+void raycaster_setup_wall(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                          const RayHit* hit, WallColumn* col);
+void raycaster_draw_floor_row(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm,
+                              int y, int sample_step);
+void raycaster_draw_wall_column(RaycastRenderer* rc, TextureManager* tm, int x,
+                                const RayHit* hit, const WallColumn* col);
+void raycaster_transpose_walls(RaycastRenderer* rc, int y0, int y1);
+
+// Sprites de map->entities sur l'image rendue (32 ou 8 bits), profondeurs des murs
+// de la frame (appelé par raycaster_render)
+void raycaster_draw_sprites(RaycastRenderer* rc, Player* player, Map* map, TextureManager* tm);
+
+// Fonctions utilitaires
+Uint32 raycaster_get_pixel_from_texture(const Uint32* pixels, const TextureEntry* tex, int tex_x, int tex_y);
+Uint32 raycaster_darken_color(Uint32 color, float factor);
+void raycaster_list_maps(void);
+int raycaster_resize(RaycastRenderer* rc, SDL_Renderer* renderer, int width, int height);
+
 #endif
\ No newline at end of file
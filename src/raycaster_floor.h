@@ -0,0 +1,139 @@
+// Bande de lignes de sol/plafond, colonnes [x0, x1): modèle inclus plusieurs fois
+// par raycaster.c (pas de garde d'inclusion), une variante par combinaison de
+// paramètres. Les paramètres constants disparaissent à la compilation: la boucle
+// des variantes spécialisées ne garde que les calculs du pixel.
+//
+// Paramètres (tous #undef en fin de fichier):
+//   FLOOR_NAME      nom de la fonction générée
+//   FLOOR_INDEXED   1: buffer 8 bits et tables de la palette, 0: RGBA8888
+//   FLOOR_LIT       éclairage par échantillon
+//   FLOOR_SHADED    table d'ombrage de la ligne (plafond, brouillard; 32 bits)
+//   FLOOR_CHECKER   seuls les blocs de la parité row->parity sont ombrés (32 bits)
+//   FLOOR_GBUFFER   rendu différé: texel brut et position monde de l'échantillon
+//                   dans row->world_x/y (NAN pour un bloc caché), éclairage et
+//                   ombrage laissés à la passe d'éclairage
+//   FLOOR_EDGE      0: blocs 2x2 entiers (x1 - x0 pair, RAYCASTER_FLOOR_STEP),
+//                   1: variante générique, pas et bords de l'écran quelconques.
+//                   Les autres paramètres y sont lus à l'exécution.
+
+static void FLOOR_NAME(RaycastRenderer* rc, const TextureManager* tm, FloorRow* row, int x0, int x1) {
+    int w = rc->screen_width;
+    int y = row->y;
+#if FLOOR_EDGE
+    int step = row->step;
+    int h = rc->screen_height;
+#else
+    const int step = RAYCASTER_FLOOR_STEP;
+#endif
+    float floor_x = row->floor_x;
+    float floor_y = row->floor_y;
+    float advance_x = row->step_x * step;
+    float advance_y = row->step_y * step;
+    const Tile* layer = row->layer;
+    unsigned map_width = (unsigned)row->map_width;
+    unsigned map_height = (unsigned)row->map_height;
+    // Seconde ligne de la bande, la même si le bas de l'écran la coupe
+    int second_row = row->y_end - y > 1 ? w : 0;
+#if FLOOR_INDEXED
+    const Uint8* texels = rc->palette->texels;
+    Uint8* out0 = rc->screen_buffer8 + y * w;
+    Uint8* out1 = out0 + second_row;
+#else
+    Uint32* out0 = rc->screen_buffer + y * w;
+    Uint32* out1 = out0 + second_row;
+#endif
+#if FLOOR_GBUFFER
+    int block = x0 / step;
+#endif
+#if FLOOR_EDGE
+    (void)out1;                     // Bloc écrit ligne par ligne avec bornes
+#elif !FLOOR_INDEXED
+    const ColumnDepth* columns = rc->columns;
+    int y_end = row->y_end;
+#endif
+
+    for (int x = x0; x < x1; x += step) {
+#if !FLOOR_INDEXED
+#if FLOOR_EDGE
+        int hidden = raycaster_block_hidden(rc, x, y, step);
+#else
+        int hidden = columns[x].draw_start <= y && columns[x].draw_end >= y_end &&
+                     columns[x + 1].draw_start <= y && columns[x + 1].draw_end >= y_end;
+#endif
+        if ((FLOOR_CHECKER && raycaster_checker_skip(x, y, row->parity)) || hidden) {
+#if FLOOR_GBUFFER
+            row->world_x[block++] = NAN;
+#endif
+            floor_x += advance_x;
+            floor_y += advance_y;
+            continue;
+        }
+#endif
+
+        int cell_x = (int)floor_x;
+        int cell_y = (int)floor_y;
+        float frac_x = floor_x - cell_x;
+        float frac_y = floor_y - cell_y;
+
+        // Hors de la map: texture 0, comme map_get_floor_texture
+        int tex_id = (unsigned)cell_x < map_width && (unsigned)cell_y < map_height
+                   ? layer[cell_y * (int)map_width + cell_x].texture_id : 0;
+        const TextureEntry* tex = textures_get_entry(tm, tex_id);
+
+#if FLOOR_INDEXED
+        int tex_x = (int)(tex->width * frac_x) & tex->width_mask;
+        int tex_y = (int)(tex->height * frac_y) & tex->height_mask;
+        Uint8 texel = texels[tex->offset + ((Uint32)tex_y << tex->width_shift) + tex_x];
+
+        const Uint8* colormap = row->unlit;
+        if (FLOOR_LIT) {
+            float lr, lg, lb;
+            lighting_calculate_light_fast(rc->light_manager, floor_x, floor_y, &lr, &lg, &lb);
+            colormap = palette_light_table(rc->palette, lr * row->darken, lg * row->darken, lb * row->darken);
+        }
+        Uint8 color = colormap[texel];
+#else
+        Uint32 color = raycaster_get_pixel_from_texture(tm->pixels, tex,
+                                                        (int)(tex->width * frac_x),
+                                                        (int)(tex->height * frac_y));
+        if (FLOOR_LIT) {
+            lighting_calculate_pixel_color_fast(rc->light_manager, floor_x, floor_y, color, &color);
+        }
+        if (FLOOR_SHADED) {
+            color = raycaster_shade(row->shade, color);
+        }
+#endif
+#if FLOOR_GBUFFER
+        row->world_x[block] = floor_x;
+        row->world_y[block] = floor_y;
+        block++;
+#endif
+
+        // Répliquer le pixel échantillonné sur le bloc
+#if FLOOR_EDGE
+        for (int sy = 0; sy < step && y + sy < h; sy++) {
+            for (int sx = 0; sx < step && x + sx < w; sx++) {
+                out0[sy * w + x + sx] = color;
+            }
+        }
+#else
+        out0[x] = color;
+        out0[x + 1] = color;
+        out1[x] = color;
+        out1[x + 1] = color;
+#endif
+
+        floor_x += advance_x;
+        floor_y += advance_y;
+    }
+    row->floor_x = floor_x;
+    row->floor_y = floor_y;
+}
+
+#undef FLOOR_NAME
+#undef FLOOR_INDEXED
+#undef FLOOR_LIT
+#undef FLOOR_SHADED
+#undef FLOOR_CHECKER
+#undef FLOOR_GBUFFER
+#undef FLOOR_EDGE
@@ -1,101 +1,665 @@
-#include "textures.h"
-#include <stdio.h>
-#include <stdlib.h>
-
-// Variables globales pour stocker les pixels des textures
-Uint32* texture_pixels[MAX_TEXTURES];
-int texture_loaded[MAX_TEXTURES];
-
-int textures_init(TextureManager* tm, SDL_Renderer* renderer) {
-    tm->count = 0;
-    
-    // Initialiser les tableaux
-    for (int i = 0; i < MAX_TEXTURES; i++) {
-        tm->textures[i] = NULL;
-        texture_pixels[i] = NULL;
-        texture_loaded[i] = 0;
-    }
-    
-    char path[64];
-    for (int i = 0; i < MAX_TEXTURES; i++) {
-        snprintf(path, sizeof(path), "textures/texture%d.bmp", i + 1);
-        
-        SDL_Surface* surface = SDL_LoadBMP(path);
-        if (!surface) {
-            printf("Impossible de charger %s: %s\n", path, SDL_GetError());
-            break;
-        }
-        
-        // Convertir en format RGBA32 pour un accès facile aux pixels
-        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
-        SDL_FreeSurface(surface);
-        
-        if (!converted) {
-            printf("Erreur de conversion de surface: %s\n", SDL_GetError());
-            break;
-        }
-        
-        // Créer la texture SDL
-        tm->textures[i] = SDL_CreateTextureFromSurface(renderer, converted);
-        if (!tm->textures[i]) {
-            printf("Erreur création texture: %s\n", SDL_GetError());
-            SDL_FreeSurface(converted);
-            break;
-        }
-        
-        // Allouer et copier les pixels pour le raycasting
-        texture_pixels[i] = malloc(TEXTURE_SIZE * TEXTURE_SIZE * sizeof(Uint32));
-        if (texture_pixels[i]) {
-            // Redimensionner si nécessaire
-            if (converted->w != TEXTURE_SIZE || converted->h != TEXTURE_SIZE) {
-                SDL_Surface* resized = SDL_CreateRGBSurface(0, TEXTURE_SIZE, TEXTURE_SIZE, 32, 
-                                                          0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
-                if (resized) {
-                    SDL_BlitScaled(converted, NULL, resized, NULL);
-                    memcpy(texture_pixels[i], resized->pixels, TEXTURE_SIZE * TEXTURE_SIZE * sizeof(Uint32));
-                    SDL_FreeSurface(resized);
-                } else {
-                    memcpy(texture_pixels[i], converted->pixels, converted->w * converted->h * sizeof(Uint32));
-                }
-            } else {
-                memcpy(texture_pixels[i], converted->pixels, TEXTURE_SIZE * TEXTURE_SIZE * sizeof(Uint32));
-            }
-            texture_loaded[i] = 1;
-        }
-        
-        SDL_FreeSurface(converted);
-        tm->count++;
-    }
-    
-    printf("%d textures chargées\n", tm->count);
-    return tm->count;
-}
-
-void textures_destroy(TextureManager* tm) {
-    for (int i = 0; i < tm->count; i++) {
-        if (tm->textures[i]) {
-            SDL_DestroyTexture(tm->textures[i]);
-            tm->textures[i] = NULL;
-        }
-        if (texture_pixels[i]) {
-            free(texture_pixels[i]);
-            texture_pixels[i] = NULL;
-        }
-        texture_loaded[i] = 0;
-    }
-    tm->count = 0;
-}
-
-SDL_Texture* textures_get(TextureManager* tm, int id) {
-    if (id >= 0 && id < tm->count) {
-        return tm->textures[id];
-    }
-    return NULL;
-}
-
-Uint32* textures_get_pixels(TextureManager* tm, int id) {
-    if (id >= 0 && id < MAX_TEXTURES && texture_loaded[id]) {
-        return texture_pixels[id];
-    }
-    return NULL;
-}
+#include "textures.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define TEXTURE_MISSING_COLOR 0x808080FF   // Gris par défaut
+#define TEXTURES_CACHE_VERSION 1
+
+// En-tête du cache sur disque, suivi des enregistrements triés par hash puis des pixels
+typedef struct {
+    char magic[4];          // "PCTX"
+    Uint32 version;
+    Uint32 count;
+    Uint32 pixel_count;
+} TextureCacheHeader;
+
+typedef struct {
+    Uint64 hash;            // Hash du fichier BMP source
+    Uint32 offset;          // En pixels, depuis le début de la zone de pixels
+    Uint32 width;
+    Uint32 height;
+    Uint32 mip_count;
+} TextureCacheRecord;
+
+// Cache ouvert en mémoire (mmap / MapViewOfFile)
+typedef struct {
+    const Uint8* data;
+    size_t size;
+    const TextureCacheRecord* records;
+    const Uint32* pixels;
+    Uint32 count;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} TextureCache;
+
+// Une texture à préparer au démarrage
+typedef struct {
+    int id;
+    Uint64 hash;
+    int cache_index;        // Enregistrement du cache correspondant, -1 si à décoder
+    Uint32* pixels;         // Chaîne de mips décodée (NULL si servie par le cache)
+    int width;
+    int height;
+    int mip_count;
+} TextureJob;
+
+typedef struct {
+    TextureJob* jobs;
+    int count;
+    SDL_atomic_t next;
+    const TextureCache* cache;
+} TextureWorkQueue;
+
+static int textures_pow2(int size) {
+    int p = 1;
+    while (p < size && p < TEXTURE_SIZE_MAX) p <<= 1;
+    return p;
+}
+
+// Côté accepté par les échantillonneurs (masques et décalages): puissance de 2
+// non nulle, au plus TEXTURE_SIZE_MAX
+static int textures_valid_size(Uint32 size) {
+    return size >= 1 && size <= TEXTURE_SIZE_MAX && (size & (size - 1)) == 0;
+}
+
+static int textures_log2(int p) {
+    int shift = 0;
+    while ((1 << shift) < p) shift++;
+    return shift;
+}
+
+// Nombre de niveaux et taille totale (en pixels) d'une chaîne de mips
+static int textures_mip_levels(int w, int h) {
+    int levels = 1;
+    while (w > 1 || h > 1) {
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+static Uint32 textures_chain_size(int w, int h, int levels) {
+    Uint32 size = 0;
+    for (int level = 0; level < levels; level++) {
+        size += (Uint32)(w * h);
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+    }
+    return size;
+}
+
+// "textureN.bmp" -> N-1, -1 sinon
+int textures_id_from_name(const char* name) {
+    int number;
+    char tail[8];
+    if (sscanf(name, "texture%d.%7s", &number, tail) == 2 && strcmp(tail, "bmp") == 0 &&
+        number >= 1 && number <= MAX_TEXTURES) {
+        return number - 1;
+    }
+    return -1;
+}
+
+static void textures_path(int id, char* out_path, size_t out_size) {
+    snprintf(out_path, out_size, "textures/texture%d.bmp", id + 1);
+}
+
+static Uint64 textures_hash(const Uint8* data, size_t size) {
+    // FNV-1a 64 bits
+    Uint64 hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static Uint8* textures_read_file(const char* path, size_t* out_size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Impossible d'ouvrir %s\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    Uint8* data = size > 0 ? malloc((size_t)size) : NULL;
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        printf("Erreur lecture %s\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *out_size = (size_t)size;
+    return data;
+}
+
+// Réduction 2x2 d'un niveau vers le suivant (moyenne par canal)
+static void textures_downsample(const Uint32* src, int w, int h, Uint32* dst) {
+    int nw = w > 1 ? w >> 1 : 1;
+    int nh = h > 1 ? h >> 1 : 1;
+    int dx = w > 1 ? 1 : 0;
+    int dy = h > 1 ? w : 0;
+    
+    for (int y = 0; y < nh; y++) {
+        for (int x = 0; x < nw; x++) {
+            const Uint32* p = src + (y * (h > 1 ? 2 : 1)) * w + x * (w > 1 ? 2 : 1);
+            Uint32 a = p[0], b = p[dx], c = p[dy], d = p[dy + dx];
+            Uint32 out = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                Uint32 sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) +
+                             ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+                out |= ((sum + 2) >> 2) << shift;
+            }
+            dst[y * nw + x] = out;
+        }
+    }
+}
+
+// Décoder un BMP en mémoire: RGBA8888, puissance de deux, chaîne de mips
+static Uint32* textures_decode(const Uint8* data, size_t size, const char* path,
+                               int* out_w, int* out_h, int* out_mips) {
+    SDL_Surface* surface = SDL_LoadBMP_RW(SDL_RWFromConstMem(data, (int)size), 1);
+    if (!surface) {
+        printf("Impossible de charger %s: %s\n", path, SDL_GetError());
+        return NULL;
+    }
+    
+    // Convertir en format RGBA32 pour un accès facile aux pixels
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(surface);
+    if (!converted) {
+        printf("Erreur de conversion de surface: %s\n", SDL_GetError());
+        return NULL;
+    }
+    
+    int w = textures_pow2(converted->w);
+    int h = textures_pow2(converted->h);
+    if (w != converted->w || h != converted->h) {
+        // Dimensions non puissances de deux: redimensionner une fois au chargement
+        SDL_Surface* resized = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA8888);
+        if (!resized) {
+            printf("Erreur redimensionnement %s: %s\n", path, SDL_GetError());
+            SDL_FreeSurface(converted);
+            return NULL;
+        }
+        SDL_BlitScaled(converted, NULL, resized, NULL);
+        SDL_FreeSurface(converted);
+        converted = resized;
+        printf("Texture %s redimensionnée en %dx%d\n", path, w, h);
+    }
+    
+    int levels = textures_mip_levels(w, h);
+    Uint32* pixels = malloc(textures_chain_size(w, h, levels) * sizeof(Uint32));
+    if (!pixels) {
+        printf("Erreur allocation texture %s\n", path);
+        SDL_FreeSurface(converted);
+        return NULL;
+    }
+    for (int y = 0; y < h; y++) {
+        memcpy(pixels + y * w, (Uint8*)converted->pixels + y * converted->pitch, w * sizeof(Uint32));
+    }
+    SDL_FreeSurface(converted);
+    
+    Uint32* level = pixels;
+    int lw = w, lh = h;
+    for (int i = 1; i < levels; i++) {
+        Uint32* next = level + lw * lh;
+        textures_downsample(level, lw, lh, next);
+        if (lw > 1) lw >>= 1;
+        if (lh > 1) lh >>= 1;
+        level = next;
+    }
+    
+    *out_w = w;
+    *out_h = h;
+    *out_mips = levels;
+    return pixels;
+}
+
+static int textures_cache_open(TextureCache* cache, const char* path) {
+    memset(cache, 0, sizeof(*cache));
+    
+#ifdef _WIN32
+    cache->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (cache->file == INVALID_HANDLE_VALUE) return 0;
+    LARGE_INTEGER size;
+    GetFileSizeEx(cache->file, &size);
+    cache->size = (size_t)size.QuadPart;
+    cache->mapping = cache->size ? CreateFileMappingA(cache->file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    cache->data = cache->mapping ? MapViewOfFile(cache->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!cache->data) {
+        if (cache->mapping) CloseHandle(cache->mapping);
+        CloseHandle(cache->file);
+        return 0;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+    cache->data = data;
+    cache->size = (size_t)st.st_size;
+#endif
+    
+    // Vérifier l'en-tête et la cohérence des tailles avant de s'y fier
+    const TextureCacheHeader* header = (const TextureCacheHeader*)cache->data;
+    size_t records_size = cache->size >= sizeof(*header) ? (size_t)header->count * sizeof(TextureCacheRecord) : 0;
+    if (cache->size < sizeof(*header) || memcmp(header->magic, "PCTX", 4) != 0 ||
+        header->version != TEXTURES_CACHE_VERSION ||
+        cache->size != sizeof(*header) + records_size + (size_t)header->pixel_count * sizeof(Uint32)) {
+        printf("Cache de textures invalide, reconstruction\n");
+        cache->count = 0;
+        return 1;
+    }
+    cache->records = (const TextureCacheRecord*)(cache->data + sizeof(*header));
+    cache->pixels = (const Uint32*)(cache->data + sizeof(*header) + records_size);
+    cache->count = header->count;
+    return 1;
+}
+
+static void textures_cache_close(TextureCache* cache) {
+    if (!cache->data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(cache->data);
+    CloseHandle(cache->mapping);
+    CloseHandle(cache->file);
+#else
+    munmap((void*)cache->data, cache->size);
+#endif
+    cache->data = NULL;
+}
+
+// Recherche dichotomique (enregistrements triés par hash)
+static int textures_cache_find(const TextureCache* cache, Uint64 hash) {
+    int lo = 0, hi = (int)cache->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        Uint64 h = cache->records[mid].hash;
+        if (h == hash) {
+            const TextureCacheRecord* rec = &cache->records[mid];
+            int levels = (int)rec->mip_count;
+            if (textures_valid_size(rec->width) && textures_valid_size(rec->height) &&
+                levels == textures_mip_levels((int)rec->width, (int)rec->height) &&
+                (Uint64)rec->offset + textures_chain_size((int)rec->width, (int)rec->height, levels) <=
+                    ((const TextureCacheHeader*)cache->data)->pixel_count) {
+                return mid;
+            }
+            return -1;      // Enregistrement corrompu: texture décodée à nouveau
+        }
+        if (h < hash) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+static int textures_job_compare(const void* a, const void* b) {
+    Uint64 ha = (*(const TextureJob* const*)a)->hash;
+    Uint64 hb = (*(const TextureJob* const*)b)->hash;
+    return ha < hb ? -1 : (ha > hb ? 1 : 0);
+}
+
+// Réécrire le cache avec toutes les textures chargées
+static void textures_cache_write(TextureManager* tm, TextureJob* jobs, int count) {
+    TextureJob** sorted = malloc(count * sizeof(TextureJob*));
+    TextureCacheRecord* records = malloc(count * sizeof(TextureCacheRecord));
+    if (!sorted || !records) {
+        free(sorted);
+        free(records);
+        return;
+    }
+    
+    int record_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (tm->loaded[jobs[i].id]) sorted[record_count++] = &jobs[i];
+    }
+    qsort(sorted, record_count, sizeof(TextureJob*), textures_job_compare);
+    
+    // Les doublons (même fichier sous deux numéros) ne sont stockés qu'une fois
+    Uint32 pixel_count = 0;
+    int unique = 0;
+    for (int i = 0; i < record_count; i++) {
+        if (unique > 0 && records[unique - 1].hash == sorted[i]->hash) continue;
+        TextureEntry* entry = &tm->entries[sorted[i]->id];
+        sorted[unique] = sorted[i];
+        records[unique].hash = sorted[i]->hash;
+        records[unique].offset = pixel_count;
+        records[unique].width = (Uint32)entry->width;
+        records[unique].height = (Uint32)entry->height;
+        records[unique].mip_count = (Uint32)entry->mip_count;
+        pixel_count += textures_chain_size(entry->width, entry->height, entry->mip_count);
+        unique++;
+    }
+    
+    char tmp_path[256];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", TEXTURES_CACHE_FILE);
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) {
+        printf("Impossible d'écrire le cache de textures %s\n", tmp_path);
+        free(sorted);
+        free(records);
+        return;
+    }
+    
+    TextureCacheHeader header;
+    memcpy(header.magic, "PCTX", 4);
+    header.version = TEXTURES_CACHE_VERSION;
+    header.count = (Uint32)unique;
+    header.pixel_count = pixel_count;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(records, sizeof(TextureCacheRecord), unique, file) == (size_t)unique;
+    for (int i = 0; i < unique && ok; i++) {
+        TextureEntry* entry = &tm->entries[sorted[i]->id];
+        Uint32 size = textures_chain_size(entry->width, entry->height, entry->mip_count);
+        ok = fwrite(tm->pixels + entry->offset, sizeof(Uint32), size, file) == size;
+    }
+    ok = (fclose(file) == 0) && ok;
+    
+    if (ok) {
+#ifdef _WIN32
+        remove(TEXTURES_CACHE_FILE);  // rename ne remplace pas un fichier existant sous Windows
+#endif
+        ok = rename(tmp_path, TEXTURES_CACHE_FILE) == 0;
+    }
+    if (!ok) {
+        printf("Erreur écriture du cache de textures\n");
+        remove(tmp_path);
+    }
+    free(sorted);
+    free(records);
+}
+
+// Thread de travail: lire, hacher, puis décoder seulement ce que le cache n'a pas
+static int textures_worker(void* data) {
+    TextureWorkQueue* queue = (TextureWorkQueue*)data;
+    
+    for (;;) {
+        int index = SDL_AtomicAdd(&queue->next, 1);
+        if (index >= queue->count) break;
+        TextureJob* job = &queue->jobs[index];
+        
+        char path[64];
+        textures_path(job->id, path, sizeof(path));
+        size_t size;
+        Uint8* file = textures_read_file(path, &size);
+        if (!file) continue;
+        
+        job->hash = textures_hash(file, size);
+        job->cache_index = textures_cache_find(queue->cache, job->hash);
+        if (job->cache_index < 0) {
+            job->pixels = textures_decode(file, size, path, &job->width, &job->height, &job->mip_count);
+        }
+        free(file);
+    }
+    return 0;
+}
+
+// Réserver 'size' pixels à la fin de l'arène
+static int textures_arena_reserve(TextureManager* tm, Uint32 size, Uint32* out_offset) {
+    if (tm->arena_used + size > tm->arena_capacity) {
+        Uint32 capacity = tm->arena_capacity ? tm->arena_capacity : 64 * 64;
+        while (capacity < tm->arena_used + size) capacity *= 2;
+        
+        Uint32* pixels = realloc(tm->pixels, capacity * sizeof(Uint32));
+        if (!pixels) {
+            printf("Erreur allocation arène de textures (%u pixels)\n", capacity);
+            return 0;
+        }
+        tm->pixels = pixels;
+        tm->arena_capacity = capacity;
+    }
+    *out_offset = tm->arena_used;
+    tm->arena_used += size;
+    return 1;
+}
+
+// Placer une chaîne de mips dans l'emplacement id (réutilise la place si elle suffit)
+static int textures_store(TextureManager* tm, int id, const Uint32* pixels, int w, int h, int mip_count) {
+    TextureEntry* entry = &tm->entries[id];
+    Uint32 size = textures_chain_size(w, h, mip_count);
+    
+    if (!tm->loaded[id] || textures_chain_size(entry->width, entry->height, entry->mip_count) < size) {
+        if (!textures_arena_reserve(tm, size, &entry->offset)) return 0;
+    }
+    entry->width = w;
+    entry->height = h;
+    entry->width_shift = textures_log2(w);
+    entry->width_mask = w - 1;
+    entry->height_mask = h - 1;
+    entry->mip_count = mip_count;
+    memcpy(tm->pixels + entry->offset, pixels, size * sizeof(Uint32));
+    
+    // La SDL_Texture éventuelle sera recréée à la prochaine demande
+    if (tm->textures[id]) {
+        SDL_DestroyTexture(tm->textures[id]);
+        tm->textures[id] = NULL;
+    }
+    
+    if (!tm->loaded[id]) {
+        tm->loaded[id] = 1;
+        tm->loaded_count++;
+    }
+    if (id >= tm->count) {
+        tm->count = id + 1;
+    }
+    return 1;
+}
+
+int textures_init(TextureManager* tm, SDL_Renderer* renderer) {
+    memset(tm, 0, sizeof(*tm));
+    tm->renderer = renderer;
+    Uint64 start = SDL_GetPerformanceCounter();
+    
+    // Texture grise 1x1 renvoyée pour les ids absents (offset 0 de l'arène)
+    Uint32 offset;
+    if (!textures_arena_reserve(tm, 1, &offset)) return 0;
+    tm->pixels[offset] = TEXTURE_MISSING_COLOR;
+    tm->missing.offset = offset;
+    tm->missing.width = 1;
+    tm->missing.height = 1;
+    tm->missing.mip_count = 1;
+    
+    // Lister textures/ : les numéros manquants ne bloquent pas les suivants
+    DIR* dir = opendir("textures");
+    if (!dir) {
+        printf("Impossible d'ouvrir le dossier textures/\n");
+        return 0;
+    }
+    
+    int present[MAX_TEXTURES] = {0};
+    int job_count = 0;
+    struct dirent* file;
+    while ((file = readdir(dir)) != NULL) {
+        int id = textures_id_from_name(file->d_name);
+        if (id >= 0 && !present[id]) {
+            present[id] = 1;
+            job_count++;
+        }
+    }
+    closedir(dir);
+    
+    TextureJob* jobs = calloc(job_count > 0 ? job_count : 1, sizeof(TextureJob));
+    if (!jobs) return 0;
+    job_count = 0;
+    for (int id = 0; id < MAX_TEXTURES; id++) {
+        if (!present[id]) continue;
+        jobs[job_count].id = id;
+        jobs[job_count].cache_index = -1;
+        job_count++;
+    }
+    
+    // Lecture, hash et décodage en parallèle (le thread principal participe)
+    TextureCache cache;
+    textures_cache_open(&cache, TEXTURES_CACHE_FILE);
+    
+    TextureWorkQueue queue;
+    queue.jobs = jobs;
+    queue.count = job_count;
+    queue.cache = &cache;
+    SDL_AtomicSet(&queue.next, 0);
+    
+    int worker_count = SDL_GetCPUCount();
+    if (worker_count > TEXTURES_MAX_WORKERS) worker_count = TEXTURES_MAX_WORKERS;
+    if (worker_count > job_count) worker_count = job_count;
+    SDL_Thread* workers[TEXTURES_MAX_WORKERS];
+    for (int i = 0; i < worker_count - 1; i++) {
+        workers[i] = SDL_CreateThread(textures_worker, "texture_decode", &queue);
+    }
+    textures_worker(&queue);
+    for (int i = 0; i < worker_count - 1; i++) {
+        if (workers[i]) SDL_WaitThread(workers[i], NULL);
+    }
+    
+    // Une seule allocation pour toute l'arène, puis copie dans l'ordre des ids
+    Uint32 total = tm->arena_used;
+    int cached = 0;
+    for (int i = 0; i < job_count; i++) {
+        TextureJob* job = &jobs[i];
+        if (job->cache_index >= 0) {
+            const TextureCacheRecord* rec = &cache.records[job->cache_index];
+            job->width = (int)rec->width;
+            job->height = (int)rec->height;
+            job->mip_count = (int)rec->mip_count;
+        } else if (!job->pixels) {
+            continue;
+        }
+        total += textures_chain_size(job->width, job->height, job->mip_count);
+    }
+    Uint32* pixels = realloc(tm->pixels, total * sizeof(Uint32));
+    if (pixels) {
+        tm->pixels = pixels;
+        tm->arena_capacity = total;
+    }
+    
+    for (int i = 0; i < job_count; i++) {
+        TextureJob* job = &jobs[i];
+        if (job->cache_index >= 0) {
+            const Uint32* src = cache.pixels + cache.records[job->cache_index].offset;
+            textures_store(tm, job->id, src, job->width, job->height, job->mip_count);
+            cached++;
+        } else if (job->pixels) {
+            textures_store(tm, job->id, job->pixels, job->width, job->height, job->mip_count);
+            free(job->pixels);
+            job->pixels = NULL;
+        }
+    }
+    textures_cache_close(&cache);
+    
+    // Des textures ont été décodées: mettre le cache à jour pour le prochain lancement
+    if (cached < tm->loaded_count) {
+        textures_cache_write(tm, jobs, job_count);
+    }
+    free(jobs);
+    
+    double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    printf("%d textures chargées (%d depuis le cache, %d threads, %u Ko d'arène) en %.1f ms\n",
+           tm->loaded_count, cached, worker_count > 0 ? worker_count : 1,
+           (unsigned)(tm->arena_used * sizeof(Uint32) / 1024), ms);
+    return tm->loaded_count;
+}
+
+// Recharger une seule texture (hot-reload), les autres restent en place
+int textures_reload(TextureManager* tm, int id) {
+    if (id < 0 || id >= MAX_TEXTURES) return 0;
+    
+    char path[64];
+    textures_path(id, path, sizeof(path));
+    size_t size;
+    Uint8* file = textures_read_file(path, &size);
+    if (!file) return 0;
+    
+    int w, h, mip_count;
+    Uint32* pixels = textures_decode(file, size, path, &w, &h, &mip_count);
+    free(file);
+    if (!pixels) return 0;
+    
+    int ok = textures_store(tm, id, pixels, w, h, mip_count);
+    free(pixels);
+    return ok;
+}
+
+void textures_destroy(TextureManager* tm) {
+    for (int i = 0; i < tm->count; i++) {
+        if (tm->textures[i]) {
+            SDL_DestroyTexture(tm->textures[i]);
+            tm->textures[i] = NULL;
+        }
+        tm->loaded[i] = 0;
+    }
+    free(tm->pixels);
+    tm->pixels = NULL;
+    tm->arena_used = 0;
+    tm->arena_capacity = 0;
+    tm->count = 0;
+    tm->loaded_count = 0;
+}
+
+// SDL_Texture créée seulement pour les consommateurs qui en ont besoin
+SDL_Texture* textures_get(TextureManager* tm, int id) {
+    if (id < 0 || id >= tm->count || !tm->loaded[id]) {
+        return NULL;
+    }
+    if (!tm->textures[id] && tm->renderer) {
+        TextureEntry* entry = &tm->entries[id];
+        SDL_Texture* texture = SDL_CreateTexture(tm->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                                 SDL_TEXTUREACCESS_STATIC, entry->width, entry->height);
+        if (!texture) {
+            printf("Erreur création texture: %s\n", SDL_GetError());
+            return NULL;
+        }
+        SDL_UpdateTexture(texture, NULL, tm->pixels + entry->offset, entry->width * sizeof(Uint32));
+        tm->textures[id] = texture;
+    }
+    return tm->textures[id];
+}
+
+Uint32* textures_get_pixels(TextureManager* tm, int id) {
+    if (id >= 0 && id < MAX_TEXTURES && tm->loaded[id]) {
+        return tm->pixels + tm->entries[id].offset;
+    }
+    return NULL;
+}
+
+// Décrire le niveau de mip 'level' (borné au dernier niveau disponible)
+int textures_get_mip(const TextureManager* tm, int id, int level, TextureEntry* out) {
+    const TextureEntry* entry = textures_get_entry(tm, id);
+    if (level >= entry->mip_count) level = entry->mip_count - 1;
+    if (level < 0) level = 0;
+    
+    int w = entry->width, h = entry->height;
+    Uint32 offset = entry->offset;
+    for (int i = 0; i < level; i++) {
+        offset += (Uint32)(w * h);
+        if (w > 1) w >>= 1;
+        if (h > 1) h >>= 1;
+    }
+    out->offset = offset;
+    out->width = w;
+    out->height = h;
+    out->width_shift = textures_log2(w);
+    out->width_mask = w - 1;
+    out->height_mask = h - 1;
+    out->mip_count = entry->mip_count - level;
+    return level;
+}
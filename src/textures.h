@@ -1,24 +1,54 @@
-#ifndef TEXTURES_H
-#define TEXTURES_H
-
-#include <SDL2/SDL.h>
-
-#define MAX_TEXTURES 8
-#define TEXTURE_SIZE 64
-
-typedef struct {
-    SDL_Texture* textures[MAX_TEXTURES];
-    int count;
-} TextureManager;
-
-// Fonctions publiques
-int textures_init(TextureManager* tm, SDL_Renderer* renderer);
-void textures_destroy(TextureManager* tm);
-SDL_Texture* textures_get(TextureManager* tm, int id);
-Uint32* textures_get_pixels(TextureManager* tm, int id);
-
-// Variables globales pour les pixels des textures (pour le raycasting)
-extern Uint32* texture_pixels[MAX_TEXTURES];
-extern int texture_loaded[MAX_TEXTURES];
-
-#endif
\ No newline at end of file
+#ifndef TEXTURES_H
+#define TEXTURES_H
+
+#include <SDL2/SDL.h>
+
+#define MAX_TEXTURES 1024
+#define TEXTURE_SIZE 64          // Taille de référence (éditeur, vignettes)
+#define TEXTURE_SIZE_MAX 1024    // Les textures plus grandes sont réduites
+#define TEXTURES_MAX_WORKERS 8   // Threads de décodage au démarrage
+#define TEXTURES_CACHE_FILE "textures/textures.cache"
+
+// Une texture dans l'arène: dimensions puissances de deux, échantillonnée
+// avec des décalages et masques précalculés (ni division ni modulo)
+typedef struct {
+    Uint32 offset;      // Premier pixel dans l'arène
+    int width;
+    int height;
+    int width_shift;    // log2(width): index = (tex_y << width_shift) + tex_x
+    int width_mask;     // width - 1
+    int height_mask;    // height - 1
+    int mip_count;      // Niveaux stockés, niveau 0 compris (réductions 2x2 à la suite)
+} TextureEntry;
+
+typedef struct {
+    Uint32* pixels;                         // Arène contiguë de toutes les textures (RGBA8888)
+    Uint32 arena_used;                      // En pixels
+    Uint32 arena_capacity;
+    TextureEntry entries[MAX_TEXTURES];     // Entrée 'missing' (1x1 gris) pour les ids absents
+    TextureEntry missing;
+    int loaded[MAX_TEXTURES];
+    SDL_Texture* textures[MAX_TEXTURES];    // Créées à la demande par textures_get
+    int count;                              // Plus grand id chargé + 1
+    int loaded_count;
+    SDL_Renderer* renderer;                 // Pour créer les SDL_Texture à la demande
+} TextureManager;
+
+// Fonctions publiques
+int textures_init(TextureManager* tm, SDL_Renderer* renderer);
+void textures_destroy(TextureManager* tm);
+int textures_reload(TextureManager* tm, int id);
+SDL_Texture* textures_get(TextureManager* tm, int id);
+Uint32* textures_get_pixels(TextureManager* tm, int id);
+int textures_get_mip(const TextureManager* tm, int id, int level, TextureEntry* out);
+int textures_id_from_name(const char* name);
+
+// Entrée d'une texture, toujours valide (texture grise si l'id n'est pas chargé)
+static inline const TextureEntry* textures_get_entry(const TextureManager* tm, int id) {
+    if ((unsigned)id < MAX_TEXTURES && tm->loaded[id]) {
+        return &tm->entries[id];
+    }
+    return &tm->missing;
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+
+// Police bitmap 5x7 (ASCII 32 à 95), une colonne par octet, bit 0 = ligne du haut.
+// Les minuscules sont affichées en majuscules.
+static const Uint8 ui_font[64][UI_FONT_WIDTH] = {
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+    {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x56,0x20,0x50}, {0x00,0x08,0x07,0x03,0x00},
+    {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x2A,0x1C,0x7F,0x1C,0x2A}, {0x08,0x08,0x3E,0x08,0x08},
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+    {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+    {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+    {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+    {0x32,0x49,0x79,0x41,0x3E}, {0x7C,0x12,0x11,0x12,0x7C}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+    {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+    {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+    {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+    {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}
+};
+
+void ui_fill_rect(Uint32* buffer, int w, int h, int x, int y, int rw, int rh, Uint32 color) {
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + rw > w ? w : x + rw;
+    int y1 = y + rh > h ? h : y + rh;
+    for (int py = y0; py < y1; py++) {
+        for (int px = x0; px < x1; px++) {
+            buffer[py * w + px] = color;
+        }
+    }
+}
+
+void ui_darken_rect(Uint32* buffer, int w, int h, int x, int y, int rw, int rh) {
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + rw > w ? w : x + rw;
+    int y1 = y + rh > h ? h : y + rh;
+    for (int py = y0; py < y1; py++) {
+        for (int px = x0; px < x1; px++) {
+            // Diviser RGB par 4 en gardant l'alpha
+            Uint32 c = buffer[py * w + px];
+            buffer[py * w + px] = ((c >> 2) & 0x3F3F3F00) | (c & 0xFF);
+        }
+    }
+}
+
+void ui_draw_text(Uint32* buffer, int w, int h, int x, int y, const char* text, Uint32 color, int scale) {
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        int ch = *c;
+        if (ch >= 'a' && ch <= 'z') ch -= 'a' - 'A';
+        if (ch < 32 || ch > 95) ch = '?';
+
+        const Uint8* glyph = ui_font[ch - 32];
+        for (int col = 0; col < UI_FONT_WIDTH; col++) {
+            for (int row = 0; row < UI_FONT_HEIGHT; row++) {
+                if (glyph[col] & (1 << row)) {
+                    ui_fill_rect(buffer, w, h, x + col * scale, y + row * scale, scale, scale, color);
+                }
+            }
+        }
+        x += (UI_FONT_WIDTH + 1) * scale;
+    }
+}
+
+void ui_picker_init(MapPicker* picker, MapCatalog* catalog) {
+    picker->open = 0;
+    picker->selected = 0;
+    picker->scroll = 0;
+    picker->catalog = catalog;
+}
+
+static void ui_picker_clamp(MapPicker* picker) {
+    int count = map_catalog_count(picker->catalog);
+    if (picker->selected > count - 1) picker->selected = count - 1;
+    if (picker->selected < 0) picker->selected = 0;
+
+    // Garder la sélection visible
+    if (picker->selected < picker->scroll) picker->scroll = picker->selected;
+    if (picker->selected >= picker->scroll + UI_PICKER_VISIBLE) {
+        picker->scroll = picker->selected - UI_PICKER_VISIBLE + 1;
+    }
+}
+
+void ui_picker_open(MapPicker* picker, const char* current_path) {
+    picker->selected = 0;
+    picker->scroll = 0;
+    picker->open = 1;
+
+    // Présélectionner la map en cours ("maps/nom.txt")
+    const char* base = strrchr(current_path, '/');
+    base = base ? base + 1 : current_path;
+    char name[MAP_CATALOG_NAME_MAX];
+    snprintf(name, sizeof(name), "%s", base);
+    char* ext = strstr(name, ".txt");
+    if (ext) *ext = '\0';
+
+    int index = map_catalog_find(picker->catalog, name);
+    if (index >= 0) {
+        picker->selected = index;
+    }
+    ui_picker_clamp(picker);
+}
+
+int ui_picker_handle_key(MapPicker* picker, SDL_Keycode key) {
+    int count = map_catalog_count(picker->catalog);
+
+    switch (key) {
+        case SDLK_ESCAPE:
+        case SDLK_l:
+            picker->open = 0;
+            return UI_PICKER_CANCELLED;
+        case SDLK_RETURN:
+            picker->open = 0;
+            return count > 0 ? UI_PICKER_CHOSEN : UI_PICKER_CANCELLED;
+        case SDLK_UP:
+        case SDLK_w:
+            picker->selected--;
+            break;
+        case SDLK_DOWN:
+        case SDLK_s:
+            picker->selected++;
+            break;
+        case SDLK_PAGEUP:
+            picker->selected -= UI_PICKER_VISIBLE;
+            break;
+        case SDLK_PAGEDOWN:
+            picker->selected += UI_PICKER_VISIBLE;
+            break;
+    }
+
+    ui_picker_clamp(picker);
+    return UI_PICKER_NONE;
+}
+
+const char* ui_picker_selected_name(MapPicker* picker) {
+    const MapCatalogEntry* entry = map_catalog_get(picker->catalog, picker->selected);
+    return entry ? entry->name : NULL;
+}
+
+static void ui_picker_draw_details(const MapCatalogEntry* entry, Uint32* buffer, int w, int h,
+                                   int x, int y, int line_h, int scale) {
+    char text[96];
+    if (entry->width == 0) {
+        ui_draw_text(buffer, w, h, x, y, "MAP ILLISIBLE", 0xFF6060FF, scale);
+        return;
+    }
+
+    snprintf(text, sizeof(text), "TAILLE %dX%d", entry->width, entry->height);
+    ui_draw_text(buffer, w, h, x, y, text, 0xC0C0C0FF, scale);
+    snprintf(text, sizeof(text), "LUMIERES %d", entry->light_count);
+    ui_draw_text(buffer, w, h, x, y + line_h, text, 0xC0C0C0FF, scale);
+    snprintf(text, sizeof(text), "DEPART %.1f,%.1f", entry->player_start_x, entry->player_start_y);
+    ui_draw_text(buffer, w, h, x, y + 2 * line_h, text, 0xC0C0C0FF, scale);
+    snprintf(text, sizeof(text), "FICHIER %ld O", entry->file_size);
+    ui_draw_text(buffer, w, h, x, y + 3 * line_h, text, 0xC0C0C0FF, scale);
+
+    // Vignette précalculée, agrandie
+    int thumb_scale = 2 * scale;
+    int thumb_y = y + 4 * line_h + 4;
+    for (int ty = 0; ty < MAP_CATALOG_THUMB_SIZE; ty++) {
+        for (int tx = 0; tx < MAP_CATALOG_THUMB_SIZE; tx++) {
+            ui_fill_rect(buffer, w, h, x + tx * thumb_scale, thumb_y + ty * thumb_scale,
+                         thumb_scale, thumb_scale, entry->thumbnail[ty * MAP_CATALOG_THUMB_SIZE + tx]);
+        }
+    }
+}
+
+void ui_picker_draw(MapPicker* picker, Uint32* buffer, int w, int h) {
+    if (!picker->open) return;
+
+    // Le catalogue peut avoir changé depuis l'ouverture (fichiers ajoutés/supprimés)
+    ui_picker_clamp(picker);
+    int count = map_catalog_count(picker->catalog);
+
+    int scale = h >= 600 ? 2 : 1;
+    int char_w = (UI_FONT_WIDTH + 1) * scale;
+    int line_h = (UI_FONT_HEIGHT + 4) * scale;
+    int panel_w = 52 * char_w;
+    int panel_h = (UI_PICKER_VISIBLE + 3) * line_h;
+    int panel_x = (w - panel_w) / 2;
+    int panel_y = (h - panel_h) / 2;
+    int list_w = 26 * char_w;
+
+    ui_darken_rect(buffer, w, h, panel_x, panel_y, panel_w, panel_h);
+
+    char title[64];
+    snprintf(title, sizeof(title), "CHARGER UNE MAP (%d)", count);
+    ui_draw_text(buffer, w, h, panel_x + 8, panel_y + 4, title, 0xFFD040FF, scale);
+
+    if (count == 0) {
+        ui_draw_text(buffer, w, h, panel_x + 8, panel_y + 4 + line_h, "AUCUNE MAP DANS MAPS/", 0xFF6060FF, scale);
+    }
+
+    for (int i = 0; i < UI_PICKER_VISIBLE && picker->scroll + i < count; i++) {
+        int index = picker->scroll + i;
+        int y = panel_y + 4 + (i + 1) * line_h;
+        Uint32 color = 0xC0C0C0FF;
+        if (index == picker->selected) {
+            ui_fill_rect(buffer, w, h, panel_x + 4, y - 2 * scale, list_w, line_h, 0x404080FF);
+            color = 0xFFFFFFFF;
+        }
+        ui_draw_text(buffer, w, h, panel_x + 8, y, map_catalog_get(picker->catalog, index)->name, color, scale);
+    }
+
+    const MapCatalogEntry* selected = map_catalog_get(picker->catalog, picker->selected);
+    if (selected) {
+        ui_picker_draw_details(selected, buffer, w, h, panel_x + list_w + 16, panel_y + 4 + line_h, line_h, scale);
+    }
+
+    ui_draw_text(buffer, w, h, panel_x + 8, panel_y + panel_h - line_h,
+                 "HAUT/BAS: CHOISIR  ENTREE: CHARGER  ECHAP: ANNULER", 0x808080FF, scale);
+}
+
+void ui_draw_loading(Uint32* buffer, int w, int h, const char* path) {
+    char text[600];
+    snprintf(text, sizeof(text), "CHARGEMENT %s...", path);
+    ui_draw_text(buffer, w, h, 9, 9, text, 0x000000FF, 2);
+    ui_draw_text(buffer, w, h, 8, 8, text, 0xFFD040FF, 2);
+}
@@ -0,0 +1,40 @@
+#ifndef UI_H
+#define UI_H
+
+#include <SDL2/SDL.h>
+#include "map_catalog.h"
+
+#define UI_FONT_WIDTH 5
+#define UI_FONT_HEIGHT 7
+#define UI_PICKER_VISIBLE 12
+
+// Actions renvoyées par le sélecteur de maps
+enum {
+    UI_PICKER_NONE = 0,
+    UI_PICKER_CHOSEN = 1,
+    UI_PICKER_CANCELLED = 2
+};
+
+typedef struct {
+    int open;
+    int selected;
+    int scroll;
+    MapCatalog* catalog;   // Source des maps (indexée une fois, tenue à jour par surveillance)
+} MapPicker;
+
+// Texte bitmap dessiné directement dans le buffer d'écran (RGBA8888)
+void ui_draw_text(Uint32* buffer, int w, int h, int x, int y, const char* text, Uint32 color, int scale);
+void ui_fill_rect(Uint32* buffer, int w, int h, int x, int y, int rw, int rh, Uint32 color);
+void ui_darken_rect(Uint32* buffer, int w, int h, int x, int y, int rw, int rh);
+
+// Sélecteur de maps intégré au moteur
+void ui_picker_init(MapPicker* picker, MapCatalog* catalog);
+void ui_picker_open(MapPicker* picker, const char* current_path);
+int ui_picker_handle_key(MapPicker* picker, SDL_Keycode key);
+const char* ui_picker_selected_name(MapPicker* picker);
+void ui_picker_draw(MapPicker* picker, Uint32* buffer, int w, int h);
+
+// Indicateur de chargement en cours
+void ui_draw_loading(Uint32* buffer, int w, int h, const char* path);
+
+#endif